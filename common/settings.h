@@ -16,6 +16,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
@@ -61,6 +62,16 @@ class FrameTiming {
     picture_cache_bytes_ = picture_cache_bytes;
   }
 
+  /// The growth of the process-wide |fml::FrameCounters| while the frame was
+  /// rasterized. This includes work done concurrently by other threads and
+  /// other engines.
+  const fml::FrameCounters::Snapshot& GetFrameCounters() const {
+    return frame_counters_;
+  }
+  void SetFrameCounters(const fml::FrameCounters::Snapshot& frame_counters) {
+    frame_counters_ = frame_counters;
+  }
+
  private:
   fml::TimePoint data_[kCount];
   uint64_t frame_number_;
@@ -68,6 +79,7 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  fml::FrameCounters::Snapshot frame_counters_ = {};
 };
 
 using TaskObserverAdd =
@@ -146,6 +158,13 @@ struct Settings {
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Record trace events into in-process per-thread ring buffers, including in
+  // release mode. See |fml::tracing::TraceRingBuffer|.
+  bool trace_ring_buffer = false;
+  // If not empty, the trace captured by the ring buffer after a janky frame is
+  // also written to a file in this directory, which works without the service
+  // protocol, including in release mode.
+  std::string trace_ring_buffer_jank_dir;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -220,6 +239,11 @@ struct Settings {
   // Requests a particular backend to be used (ex "opengles" or "vulkan")
   std::optional<std::string> impeller_backend;
 
+  // Render text without color glyphs from a signed distance field glyph atlas
+  // in Impeller. Glyphs are then rasterized once for all scales, which avoids
+  // rasterizing new glyphs on every frame of a zoom animation.
+  bool impeller_enable_sdf_text = false;
+
   // Enable Vulkan validation on backends that support it. The validation layers
   // must be available to the application.
   bool enable_vulkan_validation = false;
@@ -284,6 +308,13 @@ struct Settings {
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Prepare the images of raster cache entries on the IO thread instead of
+  // during the frame on the raster thread. Content that is not cached yet is
+  // drawn uncached in the meantime.
+  bool enable_deferred_raster_cache_preparation = false;
+  // Cache large display lists as a grid of fixed-size tiles, so that only the
+  // tiles that become visible are rasterized when they scroll.
+  bool enable_tiled_raster_cache = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -322,6 +353,15 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  /// The maximum number of frames that may have been built on the UI thread
+  /// but not yet rasterized, or 0 for the platform default.
+  ///
+  /// A deeper pipeline lets the UI and raster threads overlap more work at the
+  /// cost of frames waiting longer before they are rasterized. The most recent
+  /// pointer position is latched right before rasterization to keep track of
+  /// the input latency this adds.
+  uint32_t frame_pipeline_depth = 0;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
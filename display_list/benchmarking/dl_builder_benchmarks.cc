@@ -4,6 +4,7 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 
 namespace flutter {
 
@@ -57,6 +58,41 @@ bool NeedPrepareRTree(DisplayListBuilderBenchmarkType type) {
          type == DisplayListBuilderBenchmarkType::kBoundsAndRtree;
 }
 
+// Records a grid of cells the way a typical frame would, with the kind of
+// redundancy that the compaction pass removes: attributes that are set
+// and then overwritten by the paint of the next draw call, items that are
+// entirely culled but still leave their save/transform/restore behind, and
+// runs of rects drawn with the same paint.
+static void InvokeRedundantOps(DisplayListBuilder& builder) {
+  DlOpReceiver& receiver = DisplayListBuilderBenchmarkAccessor(builder);
+  DlPaint row_paint;
+  for (int row = 0; row < 20; row++) {
+    receiver.setColor(DlColor::kGreen());
+    row_paint.setColor(row % 2 ? DlColor::kRed() : DlColor::kBlue());
+    for (int col = 0; col < 20; col++) {
+      builder.DrawRect(SkRect::MakeXYWH(col * 5, row * 5, 4, 4), row_paint);
+    }
+    builder.Save();
+    builder.Translate(1000, 1000);
+    builder.DrawRect(SkRect::MakeWH(10, 10), row_paint);
+    builder.Restore();
+  }
+}
+
+class NopReceiver final : public IgnoreAttributeDispatchHelper,
+                          public IgnoreClipDispatchHelper,
+                          public IgnoreTransformDispatchHelper,
+                          public IgnoreDrawDispatchHelper {};
+
+static void ReportCompactionStats(benchmark::State& state,
+                                  const DisplayListBuilder& builder) {
+  const auto& stats = builder.GetLastCompactionStats();
+  state.counters["OriginalBytes"] = stats.original_byte_count;
+  state.counters["OriginalRecords"] = stats.original_record_count;
+  state.counters["BytesSaved"] = stats.bytes_saved;
+  state.counters["RecordsSaved"] = stats.records_saved;
+}
+
 }  // namespace
 
 static void BM_DisplayListBuilderDefault(benchmark::State& state,
@@ -149,6 +185,30 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+static void BM_DisplayListBuilderWithCompaction(benchmark::State& state,
+                                                bool compact) {
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+  while (state.KeepRunning()) {
+    builder.SetCompactOnBuild(compact);
+    InvokeRedundantOps(builder);
+    builder.Build();
+  }
+  ReportCompactionStats(state, builder);
+}
+
+static void BM_DisplayListDispatchWithCompaction(benchmark::State& state,
+                                                 bool compact) {
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+  builder.SetCompactOnBuild(compact);
+  InvokeRedundantOps(builder);
+  auto display_list = builder.Build();
+  ReportCompactionStats(state, builder);
+  NopReceiver receiver;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(receiver);
+  }
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -251,4 +311,14 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSaveLayerAndImageFilter,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithCompaction, kUncompacted, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithCompaction, kCompacted, true)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListDispatchWithCompaction, kUncompacted, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListDispatchWithCompaction, kCompacted, true)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
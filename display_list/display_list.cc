@@ -6,6 +6,7 @@
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -184,10 +185,12 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   if (!culler.init(context)) {
     return;
   }
+  uint64_t op_count = 0;
   while (ptr < end) {
     auto op = reinterpret_cast<const DLOp*>(ptr);
     ptr += op->size;
     FML_DCHECK(ptr <= end);
+    op_count++;
     switch (op->type) {
 #define DL_OP_DISPATCH(name)                             \
   case DisplayListOpType::k##name:                       \
@@ -207,6 +210,8 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
     }
     culler.update(context);
   }
+  fml::FrameCounters::Add(fml::FrameCounters::kDisplayListOpsDispatched,
+                          op_count);
 }
 
 void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
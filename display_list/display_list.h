@@ -114,6 +114,7 @@ namespace flutter {
                                     \
   V(DrawLine)                       \
   V(DrawRect)                       \
+  V(DrawRects)                      \
   V(DrawOval)                       \
   V(DrawCircle)                     \
   V(DrawRRect)                      \
@@ -207,6 +208,7 @@ class DisplayListStorage {
  public:
   DisplayListStorage() = default;
   DisplayListStorage(DisplayListStorage&&) = default;
+  DisplayListStorage& operator=(DisplayListStorage&&) = default;
 
   uint8_t* get() const { return ptr_.get(); }
 
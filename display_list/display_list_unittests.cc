@@ -3176,5 +3176,111 @@ TEST_F(DisplayListTest, NopOperationsOmittedFromRecords) {
             });
 }
 
+static std::vector<uint32_t> RenderForCompactionTest(
+    const sk_sp<DisplayList>& display_list,
+    const SkRect& cull_rect) {
+  SkImageInfo info = SkImageInfo::MakeN32Premul(50, 50);
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(info);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clipRect(cull_rect);
+  auto dispatcher = DlSkCanvasDispatcher(canvas);
+  display_list->Dispatch(dispatcher, cull_rect);
+  std::vector<uint32_t> pixels(info.width() * info.height());
+  surface->readPixels(info, pixels.data(), info.minRowBytes(), 0, 0);
+  return pixels;
+}
+
+TEST_F(DisplayListTest, CompactionRemovesDeadAttributesAndEmptySaves) {
+  auto build = [](bool compact, DisplayListBuilder::CompactionStats* stats) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.SetCompactOnBuild(compact);
+    DlOpReceiver& receiver = ToReceiver(builder);
+    // Overwritten before it is used.
+    receiver.setColor(DlColor::kRed());
+    receiver.setColor(DlColor::kBlue());
+    receiver.drawRect({10, 10, 20, 20});
+    // Nothing is rendered inside of this save.
+    receiver.save();
+    receiver.translate(5, 5);
+    receiver.clipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+    receiver.restore();
+    receiver.saveLayer(nullptr, SaveLayerOptions::kNoAttributes);
+    receiver.drawOval({30, 30, 40, 40});
+    receiver.restore();
+    // Never used.
+    receiver.setColor(DlColor::kGreen());
+    auto display_list = builder.Build();
+    *stats = builder.GetLastCompactionStats();
+    return display_list;
+  };
+  DisplayListBuilder::CompactionStats stats;
+  auto original = build(false, &stats);
+  EXPECT_EQ(stats.records_saved, 0);
+  auto compacted = build(true, &stats);
+
+  EXPECT_EQ(stats.original_record_count, 11);
+  EXPECT_EQ(stats.original_byte_count,
+            original->bytes(false) - sizeof(DisplayList));
+  EXPECT_EQ(stats.dead_attribute_records, 2);
+  EXPECT_EQ(stats.empty_save_records, 1);
+  EXPECT_EQ(stats.merged_rect_records, 0);
+  EXPECT_EQ(stats.records_saved, 6);
+  EXPECT_EQ(stats.bytes_saved, original->bytes() - compacted->bytes());
+  EXPECT_GT(stats.bytes_saved, 0u);
+  // Attribute ops are not counted as rendering ops.
+  EXPECT_EQ(compacted->op_count(), original->op_count() - 4);
+  EXPECT_EQ(compacted->bounds(), original->bounds());
+
+  for (const SkRect& cull_rect : {SkRect::MakeLTRB(0, 0, 50, 50),
+                                  SkRect::MakeLTRB(5, 5, 25, 25),
+                                  SkRect::MakeLTRB(25, 25, 45, 45)}) {
+    EXPECT_EQ(RenderForCompactionTest(compacted, cull_rect),
+              RenderForCompactionTest(original, cull_rect));
+  }
+}
+
+TEST_F(DisplayListTest, CompactionMergesAdjacentDrawRects) {
+  auto build = [](bool compact, DisplayListBuilder::CompactionStats* stats) {
+    DisplayListBuilder builder(/*prepare_rtree=*/true);
+    builder.SetCompactOnBuild(compact);
+    DlPaint paint(DlColor::kBlue());
+    builder.DrawRect({0, 0, 10, 10}, paint);
+    builder.DrawRect({20, 0, 30, 10}, paint);
+    builder.DrawRect({40, 0, 50, 10}, paint);
+    // The empty save separates the next rect from the run only until it
+    // is removed.
+    builder.Save();
+    builder.Translate(5, 5);
+    builder.Restore();
+    builder.DrawRect({0, 20, 10, 30}, paint);
+    builder.DrawOval({20, 20, 30, 30}, paint);
+    builder.DrawRect({40, 20, 50, 30}, paint);
+    builder.DrawRect({0, 40, 10, 50}, DlPaint(DlColor::kRed()));
+    auto display_list = builder.Build();
+    *stats = builder.GetLastCompactionStats();
+    return display_list;
+  };
+  DisplayListBuilder::CompactionStats stats;
+  auto original = build(false, &stats);
+  auto compacted = build(true, &stats);
+
+  EXPECT_EQ(stats.dead_attribute_records, 0);
+  EXPECT_EQ(stats.empty_save_records, 1);
+  EXPECT_EQ(stats.merged_rect_records, 3);
+  EXPECT_EQ(compacted->op_count(), original->op_count() - 6);
+  EXPECT_EQ(stats.bytes_saved, original->bytes() - compacted->bytes());
+  EXPECT_EQ(compacted->bounds(), original->bounds());
+
+  // Culling keeps or drops merged rects together, the canvas clip hides
+  // the difference.
+  for (const SkRect& cull_rect : {SkRect::MakeLTRB(0, 0, 50, 50),
+                                  SkRect::MakeLTRB(22, 2, 28, 8),
+                                  SkRect::MakeLTRB(15, 15, 35, 35),
+                                  SkRect::MakeLTRB(0, 35, 15, 50)}) {
+    EXPECT_EQ(RenderForCompactionTest(compacted, cull_rect),
+              RenderForCompactionTest(original, cull_rect));
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -68,6 +70,13 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
     restore();
   }
 
+  compaction_stats_ = CompactionStats();
+  compaction_stats_.original_byte_count = used_;
+  compaction_stats_.original_record_count = op_index_;
+  if (compact_on_build_) {
+    Compact();
+  }
+
   size_t bytes = used_;
   int count = render_op_count_;
   size_t nested_bytes = nested_bytes_;
@@ -90,6 +99,323 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
       compatible, is_safe, affects_transparency, rtree()));
 }
 
+namespace {
+
+// The attributes that can be set by the attribute ops.
+enum class AttributeSlot {
+  kAntiAlias,
+  kDither,
+  kInvertColors,
+  kStrokeCap,
+  kStrokeJoin,
+  kStyle,
+  kStrokeWidth,
+  kStrokeMiter,
+  kColor,
+  kBlendMode,
+  kPathEffect,
+  kColorFilter,
+  kColorSource,
+  kImageFilter,
+  kMaskFilter,
+  kNone,
+};
+static constexpr size_t kAttributeSlotCount =
+    static_cast<size_t>(AttributeSlot::kNone);
+
+AttributeSlot GetAttributeSlot(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSetAntiAlias:
+      return AttributeSlot::kAntiAlias;
+    case DisplayListOpType::kSetDither:
+      return AttributeSlot::kDither;
+    case DisplayListOpType::kSetInvertColors:
+      return AttributeSlot::kInvertColors;
+    case DisplayListOpType::kSetStrokeCap:
+      return AttributeSlot::kStrokeCap;
+    case DisplayListOpType::kSetStrokeJoin:
+      return AttributeSlot::kStrokeJoin;
+    case DisplayListOpType::kSetStyle:
+      return AttributeSlot::kStyle;
+    case DisplayListOpType::kSetStrokeWidth:
+      return AttributeSlot::kStrokeWidth;
+    case DisplayListOpType::kSetStrokeMiter:
+      return AttributeSlot::kStrokeMiter;
+    case DisplayListOpType::kSetColor:
+      return AttributeSlot::kColor;
+    case DisplayListOpType::kSetBlendMode:
+      return AttributeSlot::kBlendMode;
+    case DisplayListOpType::kSetPodPathEffect:
+    case DisplayListOpType::kClearPathEffect:
+      return AttributeSlot::kPathEffect;
+    case DisplayListOpType::kClearColorFilter:
+    case DisplayListOpType::kSetPodColorFilter:
+      return AttributeSlot::kColorFilter;
+    case DisplayListOpType::kClearColorSource:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+      return AttributeSlot::kColorSource;
+    case DisplayListOpType::kClearImageFilter:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+      return AttributeSlot::kImageFilter;
+    case DisplayListOpType::kClearMaskFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+      return AttributeSlot::kMaskFilter;
+    default:
+      return AttributeSlot::kNone;
+  }
+}
+
+bool IsSaveLayerOp(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsTransformOrClipOp(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kClipDifferencePath:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the op uses the current attributes. Save and restore do not
+// affect the attributes, and neither do transforms and clips.
+bool ReadsAttributes(DisplayListOpType type) {
+  return GetAttributeSlot(type) == AttributeSlot::kNone &&
+         type != DisplayListOpType::kSave &&
+         type != DisplayListOpType::kRestore && !IsTransformOrClipOp(type);
+}
+
+// Matches the |render_op_inc| values passed to |Push| by the builder.
+int RenderOpIncrement(DisplayListOpType type) {
+  return (GetAttributeSlot(type) == AttributeSlot::kNone &&
+          type != DisplayListOpType::kTransformReset)
+             ? 1
+             : 0;
+}
+
+}  // namespace
+
+void DisplayListBuilder::Compact() {
+  enum class Disposition {
+    kKeep,
+    kRemove,
+    // The op is a DrawRect that is merged into the batched record that
+    // replaces the first DrawRect of its run.
+    kMerge,
+  };
+  struct OpInfo {
+    DLOp* op;
+    Disposition disposition = Disposition::kKeep;
+    // For the first DrawRect of a run, the number of rects in the run.
+    uint32_t rect_count = 0;
+  };
+
+  std::vector<OpInfo> ops;
+  ops.reserve(op_index_);
+  for (uint8_t *ptr = storage_.get(), *end = ptr + used_; ptr < end;) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    ptr += op->size;
+    ops.push_back({op});
+  }
+  FML_DCHECK(ops.size() == static_cast<size_t>(op_index_));
+
+  // Remove save/restore pairs that contain no rendering ops. The transforms
+  // and clips inside of them cannot affect anything and are removed along
+  // with them. Attribute ops are kept as they are not scoped by the save.
+  struct SaveFrame {
+    size_t index;
+    bool is_layer;
+    bool renders;
+  };
+  std::vector<SaveFrame> frames;
+  for (size_t i = 0; i < ops.size(); i++) {
+    DisplayListOpType type = ops[i].op->type;
+    if (type == DisplayListOpType::kSave || IsSaveLayerOp(type)) {
+      frames.push_back({i, IsSaveLayerOp(type), false});
+    } else if (type == DisplayListOpType::kRestore) {
+      FML_DCHECK(!frames.empty());
+      SaveFrame frame = frames.back();
+      frames.pop_back();
+      if (!frame.is_layer && !frame.renders) {
+        for (size_t j = frame.index; j <= i; j++) {
+          DisplayListOpType scoped_type = ops[j].op->type;
+          if (ops[j].disposition == Disposition::kKeep &&
+              (scoped_type == DisplayListOpType::kSave ||
+               scoped_type == DisplayListOpType::kRestore ||
+               IsTransformOrClipOp(scoped_type))) {
+            ops[j].disposition = Disposition::kRemove;
+            if (scoped_type == DisplayListOpType::kSave) {
+              compaction_stats_.empty_save_records++;
+            }
+          }
+        }
+      } else if (!frames.empty()) {
+        // A layer renders into its parent even if it is empty.
+        frames.back().renders = true;
+      }
+    } else if (ReadsAttributes(type) && !frames.empty()) {
+      frames.back().renders = true;
+    }
+  }
+
+  // Remove attribute ops whose value is overwritten before any op reads
+  // it, including the ones that are set after the last rendering op.
+  bool overwritten[kAttributeSlotCount];
+  std::fill(std::begin(overwritten), std::end(overwritten), true);
+  for (size_t i = ops.size(); i-- > 0;) {
+    DisplayListOpType type = ops[i].op->type;
+    AttributeSlot slot = GetAttributeSlot(type);
+    if (slot != AttributeSlot::kNone) {
+      bool& slot_overwritten = overwritten[static_cast<size_t>(slot)];
+      if (slot_overwritten) {
+        ops[i].disposition = Disposition::kRemove;
+        compaction_stats_.dead_attribute_records++;
+      }
+      slot_overwritten = true;
+    } else if (ReadsAttributes(type)) {
+      std::fill(std::begin(overwritten), std::end(overwritten), false);
+    }
+  }
+
+  // Merge runs of DrawRect ops that are adjacent once the removed ops are
+  // gone. They share all attributes, transforms and clips.
+  OpInfo* run_start = nullptr;
+  for (OpInfo& info : ops) {
+    if (info.disposition != Disposition::kKeep) {
+      continue;
+    }
+    if (info.op->type != DisplayListOpType::kDrawRect) {
+      run_start = nullptr;
+    } else if (run_start == nullptr) {
+      run_start = &info;
+      run_start->rect_count = 1;
+    } else {
+      info.disposition = Disposition::kMerge;
+      run_start->rect_count++;
+      compaction_stats_.merged_rect_records++;
+    }
+  }
+
+  if (compaction_stats_.dead_attribute_records == 0 &&
+      compaction_stats_.empty_save_records == 0 &&
+      compaction_stats_.merged_rect_records == 0) {
+    return;
+  }
+
+  // Map the old op indices to the new ones. Removed ops map to the index
+  // of the next remaining op, merged ops to the index of their batch. The
+  // extra entry covers indices recorded after the last op.
+  std::vector<int> index_map(ops.size() + 1);
+  size_t new_byte_count = 0;
+  int new_index = 0;
+  int batch_index = 0;
+  for (size_t i = 0; i < ops.size(); i++) {
+    const OpInfo& info = ops[i];
+    switch (info.disposition) {
+      case Disposition::kKeep:
+        batch_index = new_index;
+        index_map[i] = new_index++;
+        new_byte_count += info.rect_count > 1
+                              ? SkAlignPtr(sizeof(DrawRectsOp) +
+                                           info.rect_count * sizeof(SkRect))
+                              : info.op->size;
+        break;
+      case Disposition::kMerge:
+        index_map[i] = batch_index;
+        break;
+      case Disposition::kRemove:
+        index_map[i] = new_index;
+        break;
+    }
+  }
+  index_map[ops.size()] = new_index;
+
+  DisplayListStorage new_storage;
+  new_storage.realloc(new_byte_count);
+  uint8_t* dst = new_storage.get();
+  // Padding bytes are compared by |DisplayList::Equals|.
+  memset(dst, 0, new_byte_count);
+  for (size_t i = 0; i < ops.size(); i++) {
+    const OpInfo& info = ops[i];
+    DLOp* op = info.op;
+    switch (info.disposition) {
+      case Disposition::kKeep:
+        if (info.rect_count > 1) {
+          size_t size = SkAlignPtr(sizeof(DrawRectsOp) +
+                                   info.rect_count * sizeof(SkRect));
+          auto batch = new (dst) DrawRectsOp(info.rect_count);
+          batch->type = DrawRectsOp::kType;
+          batch->size = size;
+          auto rects = reinterpret_cast<SkRect*>(batch + 1);
+          // The DrawRect ops of the run follow the first one, interleaved
+          // only with removed ops.
+          for (size_t j = i, n = 0; n < info.rect_count; j++) {
+            if (ops[j].op->type == DisplayListOpType::kDrawRect &&
+                ops[j].disposition != Disposition::kRemove) {
+              rects[n++] = static_cast<const DrawRectOp*>(ops[j].op)->rect;
+            }
+          }
+          dst += size;
+        } else {
+          // Ops are relocated bitwise just like when the storage grows.
+          memcpy(dst, op, op->size);
+          if (op->type == DisplayListOpType::kSave || IsSaveLayerOp(op->type)) {
+            auto save = reinterpret_cast<SaveOpBase*>(dst);
+            save->restore_index = index_map[save->restore_index];
+          }
+          dst += op->size;
+        }
+        break;
+      case Disposition::kMerge:
+        // DrawRectOp is trivially destructible.
+        break;
+      case Disposition::kRemove: {
+        auto ptr = reinterpret_cast<uint8_t*>(op);
+        DisplayList::DisposeOps(ptr, ptr + op->size);
+        render_op_count_ -= RenderOpIncrement(op->type);
+        break;
+      }
+    }
+  }
+  FML_DCHECK(dst == new_storage.get() + new_byte_count);
+  render_op_count_ -= compaction_stats_.merged_rect_records;
+
+  compaction_stats_.bytes_saved = used_ - new_byte_count;
+  compaction_stats_.records_saved = op_index_ - new_index;
+
+  accumulator_->remap_indices(index_map);
+  storage_ = std::move(new_storage);
+  used_ = allocated_ = new_byte_count;
+  op_index_ = new_index;
+}
+
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
                                        bool prepare_rtree)
     : tracker_(cull_rect, SkMatrix::I()) {
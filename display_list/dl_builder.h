@@ -236,6 +236,32 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  // Statistics about the records removed by the compaction pass during
+  // the most recent call to |Build|.
+  struct CompactionStats {
+    size_t original_byte_count = 0;
+    int original_record_count = 0;
+    size_t bytes_saved = 0;
+    // The number of records removed, counting a merged run of rects
+    // as the number of records that were merged away.
+    int records_saved = 0;
+    int dead_attribute_records = 0;
+    int empty_save_records = 0;
+    int merged_rect_records = 0;
+  };
+
+  // Enables an optimization pass during |Build| that removes attribute
+  // records whose values are overwritten before any rendering op uses
+  // them, removes save/restore pairs along with the transforms and clips
+  // inside of them if they contain no rendering ops, and merges runs of
+  // consecutive DrawRect records into a single batched record. The
+  // resulting DisplayList renders identically but dispatches fewer ops.
+  void SetCompactOnBuild(bool compact) { compact_on_build_ = compact; }
+
+  const CompactionStats& GetLastCompactionStats() const {
+    return compaction_stats_;
+  }
+
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
@@ -493,6 +519,14 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   bool is_ui_thread_safe_ = true;
 
+  bool compact_on_build_ = false;
+  CompactionStats compaction_stats_;
+
+  // Rewrites the recorded ops as described in |SetCompactOnBuild| and
+  // renumbers the op indices recorded in the bounds accumulator and in
+  // the save records.
+  void Compact();
+
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
 
@@ -684,6 +684,27 @@ DEFINE_DRAW_1ARG_OP(Oval, SkRect, oval)
 DEFINE_DRAW_1ARG_OP(RRect, SkRRect, rrect)
 #undef DEFINE_DRAW_1ARG_OP
 
+// 4 byte header + 4 byte payload packs efficiently into 8 bytes
+// The array of SkRects is pod-allocated after this structure.
+// Only recorded by the compaction pass of the DisplayListBuilder which
+// merges runs of consecutive DrawRectOps that share all attributes.
+struct DrawRectsOp final : DrawOpBase {
+  static const auto kType = DisplayListOpType::kDrawRects;
+
+  explicit DrawRectsOp(uint32_t count) : count(count) {}
+
+  const uint32_t count;
+
+  void dispatch(DispatchContext& ctx) const {
+    if (op_needed(ctx)) {
+      const SkRect* rects = reinterpret_cast<const SkRect*>(this + 1);
+      for (uint32_t i = 0; i < count; i++) {
+        ctx.receiver.drawRect(rects[i]);
+      }
+    }
+  }
+};
+
 // 4 byte header + 16 byte payload uses 20 bytes but is rounded up to 24 bytes
 // (4 bytes unused)
 struct DrawPathOp final : DrawOpBase {
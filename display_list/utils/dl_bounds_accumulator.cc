@@ -125,6 +125,13 @@ SkRect RTreeBoundsAccumulator::bounds() const {
   return accumulator.bounds();
 }
 
+void RTreeBoundsAccumulator::remap_indices(const std::vector<int>& index_map) {
+  for (int& index : rect_indices_) {
+    FML_DCHECK(index >= 0 && static_cast<size_t>(index) < index_map.size());
+    index = index_map[index];
+  }
+}
+
 sk_sp<DlRTree> RTreeBoundsAccumulator::rtree() const {
   FML_DCHECK(saved_offsets_.empty());
   return sk_make_sp<DlRTree>(rects_.data(), rects_.size(), rect_indices_.data(),
@@ -6,6 +6,7 @@
 #define FLUTTER_DISPLAY_LIST_UTILS_DL_BOUNDS_ACCUMULATOR_H_
 
 #include <functional>
+#include <vector>
 
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
@@ -86,6 +87,11 @@ class BoundsAccumulator {
 
   virtual sk_sp<DlRTree> rtree() const = 0;
 
+  /// Renumber the op indices associated with the accumulated rects after
+  /// ops were removed from the stream they were recorded for. The |index_map|
+  /// maps every op index that was passed to |accumulate| to its new value.
+  virtual void remap_indices(const std::vector<int>& index_map) = 0;
+
   virtual BoundsAccumulatorType type() const = 0;
 };
 
@@ -114,6 +120,8 @@ class RectBoundsAccumulator final : public virtual BoundsAccumulator {
 
   sk_sp<DlRTree> rtree() const override { return nullptr; }
 
+  void remap_indices(const std::vector<int>& index_map) override {}
+
  private:
   class AccumulationRect {
    public:
@@ -153,6 +161,8 @@ class RTreeBoundsAccumulator final : public virtual BoundsAccumulator {
 
   sk_sp<DlRTree> rtree() const override;
 
+  void remap_indices(const std::vector<int>& index_map) override;
+
   BoundsAccumulatorType type() const override {
     return BoundsAccumulatorType::kRTree;
   }
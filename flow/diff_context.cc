@@ -16,7 +16,35 @@ DiffContext::DiffContext(SkISize frame_size,
       frame_size_(frame_size),
       this_frame_paint_region_map_(this_frame_paint_region_map),
       last_frame_paint_region_map_(last_frame_paint_region_map),
-      has_raster_cache_(has_raster_cache) {}
+      has_raster_cache_(has_raster_cache) {
+  FML_DCHECK(&this_frame_paint_region_map != &last_frame_paint_region_map);
+  // Paint regions from an earlier diff of the same layer tree must not be
+  // mixed with the regions of this diff.
+  this_frame_paint_region_map_.regions.clear();
+  this_frame_paint_region_map_.retained_subtrees.clear();
+}
+
+DiffContext::AutoRetainedSubtreeScope::AutoRetainedSubtreeScope(
+    DiffContext* context,
+    const Layer* old_layer)
+    : context_(context) {
+  if (!old_layer) {
+    return;
+  }
+  const auto& retained =
+      context->last_frame_paint_region_map_.retained_subtrees;
+  auto i = retained.find(old_layer->unique_id());
+  if (i != retained.end()) {
+    context->retained_subtree_scopes_.push_back(i->second);
+    pushed_ = true;
+  }
+}
+
+DiffContext::AutoRetainedSubtreeScope::~AutoRetainedSubtreeScope() {
+  if (pushed_) {
+    context_->retained_subtree_scopes_.pop_back();
+  }
+}
 
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
@@ -244,18 +272,74 @@ void DiffContext::AddDamage(const SkRect& rect) {
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
                                       const PaintRegion& region) {
-  this_frame_paint_region_map_[layer->unique_id()] = region;
+  if (collected_paint_regions_) {
+    (*collected_paint_regions_)[layer->unique_id()] = region;
+  } else {
+    this_frame_paint_region_map_.regions[layer->unique_id()] = region;
+  }
 }
 
 PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
-  auto i = last_frame_paint_region_map_.find(layer->unique_id());
-  if (i != last_frame_paint_region_map_.end()) {
+  return FindOldPaintRegion(layer->unique_id(), nullptr);
+}
+
+PaintRegion DiffContext::FindOldPaintRegion(
+    uint64_t unique_id,
+    std::shared_ptr<const PaintRegionMap::Regions>* retained_subtree) const {
+  const auto& regions = last_frame_paint_region_map_.regions;
+  auto i = regions.find(unique_id);
+  if (i != regions.end()) {
     return i->second;
-  } else {
-    // This is valid when Layer::PreservePaintRegion is called for retained
-    // layer with zero sized parent clip (these layers are not diffed)
-    return PaintRegion();
   }
+  // Innermost retained subtree first.
+  for (auto scope = retained_subtree_scopes_.rbegin();
+       scope != retained_subtree_scopes_.rend(); ++scope) {
+    auto j = (*scope)->find(unique_id);
+    if (j != (*scope)->end()) {
+      if (retained_subtree) {
+        *retained_subtree = *scope;
+      }
+      return j->second;
+    }
+  }
+  // This is valid when Layer::PreservePaintRegion is called for retained
+  // layer with zero sized parent clip (these layers are not diffed)
+  return PaintRegion();
+}
+
+void DiffContext::PreserveRetainedSubtree(Layer* layer) {
+  FML_DCHECK(!collected_paint_regions_);
+  statistics_.AddRetainedSubtree();
+
+  // Retained layer means same instance, so the layer is used to index into
+  // both current and old regions.
+  std::shared_ptr<const PaintRegionMap::Regions> descendants;
+  SetLayerPaintRegion(layer,
+                      FindOldPaintRegion(layer->unique_id(), &descendants));
+  if (!layer->as_container_layer()) {
+    return;
+  }
+
+  const auto& retained = last_frame_paint_region_map_.retained_subtrees;
+  auto i = retained.find(layer->unique_id());
+  if (i != retained.end()) {
+    // Subtree was retained in previous frame as well.
+    descendants = i->second;
+  } else if (!descendants) {
+    // Subtree was diffed in previous frame. Collect the paint regions of its
+    // descendants once; They are shared with subsequent frames for as long as
+    // the subtree is retained.
+    statistics_.AddCollectedRetainedSubtree();
+    auto collected = std::make_shared<PaintRegionMap::Regions>();
+    collected_paint_regions_ = collected.get();
+    layer->PreservePaintRegion(this);
+    collected_paint_regions_ = nullptr;
+    descendants = std::move(collected);
+  }
+  // Otherwise the layer was a descendant of an old retained subtree, whose
+  // paint regions include the descendants of this layer as well.
+  this_frame_paint_region_map_.retained_subtrees[layer->unique_id()] =
+      std::move(descendants);
 }
 
 void DiffContext::Statistics::LogStatistics() {
@@ -266,7 +350,9 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_, "RetainedSubtrees",
+                    retained_subtrees_, "CollectedRetainedSubtrees",
+                    collected_retained_subtrees_);
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include "display_list/utils/dl_matrix_clip_tracker.h"
@@ -36,8 +37,19 @@ struct Damage {
   SkIRect buffer_damage;
 };
 
-// Layer Unique Id to PaintRegion
-using PaintRegionMap = std::map<uint64_t, PaintRegion>;
+// Paint regions of the layers of a layer tree.
+struct PaintRegionMap {
+  // Layer Unique Id to PaintRegion
+  using Regions = std::map<uint64_t, PaintRegion>;
+
+  Regions regions;
+
+  // Unique Id of retained subtree root to paint regions of its descendants.
+  // Retained subtrees are not diffed, so instead of copying the paint regions
+  // of all descendants to |regions| every frame, they are shared with the
+  // layer tree in which the subtree was first retained.
+  std::map<uint64_t, std::shared_ptr<const Regions>> retained_subtrees;
+};
 
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
@@ -54,6 +66,23 @@ class DiffContext {
   // dirty) will be restored
   void EndSubtree();
 
+  // Makes the paint regions of the descendants of old layer available to
+  // GetOldLayerPaintRegion while the old layer's children are being diffed.
+  // This is needed if the old layer was a retained subtree root in the
+  // previous frame, because the paint regions of its descendants were not
+  // stored in the previous frame paint region map directly.
+  class AutoRetainedSubtreeScope {
+    FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AutoRetainedSubtreeScope);
+
+   public:
+    AutoRetainedSubtreeScope(DiffContext* context, const Layer* old_layer);
+    ~AutoRetainedSubtreeScope();
+
+   private:
+    DiffContext* context_;
+    bool pushed_ = false;
+  };
+
   // Creates subtree in current scope and closes it on scope exit
   class AutoSubtreeRestore {
     FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AutoSubtreeRestore);
@@ -154,6 +183,14 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Associates the paint region of retained layer and all of its descendants
+  // with current layer tree without visiting the subtree.
+  //
+  // The paint regions of the descendants are collected once, when the subtree
+  // is first retained, and are then shared between the layer trees of all
+  // subsequent frames in which the subtree is retained.
+  void PreserveRetainedSubtree(Layer* layer);
+
   // Whether or not a raster cache is being used. If so, we must snap
   // all transformations to physical pixels if the layer may be raster
   // cached.
@@ -180,6 +217,19 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Retained layer that was not diffed
+    void AddRetainedSubtree() { ++retained_subtrees_; }
+
+    // Retained subtree for which the paint regions of descendants had to be
+    // collected, because it was not retained in previous frame
+    void AddCollectedRetainedSubtree() { ++collected_retained_subtrees_; }
+
+    int retained_subtrees() const { return retained_subtrees_; }
+
+    int collected_retained_subtrees() const {
+      return collected_retained_subtrees_;
+    }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -189,6 +239,8 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int retained_subtrees_ = 0;
+    int collected_retained_subtrees_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -244,6 +296,23 @@ class DiffContext {
   const PaintRegionMap& last_frame_paint_region_map_;
   bool has_raster_cache_;
 
+  // Paint regions of the descendants of old retained subtrees that are
+  // currently being diffed; See AutoRetainedSubtreeScope.
+  std::vector<std::shared_ptr<const PaintRegionMap::Regions>>
+      retained_subtree_scopes_;
+
+  // When not null, SetLayerPaintRegion stores paint regions here instead of
+  // this frame paint region map. Used to collect the paint regions of the
+  // descendants of a retained subtree.
+  PaintRegionMap::Regions* collected_paint_regions_ = nullptr;
+
+  // Looks up paint region of the layer with given unique id in previous frame.
+  // If the region belongs to a descendant of a retained subtree, the paint
+  // regions of that subtree are returned in |retained_subtree|.
+  PaintRegion FindOldPaintRegion(
+      uint64_t unique_id,
+      std::shared_ptr<const PaintRegionMap::Regions>* retained_subtree) const;
+
   void AddDamage(const SkRect& rect);
 
   void AlignRect(SkIRect& rect,
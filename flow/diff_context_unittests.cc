@@ -32,5 +32,42 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, RetainedSubtreeIsNotVisited) {
+  auto retained = CreateContainerLayer({
+      CreateContainerLayer(CreateDisplayListLayer(
+          CreateDisplayList(SkRect::MakeLTRB(0, 0, 50, 50)))),
+      CreateDisplayListLayer(
+          CreateDisplayList(SkRect::MakeLTRB(100, 0, 150, 50))),
+  });
+
+  MockLayerTree t1;
+  t1.root()->Add(retained);
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 150, 50));
+  EXPECT_EQ(last_statistics().retained_subtrees(), 0);
+  EXPECT_EQ(t1.paint_region_map().regions.size(), 5u);
+
+  // Paint regions of descendants are collected when first retained
+  MockLayerTree t2;
+  t2.root()->Add(retained);
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+  EXPECT_EQ(last_statistics().retained_subtrees(), 1);
+  EXPECT_EQ(last_statistics().collected_retained_subtrees(), 1);
+  EXPECT_EQ(t2.paint_region_map().regions.size(), 2u);
+  EXPECT_EQ(t2.paint_region_map().retained_subtrees.size(), 1u);
+
+  // and then shared
+  MockLayerTree t3;
+  t3.root()->Add(retained);
+  damage = DiffLayerTree(t3, t2);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+  EXPECT_EQ(last_statistics().retained_subtrees(), 1);
+  EXPECT_EQ(last_statistics().collected_retained_subtrees(), 0);
+  EXPECT_EQ(t3.paint_region_map().regions.size(), 2u);
+  EXPECT_EQ(t3.paint_region_map().retained_subtrees.at(retained->unique_id()),
+            t2.paint_region_map().retained_subtrees.at(retained->unique_id()));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -73,6 +73,24 @@ fml::TimeDelta FrameTimingsRecorder::GetBuildDuration() const {
   return build_end_ - build_start_;
 }
 
+fml::TimeDelta FrameTimingsRecorder::GetBuildQueueDuration() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kBuildStart);
+  return build_start_ - vsync_start_;
+}
+
+fml::TimeDelta FrameTimingsRecorder::GetRasterQueueDuration() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterStart);
+  return raster_start_ - build_end_;
+}
+
+std::optional<LatchedPointerInput>
+FrameTimingsRecorder::GetLatchedPointerInput() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return latched_pointer_input_;
+}
+
 /// Count of the layer cache entries
 size_t FrameTimingsRecorder::GetLayerCacheCount() const {
   std::scoped_lock state_lock(state_mutex_);
@@ -101,6 +119,12 @@ size_t FrameTimingsRecorder::GetPictureCacheBytes() const {
   return picture_cache_bytes_;
 }
 
+fml::FrameCounters::Snapshot FrameTimingsRecorder::GetFrameCounters() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterEnd);
+  return frame_counters_;
+}
+
 void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
                                        fml::TimePoint vsync_target) {
   fml::Status status = RecordVsyncImpl(vsync_start, vsync_target);
@@ -126,6 +150,13 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   (void)status;
 }
 
+void FrameTimingsRecorder::RecordLatchedPointerInput(
+    const LatchedPointerInput& pointer_input) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kBuildEnd);
+  latched_pointer_input_ = pointer_input;
+}
+
 fml::Status FrameTimingsRecorder::RecordVsyncImpl(fml::TimePoint vsync_start,
                                                   fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -171,6 +202,7 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
   }
   state_ = State::kRasterStart;
   raster_start_ = raster_start;
+  raster_start_counters_ = fml::FrameCounters::GetSnapshot();
   return fml::Status();
 }
 
@@ -180,6 +212,8 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   state_ = State::kRasterEnd;
   raster_end_ = fml::TimePoint::Now();
   raster_end_wall_time_ = fml::TimePoint::CurrentWallTime();
+  frame_counters_ = fml::FrameCounters::Difference(
+      raster_start_counters_, fml::FrameCounters::GetSnapshot());
   if (cache) {
     const RasterCacheMetrics& layer_metrics = cache->layer_metrics();
     const RasterCacheMetrics& picture_metrics = cache->picture_metrics();
@@ -200,6 +234,7 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetFrameCounters(frame_counters_);
   return timing_;
 }
 
@@ -232,6 +267,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    recorder->raster_start_counters_ = raster_start_counters_;
   }
 
   if (state >= State::kRasterEnd) {
@@ -241,6 +277,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
     recorder->layer_cache_bytes_ = layer_cache_bytes_;
     recorder->picture_cache_count_ = picture_cache_count_;
     recorder->picture_cache_bytes_ = picture_cache_bytes_;
+    recorder->frame_counters_ = frame_counters_;
   }
 
   return recorder;
@@ -6,9 +6,11 @@
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
 #include <mutex>
+#include <optional>
 
 #include "flutter/common/settings.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/status.h"
 #include "flutter/fml/time/time_delta.h"
@@ -20,6 +22,15 @@
 
 namespace flutter {
 
+/// The most recent pointer position known to the engine, latched right before
+/// a frame is rasterized.
+struct LatchedPointerInput {
+  /// Timestamp of when the pointer data was dispatched to the engine.
+  fml::TimePoint dispatch_time;
+  double physical_x = 0;
+  double physical_y = 0;
+};
+
 /// Records timestamps for various phases of a frame rendering process.
 ///
 /// Recorder is created on vsync and destroyed after the rasterization of the
@@ -72,6 +83,17 @@ class FrameTimingsRecorder {
   /// Duration of the frame build time.
   fml::TimeDelta GetBuildDuration() const;
 
+  /// Duration the frame waited between the vsync signal and the start of the
+  /// build.
+  fml::TimeDelta GetBuildQueueDuration() const;
+
+  /// Duration the built frame waited in the pipeline before its rasterization
+  /// started.
+  fml::TimeDelta GetRasterQueueDuration() const;
+
+  /// The pointer input latched for this frame, if any.
+  std::optional<LatchedPointerInput> GetLatchedPointerInput() const;
+
   /// Count of the layer cache entries
   size_t GetLayerCacheCount() const;
 
@@ -84,6 +106,12 @@ class FrameTimingsRecorder {
   /// Total Bytes in all picture cache entries
   size_t GetPictureCacheBytes() const;
 
+  /// The growth of the process-wide |fml::FrameCounters| between the raster
+  /// start and raster end events, such as the number of layers prerolled or
+  /// raster cache hits. This includes work done concurrently by other threads
+  /// and other engines.
+  fml::FrameCounters::Snapshot GetFrameCounters() const;
+
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
@@ -96,6 +124,10 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the most recent pointer input right before the frame is
+  /// rasterized. Must be called after the build end event.
+  void RecordLatchedPointerInput(const LatchedPointerInput& pointer_input);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -140,12 +172,16 @@ class FrameTimingsRecorder {
   fml::TimePoint raster_start_;
   fml::TimePoint raster_end_;
   fml::TimePoint raster_end_wall_time_;
+  std::optional<LatchedPointerInput> latched_pointer_input_;
 
   size_t layer_cache_count_;
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  fml::FrameCounters::Snapshot raster_start_counters_ = {};
+  fml::FrameCounters::Snapshot frame_counters_ = {};
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
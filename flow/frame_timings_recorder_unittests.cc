@@ -76,6 +76,82 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimes) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), 0u);
 }
 
+TEST(FrameTimingsRecorderTest, RecordQueueDurations) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  recorder->RecordVsync(st, st + fml::TimeDelta::FromMilliseconds(16));
+
+  const auto build_start = st + fml::TimeDelta::FromMilliseconds(2);
+  const auto build_end = build_start + fml::TimeDelta::FromMilliseconds(8);
+  recorder->RecordBuildStart(build_start);
+  recorder->RecordBuildEnd(build_end);
+  ASSERT_EQ(recorder->GetBuildQueueDuration(),
+            fml::TimeDelta::FromMilliseconds(2));
+
+  const auto raster_start = build_end + fml::TimeDelta::FromMilliseconds(16);
+  recorder->RecordRasterStart(raster_start);
+  ASSERT_EQ(recorder->GetRasterQueueDuration(),
+            fml::TimeDelta::FromMilliseconds(16));
+}
+
+TEST(FrameTimingsRecorderTest, RecordLatchedPointerInput) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  ASSERT_FALSE(recorder->GetLatchedPointerInput().has_value());
+
+  const LatchedPointerInput pointer_input = {
+      .dispatch_time = now,
+      .physical_x = 10,
+      .physical_y = 20,
+  };
+  recorder->RecordLatchedPointerInput(pointer_input);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordRasterEnd();
+
+  auto latched = recorder->GetLatchedPointerInput();
+  ASSERT_TRUE(latched.has_value());
+  ASSERT_EQ(latched->dispatch_time, now);
+  ASSERT_EQ(latched->physical_x, 10);
+  ASSERT_EQ(latched->physical_y, 20);
+}
+
+TEST(FrameTimingsRecorderTest, RecordFrameCounters) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+
+  // Work done before the raster start is not attributed to the frame.
+  fml::FrameCounters::Add(fml::FrameCounters::kTextureUploads);
+
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  fml::FrameCounters::Add(fml::FrameCounters::kLayersPrerolled, 3);
+  fml::FrameCounters::Add(fml::FrameCounters::kRasterCacheHits);
+  fml::FrameCounters::Add(fml::FrameCounters::kBytesAllocated, 4096);
+  const auto timing = recorder->RecordRasterEnd();
+
+  // Work done after the raster end is not attributed to the frame either.
+  fml::FrameCounters::Add(fml::FrameCounters::kLayersPrerolled);
+
+  const auto counters = recorder->GetFrameCounters();
+  ASSERT_EQ(counters[fml::FrameCounters::kLayersPrerolled], 3u);
+  ASSERT_EQ(counters[fml::FrameCounters::kRasterCacheHits], 1u);
+  ASSERT_EQ(counters[fml::FrameCounters::kRasterCacheMisses], 0u);
+  ASSERT_EQ(counters[fml::FrameCounters::kTextureUploads], 0u);
+  ASSERT_EQ(counters[fml::FrameCounters::kBytesAllocated], 4096u);
+  ASSERT_EQ(timing.GetFrameCounters(), counters);
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kRasterEnd);
+  ASSERT_EQ(cloned->GetFrameCounters(), counters);
+}
+
 TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -255,4 +256,59 @@ fml::Milliseconds FixedRefreshRateUpdater::GetFrameBudget() const {
   return fixed_frame_budget_;
 }
 
+DeferredWorkStats::DeferredWorkStats() {
+  Reset();
+}
+
+void DeferredWorkStats::WorkScheduled() {
+  scheduled_count_++;
+}
+
+void DeferredWorkStats::WorkCompleted(const fml::TimeDelta& latency) {
+  FML_DCHECK(pending_count() > 0);
+  completed_count_++;
+  total_latency_ = total_latency_ + latency;
+  if (latency > max_latency_) {
+    max_latency_ = latency;
+  }
+}
+
+void DeferredWorkStats::WorkCancelled() {
+  FML_DCHECK(pending_count() > 0);
+  cancelled_count_++;
+}
+
+void DeferredWorkStats::RecordLookup(bool hit) {
+  if (hit) {
+    hit_count_++;
+  } else {
+    miss_count_++;
+  }
+}
+
+double DeferredWorkStats::HitRate() const {
+  size_t lookups = hit_count_ + miss_count_;
+  if (lookups == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(hit_count_) / lookups;
+}
+
+fml::TimeDelta DeferredWorkStats::AverageLatency() const {
+  if (completed_count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  return total_latency_ / static_cast<int64_t>(completed_count_);
+}
+
+void DeferredWorkStats::Reset() {
+  scheduled_count_ = 0;
+  completed_count_ = 0;
+  cancelled_count_ = 0;
+  hit_count_ = 0;
+  miss_count_ = 0;
+  total_latency_ = fml::TimeDelta::Zero();
+  max_latency_ = fml::TimeDelta::Zero();
+}
+
 }  // namespace flutter
@@ -91,6 +91,67 @@ class FixedRefreshRateStopwatch : public Stopwatch {
   FixedRefreshRateUpdater fixed_delegate_;
 };
 
+/// Statistics about work that is handed to a background thread and whose
+/// result is picked up by a later frame, such as the deferred preparation of
+/// raster cache entries.
+///
+/// All methods must be called on the same thread.
+class DeferredWorkStats {
+ public:
+  DeferredWorkStats();
+
+  /// Records that work was handed to a background thread.
+  void WorkScheduled();
+
+  /// Records that the result of deferred work was adopted |latency| after
+  /// the work was scheduled.
+  void WorkCompleted(const fml::TimeDelta& latency);
+
+  /// Records that scheduled work was abandoned before its result was adopted.
+  void WorkCancelled();
+
+  /// Records whether the result of deferred work was ready when a frame
+  /// wanted to use it.
+  void RecordLookup(bool hit);
+
+  size_t scheduled_count() const { return scheduled_count_; }
+
+  size_t completed_count() const { return completed_count_; }
+
+  size_t cancelled_count() const { return cancelled_count_; }
+
+  /// The number of scheduled work items whose results were not adopted or
+  /// abandoned yet.
+  size_t pending_count() const {
+    return scheduled_count_ - completed_count_ - cancelled_count_;
+  }
+
+  size_t hit_count() const { return hit_count_; }
+
+  size_t miss_count() const { return miss_count_; }
+
+  /// The fraction of lookups that found the result ready, or 0 if there were
+  /// no lookups.
+  double HitRate() const;
+
+  fml::TimeDelta AverageLatency() const;
+
+  fml::TimeDelta MaxLatency() const { return max_latency_; }
+
+  void Reset();
+
+ private:
+  size_t scheduled_count_;
+  size_t completed_count_;
+  size_t cancelled_count_;
+  size_t hit_count_;
+  size_t miss_count_;
+  fml::TimeDelta total_latency_;
+  fml::TimeDelta max_latency_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DeferredWorkStats);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_INSTRUMENTATION_H_
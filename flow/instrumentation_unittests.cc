@@ -42,5 +42,40 @@ TEST(Instrumentation, GetFrameBudgetFromUpdaterTest) {
   EXPECT_EQ(frame_budget_90fps, actual_frame_budget);
 }
 
+TEST(Instrumentation, DeferredWorkStatsTracksHitRateAndLatency) {
+  DeferredWorkStats stats;
+  EXPECT_EQ(stats.HitRate(), 0.0);
+  EXPECT_EQ(stats.AverageLatency(), fml::TimeDelta::Zero());
+
+  stats.WorkScheduled();
+  stats.WorkScheduled();
+  stats.WorkScheduled();
+  stats.RecordLookup(false);
+  EXPECT_EQ(stats.pending_count(), 3u);
+  stats.WorkCancelled();
+  EXPECT_EQ(stats.pending_count(), 2u);
+
+  stats.WorkCompleted(fml::TimeDelta::FromMilliseconds(4));
+  stats.WorkCompleted(fml::TimeDelta::FromMilliseconds(8));
+  stats.RecordLookup(true);
+  stats.RecordLookup(true);
+  stats.RecordLookup(true);
+
+  EXPECT_EQ(stats.scheduled_count(), 3u);
+  EXPECT_EQ(stats.completed_count(), 2u);
+  EXPECT_EQ(stats.cancelled_count(), 1u);
+  EXPECT_EQ(stats.pending_count(), 0u);
+  EXPECT_EQ(stats.hit_count(), 3u);
+  EXPECT_EQ(stats.miss_count(), 1u);
+  EXPECT_DOUBLE_EQ(stats.HitRate(), 0.75);
+  EXPECT_EQ(stats.AverageLatency(), fml::TimeDelta::FromMilliseconds(6));
+  EXPECT_EQ(stats.MaxLatency(), fml::TimeDelta::FromMilliseconds(8));
+
+  stats.Reset();
+  EXPECT_EQ(stats.scheduled_count(), 0u);
+  EXPECT_EQ(stats.HitRate(), 0.0);
+  EXPECT_EQ(stats.MaxLatency(), fml::TimeDelta::Zero());
+}
+
 }  // namespace testing
 }  // namespace flutter
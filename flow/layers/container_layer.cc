@@ -4,10 +4,23 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <atomic>
 #include <optional>
 
+#include "flutter/fml/frame_counters.h"
+
 namespace flutter {
 
+namespace {
+
+// Incremented by every Preroll that does not reuse retained Preroll results.
+// Such Preroll may update the layers of a retained subtree with different
+// inherited state (for example when flattening a layer for a screenshot), so
+// the retained results of all containers must be discarded.
+std::atomic<uint64_t> retained_preroll_epoch = 0;
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
@@ -19,6 +32,7 @@ void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
 
 void ContainerLayer::PreservePaintRegion(DiffContext* context) {
   Layer::PreservePaintRegion(context);
+  DiffContext::AutoRetainedSubtreeScope retained_subtree(context, this);
   for (auto& layer : layers_) {
     layer->PreservePaintRegion(context);
   }
@@ -34,6 +48,10 @@ void ContainerLayer::DiffChildren(DiffContext* context,
   }
   FML_DCHECK(old_layer);
 
+  // If the old layer was retained in previous frame, the paint regions of its
+  // descendants are only available through the retained subtree.
+  DiffContext::AutoRetainedSubtreeScope retained_subtree(context, old_layer);
+
   const auto& prev_layers = old_layer->layers_;
 
   // first mismatched element
@@ -89,8 +107,8 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
         // While we don't need to diff retained layers, we still need to
         // associate their paint region with current layer tree so that we can
-        // retrieve it in next frame diff
-        layer->PreservePaintRegion(context);
+        // retrieve it in next frame diff; This doesn't visit the subtree
+        context->PreserveRetainedSubtree(layer.get());
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -105,6 +123,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  retained_preroll_.reset();
 }
 
 void ContainerLayer::Preroll(PrerollContext* context) {
@@ -136,6 +155,7 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  uint64_t prerolled_layers = 0;
 
   for (auto& layer : layers_) {
     // Reset context->has_platform_view and context->has_texture_layer to false
@@ -148,7 +168,9 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    if (PrerollChild(context, layer.get())) {
+      prerolled_layers++;
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -165,6 +187,9 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
         child_has_texture_layer || context->has_texture_layer;
   }
 
+  fml::FrameCounters::Add(fml::FrameCounters::kLayersPrerolled,
+                          prerolled_layers);
+
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
@@ -173,6 +198,61 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   set_child_paint_bounds(*child_paint_bounds);
 }
 
+bool ContainerLayer::PrerollChild(PrerollContext* context, Layer* layer) {
+  if (!layer->as_container_layer()) {
+    layer->Preroll(context);
+    return true;
+  }
+  auto container = static_cast<ContainerLayer*>(layer);
+  if (!context->reuse_retained_preroll) {
+    retained_preroll_epoch.fetch_add(1, std::memory_order_relaxed);
+    container->retained_preroll_.reset();
+    layer->Preroll(context);
+    return true;
+  }
+
+  RetainedPreroll preroll = {
+      .transform = context->state_stack.transform_4x4(),
+      .device_cull_rect = context->state_stack.device_cull_rect(),
+      .has_raster_cache = context->raster_cache != nullptr,
+      .epoch = retained_preroll_epoch.load(std::memory_order_relaxed),
+  };
+
+  const auto& retained = container->retained_preroll_;
+  if (retained.has_value() && retained->epoch == preroll.epoch &&
+      retained->has_raster_cache == preroll.has_raster_cache &&
+      retained->device_cull_rect == preroll.device_cull_rect &&
+      retained->transform == preroll.transform) {
+    // Same instance with the same inherited state; Every layer in the subtree
+    // would compute exactly what it computed last time.
+    context->renderable_state_flags = retained->renderable_state_flags;
+    return false;
+  }
+
+  bool surface_needs_readback = context->surface_needs_readback;
+  size_t raster_cached_entries = context->raster_cached_entries
+                                     ? context->raster_cached_entries->size()
+                                     : 0;
+  context->surface_needs_readback = false;
+
+  layer->Preroll(context);
+
+  bool reusable =
+      !context->surface_needs_readback && !context->has_platform_view &&
+      !context->has_texture_layer &&
+      (!context->raster_cached_entries ||
+       context->raster_cached_entries->size() == raster_cached_entries);
+  context->surface_needs_readback |= surface_needs_readback;
+
+  if (reusable) {
+    preroll.renderable_state_flags = context->renderable_state_flags;
+    container->retained_preroll_ = preroll;
+  } else {
+    container->retained_preroll_.reset();
+  }
+  return true;
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
@@ -48,9 +49,31 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  // The inherited state of the last Preroll of a retained subtree, along with
+  // the results of that Preroll that are not stored in the layers themselves.
+  struct RetainedPreroll {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    bool has_raster_cache;
+    uint64_t epoch;
+    int renderable_state_flags;
+  };
+
+  // Prerolls the child unless it is a container whose subtree was prerolled
+  // with the same inherited state before, in which case its paint bounds,
+  // culling and raster cache decisions are kept as they are.
+  //
+  // Only subtrees without platform views, texture layers, readbacks and raster
+  // cache entries are skipped, as the Preroll of such subtrees has effects
+  // outside of the subtree that must be repeated every frame.
+  //
+  // Returns whether the child was prerolled.
+  static bool PrerollChild(PrerollContext* context, Layer* layer);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  std::optional<RetainedPreroll> retained_preroll_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -560,6 +560,84 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, RetainedSubtreePrerollIsReused) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  preroll_context()->state_stack.set_preroll_delegate(initial_transform);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+  EXPECT_EQ(retained_layer->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+
+  // Layers don't change once they are part of a layer tree. The change is
+  // only used to observe whether the retained subtree is prerolled again.
+  mock_layer->set_fake_opacity_compatible(true);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(retained_layer->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+
+  // Different inherited state
+  SkMatrix transform = SkMatrix::Translate(10.0f, 10.0f);
+  preroll_context()->state_stack.set_preroll_delegate(transform);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), transform);
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreePrerollIsNotReusedWhenDisabled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+
+  mock_layer->set_fake_opacity_compatible(true);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
+TEST_F(ContainerLayerTest, RetainedSubtreeWithTexturePrerollIsNotReused) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_has_texture_layer(true);
+  auto retained_layer = std::make_shared<ContainerLayer>();
+  retained_layer->Add(mock_layer);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(retained_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+
+  preroll_context()->has_texture_layer = false;
+  mock_layer->set_fake_opacity_compatible(true);
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -763,6 +841,61 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+// Retained subtree whose root is replaced after being retained for several
+// frames
+TEST_F(ContainerLayerDiffTest, ReplaceRetainedSubtree) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+
+  auto path1a = SkPath().addRect(SkRect::MakeLTRB(0, 100, 50, 150));
+  auto path2a = SkPath().addRect(SkRect::MakeLTRB(100, 100, 150, 150));
+
+  auto c1 = CreateContainerLayer(std::make_shared<MockLayer>(path1));
+  auto retained =
+      CreateContainerLayer({c1, std::make_shared<MockLayer>(path2)});
+
+  MockLayerTree t1;
+  t1.root()->Add(retained);
+
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 150, 50));
+
+  MockLayerTree t2;
+  t2.root()->Add(retained);
+
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  MockLayerTree t3;
+  t3.root()->Add(retained);
+
+  damage = DiffLayerTree(t3, t2);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  // Paint regions of descendants of the old subtree are still needed
+  auto m2a = std::make_shared<MockLayer>(path2a);
+  auto replacement = CreateContainerLayer({c1, m2a});
+  replacement->AssignOldLayer(retained.get());
+
+  MockLayerTree t4;
+  t4.root()->Add(replacement);
+
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 0, 150, 150));
+
+  // c1 was retained inside of the replaced subtree
+  auto c1a = CreateContainerLayer(std::make_shared<MockLayer>(path1a));
+  c1a->AssignOldLayer(c1.get());
+  auto replacement2 = CreateContainerLayer({c1a, m2a});
+  replacement2->AssignOldLayer(replacement.get());
+
+  MockLayerTree t5;
+  t5.root()->Add(replacement2);
+
+  damage = DiffLayerTree(t5, t4);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 50, 150));
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -71,6 +71,7 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  is_tiled_ = false;
   DisplayListComplexityCalculator* complexity_calculator =
       context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
                                 context->gr_context->backend())
@@ -93,6 +94,8 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
   if (context->raster_cached_entries && context->raster_cache) {
     context->raster_cached_entries->push_back(this);
     cache_state_ = CacheState::kCurrent;
+    is_tiled_ = context->raster_cache->ShouldCacheAsTiles(
+        display_list_->bounds(), transformation_matrix_);
   }
   return;
 }
@@ -112,7 +115,14 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
   } else {
-    if (cache_info.has_image) {
+    bool has_image = cache_info.has_image;
+    if (is_tiled_) {
+      device_cull_rect_ = context->state_stack.device_cull_rect();
+      has_image = raster_cache->MarkTilesSeen(key_id_, transformation_matrix_,
+                                              display_list_->bounds(),
+                                              device_cull_rect_);
+    }
+    if (has_image) {
       context->renderable_state_flags |=
           LayerStateStack::kCallerCanApplyOpacity;
     }
@@ -133,6 +143,13 @@ bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
     return false;
   }
   if (cache_state_ == CacheState::kCurrent) {
+    if (is_tiled_) {
+      // Tiles cannot preserve the R-Tree of the content, so draw the display
+      // list itself in that case.
+      return !context.rendering_above_platform_view &&
+             context.raster_cache->DrawTiles(key_id_, display_list_->bounds(),
+                                             *canvas, paint);
+    }
     return context.raster_cache->Draw(key_id_, *canvas, paint,
                                       context.rendering_above_platform_view);
   }
@@ -156,6 +173,22 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       !context.raster_cache->GenerateNewCacheInThisFrame() || !id.has_value()) {
     return false;
   }
+  if (is_tiled_) {
+    RasterCache::Context r_context = {
+        // clang-format off
+        .gr_context         = context.gr_context,
+        .dst_color_space    = context.dst_color_space,
+        .matrix             = transformation_matrix_,
+        .logical_rect       = display_list_->bounds(),
+        .flow_type          = flow_type,
+        // clang-format on
+    };
+    return context.raster_cache->UpdateTiles(
+        id.value(), r_context, device_cull_rect_,
+        [display_list = display_list_](DlCanvas* canvas) {
+          canvas->DrawDisplayList(display_list);
+        });
+  }
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   RasterCache::Context r_context = {
       // clang-format off
@@ -166,11 +199,17 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .flow_type          = flow_type,
       // clang-format on
   };
+  auto render_function = [display_list = display_list_](DlCanvas* canvas) {
+    canvas->DrawDisplayList(display_list);
+  };
+  // Display lists that reference GPU resources of the raster thread cannot be
+  // rendered on another thread.
+  if (context.raster_cache->deferred_preparation_enabled() &&
+      display_list_->isUIThreadSafe()) {
+    return context.raster_cache->UpdateCacheEntryDeferred(
+        id.value(), r_context, render_function, display_list_->rtree());
+  }
   return context.raster_cache->UpdateCacheEntry(
-      id.value(), r_context,
-      [display_list = display_list_](DlCanvas* canvas) {
-        canvas->DrawDisplayList(display_list);
-      },
-      display_list_->rtree());
+      id.value(), r_context, render_function, display_list_->rtree());
 }
 }  // namespace flutter
@@ -53,8 +53,16 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
 
   const DisplayList* display_list() const { return display_list_.get(); }
 
+  // Whether the display list is cached as tiles rather than a single image.
+  // See |RasterCache::SetTiledDisplayListCaching|.
+  bool is_tiled() const { return is_tiled_; }
+
  private:
   SkMatrix transformation_matrix_;
+  // The device cull rect at the time of preroll, used to decide which tiles
+  // need to be rasterized when the display list is cached as tiles.
+  SkRect device_cull_rect_ = SkRect::MakeEmpty();
+  bool is_tiled_ = false;
   sk_sp<DisplayList> display_list_;
   SkPoint offset_;
   bool is_complex_;
@@ -88,6 +88,11 @@ struct PrerollContext {
   // the embedders that must decide between creating SkPicture or
   // DisplayList objects for the inter-view slices of the layer tree.
   bool display_list_enabled = false;
+
+  // Whether retained container layers may skip prerolling their subtree if
+  // they are prerolled with the same inherited state as in their previous
+  // Preroll. This is only set when prerolling the layer tree of a frame.
+  bool reuse_retained_preroll = false;
 };
 
 struct PaintContext {
@@ -12,6 +12,7 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "include/core/SkMatrix.h"
@@ -65,10 +66,12 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .texture_registry              = frame.context().texture_registry(),
       .raster_cached_entries         = &raster_cache_items_,
       .display_list_enabled          = frame.display_list_builder() != nullptr,
+      .reuse_retained_preroll        = true,
       // clang-format on
   };
 
   root_layer_->Preroll(&context);
+  fml::FrameCounters::Add(fml::FrameCounters::kLayersPrerolled);
 
   return context.surface_needs_readback;
 }
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+
+namespace flutter {
+namespace {
+
+// 100 retained subtrees of 100 layers each.
+constexpr int kSubtreeCount = 100;
+constexpr int kLayersPerSubtree = 100;
+constexpr SkScalar kSubtreeSize = 100;
+constexpr SkScalar kLayerSize = 10;
+const SkISize kFrameSize = SkISize::Make(1000, 1000);
+
+// Every frame replaces one subtree, which is 1% of the layers of the tree.
+// After |kFrameCount| frames the first frame follows again, so that the frames
+// can be diffed and prerolled in a loop, each against the previous one.
+constexpr int kFrameCount = kSubtreeCount * 2;
+
+std::shared_ptr<ContainerLayer> CreateSubtree(int index, DlColor color) {
+  auto subtree = std::make_shared<ContainerLayer>();
+  SkPoint origin = SkPoint::Make(index % 10 * kSubtreeSize,  //
+                                 index / 10 * kSubtreeSize);
+  for (int i = 0; i < kLayersPerSubtree; i++) {
+    DisplayListBuilder builder;
+    builder.DrawRect(SkRect::MakeXYWH(0, 0, kLayerSize, kLayerSize),
+                     DlPaint(color));
+    SkPoint offset = origin + SkPoint::Make(i % 10 * kLayerSize,  //
+                                            i / 10 * kLayerSize);
+    subtree->Add(std::make_shared<DisplayListLayer>(offset, builder.Build(),
+                                                    false, false));
+  }
+  return subtree;
+}
+
+class RetainedLayerTreeFrames {
+ public:
+  RetainedLayerTreeFrames() {
+    std::array<std::shared_ptr<ContainerLayer>, kSubtreeCount> subtrees;
+    std::array<std::shared_ptr<ContainerLayer>, kSubtreeCount> replacements;
+    for (int i = 0; i < kSubtreeCount; i++) {
+      subtrees[i] = CreateSubtree(i, DlColor::kBlue());
+      replacements[i] = CreateSubtree(i, DlColor::kRed());
+      replacements[i]->AssignOldLayer(subtrees[i].get());
+    }
+    for (int frame = 0; frame < kFrameCount; frame++) {
+      auto root = std::make_shared<ContainerLayer>();
+      for (int i = 0; i < kSubtreeCount; i++) {
+        // Subtree i is replaced in frame i and restored in frame i + 100.
+        bool replaced = frame < kSubtreeCount ? i <= frame
+                                              : i > frame - kSubtreeCount;
+        root->Add(replaced ? replacements[i] : subtrees[i]);
+      }
+      roots_[frame] = std::move(root);
+    }
+    // Compute the paint regions of all frames once, so that every frame can
+    // be diffed against a previous frame with retained subtrees. The last
+    // frame is first diffed without a previous frame, which repaints it fully.
+    PaintRegionMap empty_paint_region_map;
+    DiffContext context(kFrameSize, paint_region_maps_[kFrameCount - 1],
+                        empty_paint_region_map, false);
+    context.PushCullRect(SkRect::Make(kFrameSize));
+    {
+      DiffContext::AutoSubtreeRestore subtree(&context);
+      context.MarkSubtreeDirty(SkRect::Make(kFrameSize));
+      roots_[kFrameCount - 1]->Diff(&context, nullptr);
+    }
+    for (int frame = 0; frame < kFrameCount; frame++) {
+      Diff(frame);
+    }
+  }
+
+  Damage Diff(int frame) {
+    int prev_frame = (frame + kFrameCount - 1) % kFrameCount;
+    DiffContext context(kFrameSize, paint_region_maps_[frame],
+                        paint_region_maps_[prev_frame], false);
+    context.PushCullRect(SkRect::Make(kFrameSize));
+    roots_[frame]->Diff(&context, roots_[prev_frame].get());
+    return context.ComputeDamage(SkIRect::MakeEmpty());
+  }
+
+  ContainerLayer* root(int frame) { return roots_[frame].get(); }
+
+ private:
+  std::array<std::shared_ptr<ContainerLayer>, kFrameCount> roots_;
+  std::array<PaintRegionMap, kFrameCount> paint_region_maps_;
+};
+
+}  // namespace
+
+static void BM_DiffRetainedLayerTree(benchmark::State& state) {  // NOLINT
+  RetainedLayerTreeFrames frames;
+  int frame = 0;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(frames.Diff(frame));
+    frame = (frame + 1) % kFrameCount;
+  }
+}
+
+static void BM_PrerollRetainedLayerTree(benchmark::State& state) {  // NOLINT
+  RetainedLayerTreeFrames frames;
+  FixedRefreshRateStopwatch unused_stopwatch;
+  std::vector<RasterCacheItem*> raster_cache_items;
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(SkRect::Make(kFrameSize));
+  PrerollContext context{
+      // clang-format off
+      .raster_cache                  = nullptr,
+      .gr_context                    = nullptr,
+      .view_embedder                 = nullptr,
+      .state_stack                   = state_stack,
+      .dst_color_space               = nullptr,
+      .surface_needs_readback        = false,
+      .raster_time                   = unused_stopwatch,
+      .ui_time                       = unused_stopwatch,
+      .texture_registry              = nullptr,
+      .raster_cached_entries         = &raster_cache_items,
+      .reuse_retained_preroll        = state.range(0) != 0,
+      // clang-format on
+  };
+  int frame = 0;
+  while (state.KeepRunning()) {
+    frames.root(frame)->Preroll(&context);
+    frame = (frame + 1) % kFrameCount;
+  }
+}
+
+BENCHMARK(BM_DiffRetainedLayerTree)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PrerollRetainedLayerTree)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
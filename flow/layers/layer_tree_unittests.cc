@@ -235,6 +235,7 @@ TEST_F(LayerTreeTest, PrerollContextInitialization) {
 
     EXPECT_EQ(context.renderable_state_flags, 0);
     EXPECT_EQ(context.raster_cached_entries, nullptr);
+    EXPECT_EQ(context.reuse_retained_preroll, false);
   };
 
   // These 4 initializers are required because they are handled by reference
@@ -4,7 +4,9 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <mutex>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -13,6 +15,7 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -21,6 +24,7 @@
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 namespace flutter {
@@ -74,13 +78,11 @@ RasterCache::RasterCache(size_t access_threshold,
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
-/// @note Procedure doesn't copy all closures.
-std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+sk_sp<SkImage> RasterCache::RasterizeToImage(
     const RasterCache::Context& context,
-    sk_sp<const DlRTree> rtree,
     const std::function<void(DlCanvas*)>& draw_function,
-    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
-    const {
+    const std::function<void(DlCanvas*, const SkRect& rect)>&
+        draw_checkerboard) {
   auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
@@ -106,13 +108,29 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   canvas.Transform(matrix);
   draw_function(&canvas);
 
-  if (checkerboard_images_) {
+  if (draw_checkerboard) {
     draw_checkerboard(&canvas, context.logical_rect);
   }
 
-  auto image = DlImage::Make(surface->makeImageSnapshot());
+  return surface->makeImageSnapshot();
+}
+
+/// @note Procedure doesn't copy all closures.
+std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  auto image =
+      RasterizeToImage(context, draw_function,
+                       checkerboard_images_ ? draw_checkerboard : nullptr);
+  if (!image) {
+    return nullptr;
+  }
   return std::make_unique<RasterCacheResult>(
-      image, context.logical_rect, context.flow_type, std::move(rtree));
+      DlImage::Make(std::move(image)), context.logical_rect, context.flow_type,
+      std::move(rtree));
 }
 
 bool RasterCache::UpdateCacheEntry(
@@ -141,6 +159,292 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+struct RasterCache::DeferredResult {
+  const fml::TimePoint scheduled_time = fml::TimePoint::Now();
+  std::mutex mutex;
+  bool done = false;
+  std::unique_ptr<RasterCacheResult> result;
+};
+
+void RasterCache::SetDeferredPreparation(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    ResourceContextProvider resource_context_provider) {
+  // Results of work scheduled on the previous task runner are dropped with
+  // their entries.
+  Clear();
+  deferred_task_runner_ = std::move(task_runner);
+  resource_context_provider_ = std::move(resource_context_provider);
+  deferred_preparation_stats_.Reset();
+}
+
+bool RasterCache::UpdateCacheEntryDeferred(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    const std::function<void(DlCanvas*)>& render_function,
+    sk_sp<const DlRTree> rtree) const {
+  if (!deferred_task_runner_) {
+    return UpdateCacheEntry(id, raster_cache_context, render_function,
+                            std::move(rtree));
+  }
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image || entry.pending_result) {
+    return entry.image != nullptr;
+  }
+
+  auto result = std::make_shared<DeferredResult>();
+  entry.deferred = true;
+  entry.pending_result = result;
+  deferred_preparation_stats_.WorkScheduled();
+  // Scheduling counts against the per frame limit like rasterizing does, so
+  // that a burst of new entries is spread out over several frames.
+  if (id.type() == RasterCacheKeyType::kDisplayList) {
+    display_list_cached_this_frame_++;
+  }
+
+  std::function<void(DlCanvas*, const SkRect& rect)> draw_checkerboard;
+  if (checkerboard_images_) {
+    draw_checkerboard = DrawCheckerboard;
+  }
+  deferred_task_runner_->PostTask(
+      [result, render_function, draw_checkerboard, rtree = std::move(rtree),
+       color_space = sk_ref_sp(raster_cache_context.dst_color_space),
+       matrix = raster_cache_context.matrix,
+       logical_rect = raster_cache_context.logical_rect,
+       flow_type = raster_cache_context.flow_type,
+       resource_context_provider = resource_context_provider_]() mutable {
+        TRACE_EVENT0("flutter", "RasterCache::PrepareDeferredEntry");
+        // The content is rasterized on the CPU so that the rasterization
+        // does not contend with the frames for the GPU context.
+        RasterCache::Context context = {
+            // clang-format off
+            .gr_context         = nullptr,
+            .dst_color_space    = color_space.get(),
+            .matrix             = matrix,
+            .logical_rect       = logical_rect,
+            .flow_type          = flow_type,
+            // clang-format on
+        };
+        auto image =
+            RasterizeToImage(context, render_function, draw_checkerboard);
+        GrDirectContext* resource_context =
+            image && resource_context_provider ? resource_context_provider()
+                                               : nullptr;
+        SkPixmap pixmap;
+        if (resource_context && image->peekPixels(&pixmap)) {
+          auto texture_image = SkImages::CrossContextTextureFromPixmap(
+              resource_context, pixmap, /*buildMips=*/false,
+              /*limitToMaxTextureSize=*/true);
+          if (texture_image) {
+            image = std::move(texture_image);
+          }
+        }
+        std::unique_ptr<RasterCacheResult> cache_result;
+        if (image) {
+          cache_result = std::make_unique<RasterCacheResult>(
+              DlImage::Make(std::move(image)), logical_rect, flow_type,
+              std::move(rtree));
+        }
+        std::scoped_lock lock(result->mutex);
+        result->result = std::move(cache_result);
+        result->done = true;
+      });
+  return false;
+}
+
+void RasterCache::AdoptDeferredResults() {
+  for (auto& [key, entry] : cache_) {
+    if (!entry.pending_result) {
+      continue;
+    }
+    DeferredResult& result = *entry.pending_result;
+    {
+      std::scoped_lock lock(result.mutex);
+      if (!result.done) {
+        continue;
+      }
+      // A failed preparation leaves the entry without an image, so it is
+      // scheduled again the next time it is prepared.
+      entry.image = std::move(result.result);
+    }
+    deferred_preparation_stats_.WorkCompleted(fml::TimePoint::Now() -
+                                              result.scheduled_time);
+    entry.pending_result.reset();
+  }
+}
+
+void RasterCache::SetTiledDisplayListCaching(bool enabled) {
+  if (tiled_display_list_caching_ == enabled) {
+    return;
+  }
+  tiled_display_list_caching_ = enabled;
+  // Content switches between being cached as a single image and as tiles, so
+  // the existing entries would never be used again.
+  Clear();
+}
+
+bool RasterCache::ShouldCacheAsTiles(const SkRect& logical_rect,
+                                     const SkMatrix& matrix) const {
+  if (!tiled_display_list_caching_ || !matrix.isScaleTranslate()) {
+    return false;
+  }
+  // Content that fits in a few tiles is cheaper to cache as a single image.
+  SkRect device_rect = RasterCacheUtil::GetDeviceBounds(logical_rect, matrix);
+  return device_rect.width() > 2 * kTileSize ||
+         device_rect.height() > 2 * kTileSize;
+}
+
+SkRect RasterCache::GetTileSpaceBounds(const SkRect& logical_rect,
+                                       const SkMatrix& matrix) {
+  auto integral_matrix = RasterCacheUtil::GetIntegralTransCTM(matrix);
+  SkRect bounds = RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect,
+                                                             integral_matrix);
+  bounds.offset(-integral_matrix.getTranslateX(),
+                -integral_matrix.getTranslateY());
+  return bounds;
+}
+
+SkIRect RasterCache::GetTileRange(const SkRect& tile_space_bounds,
+                                  const SkMatrix& matrix,
+                                  const SkRect& device_rect) {
+  auto integral_matrix = RasterCacheUtil::GetIntegralTransCTM(matrix);
+  SkRect visible = device_rect.makeOffset(-integral_matrix.getTranslateX(),
+                                          -integral_matrix.getTranslateY());
+  if (!visible.intersect(tile_space_bounds)) {
+    return SkIRect::MakeEmpty();
+  }
+  return SkIRect::MakeLTRB(
+      SkScalarFloorToInt(visible.fLeft / kTileSize),
+      SkScalarFloorToInt(visible.fTop / kTileSize),
+      SkScalarCeilToInt(visible.fRight / kTileSize),
+      SkScalarCeilToInt(visible.fBottom / kTileSize));
+}
+
+bool RasterCache::MarkTilesSeen(const RasterCacheKeyID& id,
+                                const SkMatrix& matrix,
+                                const SkRect& logical_rect,
+                                const SkRect& device_cull_rect) const {
+  RasterCacheKey key(id, matrix);
+  SkRect bounds = GetTileSpaceBounds(logical_rect, matrix);
+  SkIRect visible = GetTileRange(bounds, matrix, device_cull_rect);
+  // Tiles adjacent to the visible ones are retained so that content which is
+  // scrolled back and forth is not rasterized again.
+  SkIRect retained = GetTileRange(
+      bounds, matrix, device_cull_rect.makeOutset(kTileSize, kTileSize));
+
+  bool has_images = true;
+  for (int y = retained.fTop; y < retained.fBottom; y++) {
+    for (int x = retained.fLeft; x < retained.fRight; x++) {
+      SkIPoint tile = SkIPoint::Make(x, y);
+      if (visible.contains(x, y)) {
+        Tile& entry = tiles_[{key, tile}];
+        entry.encountered_this_frame = true;
+        has_images = has_images && entry.image != nullptr;
+      } else if (auto it = tiles_.find({key, tile}); it != tiles_.end()) {
+        it->second.encountered_this_frame = true;
+      }
+    }
+  }
+  return has_images;
+}
+
+bool RasterCache::UpdateTiles(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    const SkRect& device_cull_rect,
+    const std::function<void(DlCanvas*)>& render_function) const {
+  const SkMatrix& matrix = raster_cache_context.matrix;
+  RasterCacheKey key(id, matrix);
+  SkRect bounds = GetTileSpaceBounds(raster_cache_context.logical_rect, matrix);
+  SkIRect visible = GetTileRange(bounds, matrix, device_cull_rect);
+  // Tiles are rasterized with the scale of the matrix only. They are placed
+  // at the integral device translation of the matrix when drawn.
+  auto scale_matrix = RasterCacheUtil::GetIntegralTransCTM(matrix);
+  scale_matrix.setTranslateX(0);
+  scale_matrix.setTranslateY(0);
+
+  bool rasterized = false;
+  bool has_images = true;
+  for (int y = visible.fTop; y < visible.fBottom; y++) {
+    for (int x = visible.fLeft; x < visible.fRight; x++) {
+      Tile& entry = tiles_[{key, SkIPoint::Make(x, y)}];
+      entry.encountered_this_frame = true;
+      if (entry.image) {
+        continue;
+      }
+      SkRect tile_rect = SkRect::MakeXYWH(x * kTileSize, y * kTileSize,
+                                          kTileSize, kTileSize);
+      if (!tile_rect.intersect(bounds)) {
+        continue;
+      }
+      const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+          tile_rect.width(), tile_rect.height(),
+          sk_ref_sp(raster_cache_context.dst_color_space));
+      sk_sp<SkSurface> surface =
+          raster_cache_context.gr_context
+              ? SkSurfaces::RenderTarget(raster_cache_context.gr_context,
+                                         skgpu::Budgeted::kYes, image_info)
+              : SkSurfaces::Raster(image_info);
+      if (!surface) {
+        has_images = false;
+        continue;
+      }
+      DlSkCanvasAdapter canvas(surface->getCanvas());
+      canvas.Clear(DlColor::kTransparent());
+      canvas.Translate(-tile_rect.left(), -tile_rect.top());
+      canvas.Transform(scale_matrix);
+      render_function(&canvas);
+      if (checkerboard_images_) {
+        DrawCheckerboard(&canvas, raster_cache_context.logical_rect);
+      }
+      entry.image = DlImage::Make(surface->makeImageSnapshot());
+      rasterized = true;
+    }
+  }
+  if (rasterized) {
+    display_list_cached_this_frame_++;
+  }
+  return has_images;
+}
+
+bool RasterCache::DrawTiles(const RasterCacheKeyID& id,
+                            const SkRect& logical_rect,
+                            DlCanvas& canvas,
+                            const DlPaint* paint) const {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform());
+  if (!matrix.isScaleTranslate()) {
+    return false;
+  }
+  RasterCacheKey key(id, matrix);
+  SkRect bounds = GetTileSpaceBounds(logical_rect, matrix);
+  SkIRect visible =
+      GetTileRange(bounds, matrix, canvas.GetDestinationClipBounds());
+
+  std::vector<std::pair<sk_sp<DlImage>, SkPoint>> draws;
+  draws.reserve(visible.width() * visible.height());
+  for (int y = visible.fTop; y < visible.fBottom; y++) {
+    for (int x = visible.fLeft; x < visible.fRight; x++) {
+      auto it = tiles_.find({key, SkIPoint::Make(x, y)});
+      if (it == tiles_.end() || !it->second.image) {
+        return false;
+      }
+      // Tiles on the edge of the content are clipped to its bounds.
+      SkPoint origin =
+          SkPoint::Make(std::max<SkScalar>(x * kTileSize, bounds.fLeft),
+                        std::max<SkScalar>(y * kTileSize, bounds.fTop));
+      draws.emplace_back(it->second.image, origin);
+    }
+  }
+
+  DlAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.TransformReset();
+  canvas.Translate(matrix.getTranslateX(), matrix.getTranslateY());
+  for (const auto& [image, origin] : draws) {
+    canvas.DrawImage(image, origin, DlImageSampling::kNearestNeighbor, paint);
+  }
+  return true;
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
@@ -179,20 +483,28 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
                        bool preserve_rtree) const {
   auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
   if (it == cache_.end()) {
+    fml::FrameCounters::Add(fml::FrameCounters::kRasterCacheMisses);
     return false;
   }
 
   Entry& entry = it->second;
 
+  if (entry.deferred) {
+    deferred_preparation_stats_.RecordLookup(entry.image != nullptr);
+  }
+
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    fml::FrameCounters::Add(fml::FrameCounters::kRasterCacheHits);
     return true;
   }
 
+  fml::FrameCounters::Add(fml::FrameCounters::kRasterCacheMisses);
   return false;
 }
 
 void RasterCache::BeginFrame() {
+  AdoptDeferredResults();
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -209,6 +521,15 @@ void RasterCache::UpdateMetrics() {
     }
     entry.encountered_this_frame = false;
   }
+  for (auto& [key, tile] : tiles_) {
+    FML_DCHECK(tile.encountered_this_frame);
+    if (tile.image) {
+      RasterCacheMetrics& metrics = GetMetricsForKind(key.key.kind());
+      metrics.in_use_count++;
+      metrics.in_use_bytes += tile.image->GetApproximateByteSize();
+    }
+    tile.encountered_this_frame = false;
+  }
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
@@ -222,6 +543,9 @@ void RasterCache::EvictUnusedCacheEntries() {
   }
 
   for (auto it : dead) {
+    if (it->second.pending_result) {
+      deferred_preparation_stats_.WorkCancelled();
+    }
     if (it->second.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.eviction_count++;
@@ -229,6 +553,19 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+
+  for (auto it = tiles_.begin(); it != tiles_.end();) {
+    if (it->second.encountered_this_frame) {
+      ++it;
+      continue;
+    }
+    if (it->second.image) {
+      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.key.kind());
+      metrics.eviction_count++;
+      metrics.eviction_bytes += it->second.image->GetApproximateByteSize();
+    }
+    it = tiles_.erase(it);
+  }
 }
 
 void RasterCache::EndFrame() {
@@ -237,7 +574,13 @@ void RasterCache::EndFrame() {
 }
 
 void RasterCache::Clear() {
+  for (const auto& [key, entry] : cache_) {
+    if (entry.pending_result) {
+      deferred_preparation_stats_.WorkCancelled();
+    }
+  }
   cache_.clear();
+  tiles_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -287,6 +630,16 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
       "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+  if (deferred_task_runner_) {
+    const DeferredWorkStats& stats = deferred_preparation_stats_;
+    FML_TRACE_COUNTER(
+        "flutter",                                                        //
+        "RasterCacheDeferred", reinterpret_cast<int64_t>(this),           //
+        "PendingCount", stats.pending_count(),                            //
+        "HitPercent", static_cast<int64_t>(stats.HitRate() * 100),        //
+        "AverageLatencyMicros", stats.AverageLatency().ToMicroseconds(),  //
+        "MaxLatencyMicros", stats.MaxLatency().ToMicroseconds());
+  }
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -310,6 +663,11 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
       picture_cache_bytes += item.second.image->image_bytes();
     }
   }
+  for (const auto& [key, tile] : tiles_) {
+    if (tile.image) {
+      picture_cache_bytes += tile.image->GetApproximateByteSize();
+    }
+  }
   return picture_cache_bytes;
 }
 
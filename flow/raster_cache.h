@@ -9,14 +9,17 @@
 #include <unordered_map>
 
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 class GrDirectContext;
@@ -250,14 +253,191 @@ class RasterCache {
                         const std::function<void(DlCanvas*)>& render_function,
                         sk_sp<const DlRTree> rtree = nullptr) const;
 
+  /**
+   * @brief Provides the context that images prepared in the background are
+   * uploaded to. It is called on the task runner that the images are
+   * prepared on and may return nullptr, in which case the images stay in
+   * CPU memory.
+   */
+  using ResourceContextProvider = std::function<GrDirectContext*()>;
+
+  /**
+   * @brief Prepare the images of display list cache entries on the given
+   * task runner instead of during the frame.
+   *
+   * In this mode, a display list that becomes cacheable is rasterized on the
+   * task runner and uploaded to the context returned by
+   * |resource_context_provider|, which must be shareable with the context
+   * the frames are rendered with. The display list keeps being drawn
+   * uncached until its image is ready. Finished images are adopted by the
+   * cache in |BeginFrame|, so an entry never changes in the middle of a
+   * frame.
+   *
+   * Passing a null task runner disables the mode. Layer entries and tiles are
+   * always prepared during the frame.
+   */
+  void SetDeferredPreparation(
+      fml::RefPtr<fml::TaskRunner> task_runner,
+      ResourceContextProvider resource_context_provider = nullptr);
+
+  bool deferred_preparation_enabled() const {
+    return deferred_task_runner_ != nullptr;
+  }
+
+  /**
+   * @brief Like |UpdateCacheEntry|, but the image is prepared on the task
+   * runner given to |SetDeferredPreparation|. The render function is called
+   * on that task runner and must only reference content that is safe to use
+   * there.
+   * @return true iff the entry already has an image.
+   */
+  bool UpdateCacheEntryDeferred(
+      const RasterCacheKeyID& id,
+      const Context& raster_cache_context,
+      const std::function<void(DlCanvas*)>& render_function,
+      sk_sp<const DlRTree> rtree = nullptr) const;
+
+  /**
+   * @brief The hit rate and latency of the entries prepared on the deferred
+   * preparation task runner since it was set.
+   */
+  const DeferredWorkStats& deferred_preparation_stats() const {
+    return deferred_preparation_stats_;
+  }
+
+  /**
+   * The edge length, in physical pixels, of the tiles that large display
+   * lists are cached in when tiled caching is enabled.
+   */
+  static constexpr int kTileSize = 512;
+
+  /**
+   * @brief Enable or disable caching large display lists as a grid of tiles.
+   *
+   * In this mode, display lists drawn with a scale and translate transform
+   * that span more than a couple of tiles are rasterized into fixed-size
+   * tiles keyed by the display list, the tile coordinate and the scale the
+   * display list is drawn at. Only tiles that intersect the cull rect are
+   * rasterized and drawn, so scrolling such a display list only rasterizes
+   * the newly exposed tiles.
+   */
+  void SetTiledDisplayListCaching(bool enabled);
+
+  bool tiled_display_list_caching() const {
+    return tiled_display_list_caching_;
+  }
+
+  /**
+   * @brief Whether the content with the given bounds drawn with the given
+   * matrix should be cached as tiles instead of a single image.
+   */
+  bool ShouldCacheAsTiles(const SkRect& logical_rect,
+                          const SkMatrix& matrix) const;
+
+  /**
+   * @brief Mark the tiles of the content that intersect the device cull
+   * rect, or lie within one tile of it, as encountered by the current frame
+   * so that they are not evicted.
+   * @return true iff all tiles intersecting the cull rect have images.
+   */
+  bool MarkTilesSeen(const RasterCacheKeyID& id,
+                     const SkMatrix& matrix,
+                     const SkRect& logical_rect,
+                     const SkRect& device_cull_rect) const;
+
+  /**
+   * @brief Rasterize the tiles of the content that intersect the device cull
+   * rect and do not have an image yet.
+   * @return true iff all tiles intersecting the cull rect have images.
+   */
+  bool UpdateTiles(const RasterCacheKeyID& id,
+                   const Context& raster_cache_context,
+                   const SkRect& device_cull_rect,
+                   const std::function<void(DlCanvas*)>& render_function) const;
+
+  /**
+   * @brief Draw the tiles of the content that intersect the clip of the
+   * canvas.
+   * @return true iff all of these tiles had images and were drawn. If false
+   * is returned, nothing was drawn.
+   */
+  bool DrawTiles(const RasterCacheKeyID& id,
+                 const SkRect& logical_rect,
+                 DlCanvas& canvas,
+                 const DlPaint* paint) const;
+
+  /**
+   * Return the number of tiles in the tile cache regardless of whether they
+   * have been populated with an image.
+   */
+  size_t GetTileCount() const { return tiles_.size(); }
+
  private:
+  // The result of preparing an entry on the deferred preparation task runner.
+  struct DeferredResult;
+
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // Whether the image of this entry is prepared in the background.
+    bool deferred = false;
     std::unique_ptr<RasterCacheResult> image;
+    // Set while the image is being prepared in the background.
+    std::shared_ptr<DeferredResult> pending_result;
+  };
+
+  struct TileKey {
+    // The content and the matrix (without translation) it is drawn with.
+    RasterCacheKey key;
+    SkIPoint tile;
+
+    struct Hash {
+      std::size_t operator()(const TileKey& key) const {
+        return fml::HashCombine(RasterCacheKey::Hash{}(key.key), key.tile.fX,
+                                key.tile.fY);
+      }
+    };
+
+    struct Equal {
+      bool operator()(const TileKey& lhs, const TileKey& rhs) const {
+        return RasterCacheKey::Equal{}(lhs.key, rhs.key) &&
+               lhs.tile == rhs.tile;
+      }
+    };
   };
 
+  struct Tile {
+    bool encountered_this_frame = false;
+    sk_sp<DlImage> image;
+  };
+
+  using TileMap =
+      std::unordered_map<TileKey, Tile, TileKey::Hash, TileKey::Equal>;
+
+  // The bounds of the content relative to the integral device translation of
+  // |matrix|. Tiles subdivide this space starting at its origin.
+  static SkRect GetTileSpaceBounds(const SkRect& logical_rect,
+                                   const SkMatrix& matrix);
+
+  // The range of tile coordinates (with exclusive right and bottom edges)
+  // covering the intersection of |tile_space_bounds| and the |device_rect|
+  // drawn with |matrix|.
+  static SkIRect GetTileRange(const SkRect& tile_space_bounds,
+                              const SkMatrix& matrix,
+                              const SkRect& device_rect);
+
+  // Draws the content into a new image. |draw_checkerboard| may be null.
+  static sk_sp<SkImage> RasterizeToImage(
+      const RasterCache::Context& context,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>&
+          draw_checkerboard);
+
+  // Moves the images that finished preparing in the background into their
+  // entries.
+  void AdoptDeferredResults();
+
   void UpdateMetrics();
 
   RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
@@ -268,7 +448,12 @@ class RasterCache {
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  mutable TileMap tiles_;
   bool checkerboard_images_;
+  bool tiled_display_list_caching_ = false;
+  fml::RefPtr<fml::TaskRunner> deferred_task_runner_;
+  ResourceContextProvider resource_context_provider_;
+  mutable DeferredWorkStats deferred_preparation_stats_;
 
   void TraceStatsToTimeline() const;
 
@@ -15,6 +15,8 @@
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -436,6 +438,139 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, TiledCachingOnlyRasterizesVisibleTiles) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetTiledDisplayListCaching(true);
+
+  // 6 by 6 tiles of content, of which 2 by 2 tiles are visible at a time.
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(3000, 3000), DlPaint(DlColor::kBlue()));
+  auto display_list = builder.Build();
+  SkRect cull_rect = SkRect::MakeWH(1000, 1000);
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  auto render_frame = [&](const SkMatrix& matrix) {
+    preroll_state_stack.set_preroll_delegate(cull_rect, matrix);
+    dummy_canvas.SetTransform(matrix);
+    cache.BeginFrame();
+    bool cached = RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item, preroll_context, paint_context, matrix);
+    bool drawn = display_list_item.Draw(paint_context, &dummy_canvas, &paint);
+    cache.EndFrame();
+    return cached && drawn;
+  };
+
+  ASSERT_FALSE(render_frame(SkMatrix::I()));
+  ASSERT_TRUE(display_list_item.is_tiled());
+  ASSERT_EQ(cache.GetTileCount(), 0u);
+
+  ASSERT_TRUE(render_frame(SkMatrix::I()));
+  ASSERT_EQ(cache.GetTileCount(), 4u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 4u);
+
+  // Scrolling by less than a tile exposes one new row of tiles.
+  ASSERT_TRUE(render_frame(SkMatrix::Translate(0, -500)));
+  ASSERT_EQ(cache.GetTileCount(), 6u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 6u);
+
+  // Rows 2 to 4 are visible now. Row 1 is retained as it is adjacent to the
+  // cull rect, while row 0 is evicted.
+  ASSERT_TRUE(render_frame(SkMatrix::Translate(0, -1100)));
+  ASSERT_EQ(cache.GetTileCount(), 8u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 2u);
+
+  // Content that is not larger than a couple of tiles is not tiled.
+  DisplayListRasterCacheItem small_item(GetSampleDisplayList(), SkPoint(), true,
+                                        false);
+  RasterCacheItemPreroll(small_item, preroll_context, SkMatrix::I());
+  ASSERT_FALSE(small_item.is_tiled());
+}
+
+TEST(RasterCache, DeferredPreparationDrawsUncachedUntilImageIsReady) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  fml::Thread io_thread("io");
+  cache.SetDeferredPreparation(io_thread.GetTaskRunner());
+  ASSERT_TRUE(cache.deferred_preparation_enabled());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  auto render_frame = [&]() {
+    cache.BeginFrame();
+    bool cached = RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item, preroll_context, paint_context, matrix);
+    bool drawn = display_list_item.Draw(paint_context, &dummy_canvas, &paint);
+    cache.EndFrame();
+    return cached && drawn;
+  };
+  auto wait_for_io_thread = [&]() {
+    fml::AutoResetWaitableEvent latch;
+    io_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+    latch.Wait();
+  };
+
+  ASSERT_FALSE(render_frame());
+  // The entry is scheduled on the frame where it becomes cacheable and the
+  // item is drawn uncached.
+  ASSERT_FALSE(render_frame());
+  ASSERT_EQ(cache.deferred_preparation_stats().scheduled_count(), 1u);
+  ASSERT_EQ(cache.deferred_preparation_stats().miss_count(), 1u);
+
+  // The image is adopted at the start of the next frame only.
+  wait_for_io_thread();
+  ASSERT_EQ(cache.picture_metrics().total_count(), 0u);
+  ASSERT_TRUE(render_frame());
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+
+  const auto& stats = cache.deferred_preparation_stats();
+  ASSERT_EQ(stats.scheduled_count(), 1u);
+  ASSERT_EQ(stats.completed_count(), 1u);
+  ASSERT_EQ(stats.pending_count(), 0u);
+  ASSERT_EQ(stats.hit_count(), 1u);
+  ASSERT_DOUBLE_EQ(stats.HitRate(), 0.5);
+  ASSERT_GT(stats.MaxLatency(), fml::TimeDelta::Zero());
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
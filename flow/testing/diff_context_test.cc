@@ -25,6 +25,7 @@ Damage DiffContextTest::DiffLayerTree(MockLayerTree& layer_tree,
   dc.PushCullRect(
       SkRect::MakeIWH(layer_tree.size().width(), layer_tree.size().height()));
   layer_tree.root()->Diff(&dc, old_layer_tree.root());
+  last_statistics_ = dc.statistics();
   return dc.ComputeDamage(additional_damage, horizontal_clip_alignment,
                           vertical_clip_alignment);
 }
@@ -45,6 +45,11 @@ class DiffContextTest : public LayerTest {
                        int vertical_alignment = 0,
                        bool use_raster_cache = true);
 
+  // Statistics of the last DiffLayerTree call
+  const DiffContext::Statistics& last_statistics() const {
+    return last_statistics_;
+  }
+
   // Create display list consisting of filled rect with given color; Being able
   // to specify different color is useful to test deep comparison of pictures
   sk_sp<DisplayList> CreateDisplayList(const SkRect& bounds,
@@ -66,6 +71,9 @@ class DiffContextTest : public LayerTest {
       std::initializer_list<std::shared_ptr<Layer>> layers,
       SkAlpha alpha,
       const SkPoint& offset = SkPoint::Make(0, 0));
+
+ private:
+  DiffContext::Statistics last_statistics_;
 };
 
 }  // namespace testing
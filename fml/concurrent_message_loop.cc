@@ -7,23 +7,36 @@
 #include <algorithm>
 
 #include "flutter/fml/thread.h"
+#include "flutter/fml/thread_local.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
+namespace {
+
+// Identifies the worker running on the current thread.
+struct WorkerContext {
+  const ConcurrentMessageLoop* loop;
+  size_t worker_index;
+};
+
+}  // namespace
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<WorkerContext> tls_worker_context;
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -46,69 +59,126 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
-  // Don't just drop tasks on the floor in case of shutdown.
-  if (shutdown_) {
-    FML_DLOG(WARNING)
-        << "Tried to post a task to shutdown concurrent message "
-           "loop. The task will be executed on the callers thread.";
-    lock.unlock();
-    ExecuteTask(task);
-    return;
+  // Tasks posted by a worker go to its own queue. Idle workers steal them
+  // from there, which keeps workers posting bursts of tasks from contending
+  // with each other.
+  size_t worker_index;
+  const WorkerContext* context = tls_worker_context.get();
+  if (context && context->loop == this) {
+    worker_index = context->worker_index;
+  } else {
+    worker_index = next_worker_queue_.fetch_add(1, std::memory_order_relaxed) %
+                   worker_count_;
   }
 
-  tasks_.push(task);
+  {
+    WorkerQueue& queue = *worker_queues_[worker_index];
+    std::unique_lock lock(queue.mutex);
+
+    // Don't just drop tasks on the floor in case of shutdown. Shutdown is set
+    // with all queue mutexes held, so a task pushed below is still taken by
+    // the workers before they exit.
+    if (shutdown_) {
+      FML_DLOG(WARNING)
+          << "Tried to post a task to shutdown concurrent message "
+             "loop. The task will be executed on the callers thread.";
+      lock.unlock();
+      ExecuteTask(task);
+      return;
+    }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+    // The count is incremented first so that it never underflows when the
+    // task is taken by another worker right away.
+    pending_task_count_.fetch_add(1);
+    queue.tasks.push_back(task);
+  }
 
-  tasks_condition_.notify_one();
+  WakeUpIdleWorker();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_worker_context.reset(new WorkerContext{this, worker_index});
+
   while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+    WaitForTasks(worker_index);
 
-    // Shutdown cannot be read with the task mutex unlocked.
     bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
-
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+    fml::closure task = TakeTask(worker_index);
+    std::vector<fml::closure> thread_tasks = GetThreadTasks(worker_index);
+
+    if (task || !thread_tasks.empty()) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+      // Execute the primary task we woke up for.
+      if (task) {
+        ExecuteTask(task);
+      }
+
+      // Execute any thread tasks.
+      for (const auto& thread_task : thread_tasks) {
+        ExecuteTask(thread_task);
+      }
     }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    // No tasks are added after shutdown, so the worker exits once it finds
+    // none left to take.
+    if (shutdown_now && !task) {
+      break;
     }
+  }
+}
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+void ConcurrentMessageLoop::WaitForTasks(size_t worker_index) {
+  auto has_work = [&]() {
+    return pending_task_count_ > 0 || shutdown_ || HasThreadTasks(worker_index);
+  };
+  if (has_work()) {
+    return;
+  }
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
-    }
+  std::unique_lock lock(idle_mutex_);
+  // Posting threads check the idle count after publishing their task, so
+  // either the task is seen here or the poster notifies this worker.
+  idle_worker_count_.fetch_add(1);
+  idle_condition_.wait(lock, has_work);
+  idle_worker_count_.fetch_sub(1);
+}
+
+void ConcurrentMessageLoop::WakeUpIdleWorker() {
+  if (idle_worker_count_ == 0) {
+    return;
+  }
+  {
+    // Ensures that a worker about to sleep is either waiting on the condition
+    // or still going to see the new task.
+    std::scoped_lock lock(idle_mutex_);
+  }
+  idle_condition_.notify_one();
+}
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+fml::closure ConcurrentMessageLoop::TakeTask(size_t worker_index) {
+  fml::closure task;
+  {
+    WorkerQueue& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
     }
+  }
 
-    if (shutdown_now) {
-      break;
+  for (size_t i = 1; !task && i < worker_count_; ++i) {
+    WorkerQueue& victim = *worker_queues_[(worker_index + i) % worker_count_];
+    std::scoped_lock lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
     }
   }
+
+  if (task) {
+    pending_task_count_.fetch_sub(1);
+  }
+  return task;
 }
 
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
@@ -116,9 +186,14 @@ void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
+  std::scoped_lock lock(idle_mutex_);
+  std::vector<std::unique_lock<std::mutex>> queue_locks;
+  queue_locks.reserve(worker_queues_.size());
+  for (const auto& queue : worker_queues_) {
+    queue_locks.emplace_back(queue->mutex);
+  }
   shutdown_ = true;
-  tasks_condition_.notify_all();
+  idle_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -126,23 +201,27 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& queue : worker_queues_) {
+    std::scoped_lock lock(queue->mutex);
+    queue->thread_tasks.emplace_back(task);
   }
-  tasks_condition_.notify_all();
+
+  std::scoped_lock lock(idle_mutex_);
+  idle_condition_.notify_all();
 }
 
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
+bool ConcurrentMessageLoop::HasThreadTasks(size_t worker_index) {
+  WorkerQueue& queue = *worker_queues_[worker_index];
+  std::scoped_lock lock(queue.mutex);
+  return !queue.thread_tasks.empty();
 }
 
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
+std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasks(
+    size_t worker_index) {
+  WorkerQueue& queue = *worker_queues_[worker_index];
   std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
+  std::scoped_lock lock(queue.mutex);
+  std::swap(pending_tasks, queue.thread_tasks);
   return pending_tasks;
 }
 
@@ -168,14 +247,29 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
-bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
+bool ConcurrentTaskRunner::RunPendingTaskOnWorker() {
+  if (auto loop = weak_loop_.lock()) {
+    return loop->RunPendingTaskOnWorker();
   }
   return false;
 }
 
+bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
+  const WorkerContext* context = tls_worker_context.get();
+  return context && context->loop == this;
+}
+
+bool ConcurrentMessageLoop::RunPendingTaskOnWorker() {
+  const WorkerContext* context = tls_worker_context.get();
+  if (!context || context->loop != this) {
+    return false;
+  }
+  fml::closure task = TakeTask(context->worker_index);
+  if (!task) {
+    return false;
+  }
+  ExecuteTask(task);
+  return true;
+}
+
 }  // namespace fml
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -36,6 +39,13 @@ class ConcurrentMessageLoop
 
   bool RunsTasksOnCurrentThread();
 
+  // Runs one of the pending tasks on the calling thread, which must be one of
+  // the workers. Tasks that wait for the result of other tasks of this loop
+  // call this while waiting, so that they don't block a worker while the
+  // task they wait for is queued behind them. Returns false if there was no
+  // pending task or the calling thread is not a worker of this loop.
+  bool RunPendingTaskOnWorker();
+
  protected:
   explicit ConcurrentMessageLoop(size_t worker_count);
   virtual void ExecuteTask(const fml::closure& task);
@@ -43,22 +53,42 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  // The tasks of a single worker. The worker takes tasks from the front of
+  // its own queue and steals tasks from the back of the queues of other
+  // workers once its own queue is empty.
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+    // Tasks posted via |PostTaskToAllWorkers| that may not be stolen.
+    std::vector<fml::closure> thread_tasks;
+  };
+
   size_t worker_count_ = 0;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
-
-  void WorkerMain();
+  // Used to spread tasks posted from outside of the workers.
+  std::atomic_size_t next_worker_queue_ = 0;
+  // The number of tasks in all worker queues, not counting thread tasks.
+  std::atomic_size_t pending_task_count_ = 0;
+  std::atomic_size_t idle_worker_count_ = 0;
+  // Only guards idle workers going to sleep.
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
+  std::atomic_bool shutdown_ = false;
+
+  void WorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  void WaitForTasks(size_t worker_index);
+
+  void WakeUpIdleWorker();
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  fml::closure TakeTask(size_t worker_index);
+
+  bool HasThreadTasks(size_t worker_index);
+
+  std::vector<fml::closure> GetThreadTasks(size_t worker_index);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -71,6 +101,9 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  // See |ConcurrentMessageLoop::RunPendingTaskOnWorker|.
+  bool RunPendingTaskOnWorker();
+
  private:
   friend ConcurrentMessageLoop;
 
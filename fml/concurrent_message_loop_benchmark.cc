@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr size_t kFanOutTaskCount = 1000;
+
+// Spins for a short while to stand in for a small unit of work such as
+// tessellating a path.
+static void DoWork() {
+  std::atomic_size_t counter = 0;
+  for (size_t i = 0; i < 200; i++) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// Posts a burst of tasks from a thread outside of the loop and waits for
+// all of them to complete.
+static void BM_ConcurrentMessageLoopFanOutFanIn(
+    benchmark::State& state) {  // NOLINT
+  auto loop = fml::ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    CountDownLatch latch(kFanOutTaskCount);
+    for (size_t i = 0; i < kFanOutTaskCount; i++) {
+      task_runner->PostTask([&latch]() {
+        DoWork();
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kFanOutTaskCount);
+}
+
+// Posts a burst of tasks from a worker, like image decoding or shader
+// compilation tasks that split their work further do, and waits for all
+// of them to complete.
+static void BM_ConcurrentMessageLoopNestedFanOutFanIn(
+    benchmark::State& state) {  // NOLINT
+  auto loop = fml::ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+  while (state.KeepRunning()) {
+    // The posting task counts down as well so that the loop is never
+    // released by a worker that is still posting tasks.
+    CountDownLatch latch(kFanOutTaskCount + 1);
+    task_runner->PostTask([&latch, task_runner]() {
+      for (size_t i = 0; i < kFanOutTaskCount; i++) {
+        task_runner->PostTask([&latch]() {
+          DoWork();
+          latch.CountDown();
+        });
+      }
+      latch.CountDown();
+    });
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kFanOutTaskCount);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopFanOutFanIn)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->UseRealTime();
+BENCHMARK(BM_ConcurrentMessageLoopNestedFanOutFanIn)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/frame_counters.h"
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+FrameCounters::PaddedCounter FrameCounters::counters_[kCount];
+
+const char* FrameCounters::GetName(Counter counter) {
+  switch (counter) {
+    case kLayersPrerolled:
+      return "layersPrerolled";
+    case kRasterCacheHits:
+      return "rasterCacheHits";
+    case kRasterCacheMisses:
+      return "rasterCacheMisses";
+    case kDisplayListOpsDispatched:
+      return "displayListOpsDispatched";
+    case kPipelineCompilations:
+      return "pipelineCompilations";
+    case kTextureUploads:
+      return "textureUploads";
+    case kBytesAllocated:
+      return "bytesAllocated";
+    case kCount:
+      break;
+  }
+  FML_UNREACHABLE();
+}
+
+FrameCounters::Snapshot FrameCounters::GetSnapshot() {
+  Snapshot snapshot;
+  for (size_t i = 0; i < kCount; i++) {
+    snapshot[i] = counters_[i].value.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+FrameCounters::Snapshot FrameCounters::Difference(const Snapshot& begin,
+                                                  const Snapshot& end) {
+  Snapshot difference;
+  for (size_t i = 0; i < kCount; i++) {
+    difference[i] = end[i] - begin[i];
+  }
+  return difference;
+}
+
+}  // namespace fml
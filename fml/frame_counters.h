@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FRAME_COUNTERS_H_
+#define FLUTTER_FML_FRAME_COUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// Process-wide counters of the work done to produce frames.
+///
+/// Counters only ever grow. The work attributed to a frame is the difference
+/// between the snapshots taken when its rasterization starts and ends. Adding
+/// to a counter is a single relaxed atomic add, so counters may be updated on
+/// hot paths and from any thread.
+///
+/// Counters are not tracked per thread or per engine. The difference for a
+/// frame therefore also includes work done concurrently by other threads,
+/// such as the IO thread, and by other engines in the same process.
+class FrameCounters {
+ public:
+  enum Counter : size_t {
+    kLayersPrerolled,
+    kRasterCacheHits,
+    kRasterCacheMisses,
+    kDisplayListOpsDispatched,
+    kPipelineCompilations,
+    kTextureUploads,
+    // The size of the textures and device private buffers created. Host
+    // visible buffers are left out, as those are mostly recycled per frame.
+    kBytesAllocated,
+    kCount,
+  };
+
+  using Snapshot = std::array<uint64_t, kCount>;
+
+  /// The name of the counter, as used in service protocol responses.
+  static const char* GetName(Counter counter);
+
+  static void Add(Counter counter, uint64_t value = 1) {
+    counters_[counter].value.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  /// Returns the current values of all counters.
+  static Snapshot GetSnapshot();
+
+  /// Returns how much each counter grew from |begin| to |end|.
+  static Snapshot Difference(const Snapshot& begin, const Snapshot& end);
+
+ private:
+  // Counters are updated from different threads, keep them on separate cache
+  // lines.
+  struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value = {0};
+  };
+
+  static PaddedCounter counters_[kCount];
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(FrameCounters);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FRAME_COUNTERS_H_
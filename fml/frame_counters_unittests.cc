@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/frame_counters.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(FrameCountersTest, DifferenceReportsAddedValues) {
+  auto begin = FrameCounters::GetSnapshot();
+  FrameCounters::Add(FrameCounters::kLayersPrerolled);
+  FrameCounters::Add(FrameCounters::kBytesAllocated, 1024);
+  FrameCounters::Add(FrameCounters::kBytesAllocated, 1024);
+  auto end = FrameCounters::GetSnapshot();
+
+  auto difference = FrameCounters::Difference(begin, end);
+  EXPECT_EQ(difference[FrameCounters::kLayersPrerolled], 1u);
+  EXPECT_EQ(difference[FrameCounters::kBytesAllocated], 2048u);
+  EXPECT_EQ(difference[FrameCounters::kTextureUploads], 0u);
+}
+
+TEST(FrameCountersTest, CanAddFromMultipleThreads) {
+  auto begin = FrameCounters::GetSnapshot();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; j++) {
+        FrameCounters::Add(FrameCounters::kRasterCacheHits);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto difference =
+      FrameCounters::Difference(begin, FrameCounters::GetSnapshot());
+  EXPECT_EQ(difference[FrameCounters::kRasterCacheHits], 4000u);
+}
+
+TEST(FrameCountersTest, CountersHaveDistinctNames) {
+  for (size_t i = 0; i < FrameCounters::kCount; i++) {
+    for (size_t j = i + 1; j < FrameCounters::kCount; j++) {
+      EXPECT_NE(
+          std::string(FrameCounters::GetName(FrameCounters::Counter(i))),
+          std::string(FrameCounters::GetName(FrameCounters::Counter(j))));
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -7,7 +7,9 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <climits>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
 
@@ -30,13 +32,168 @@ class TaskSourceGradeHolder {
   explicit TaskSourceGradeHolder(TaskSourceGrade task_source_grade_arg)
       : task_source_grade(task_source_grade_arg) {}
 };
+
+// The value of |TaskQueueEntry::next_target_time| if the task source has no
+// runnable tasks.
+constexpr int64_t kNoPendingTasks = std::numeric_limits<int64_t>::min();
+
+// Task queue entries are looked up and used without a lock that is shared
+// between task queues, so disposed entries are reclaimed based on epochs:
+// threads publish the global epoch while they use entries, and an entry
+// retired at epoch E is deleted once every thread is either outside of such
+// a section or has published an epoch of at least E.
+constexpr uint64_t kQuiescent = 0;
+
+std::atomic<uint64_t> global_epoch = 1;
+
+struct ThreadEpoch {
+  std::atomic<uint64_t> epoch{kQuiescent};
+  std::atomic_bool in_use{true};
+  // Immutable once the record is published.
+  ThreadEpoch* next = nullptr;
+  // The nesting depth of epoch guards. Only used by the owning thread.
+  size_t depth = 0;
+};
+
+// Records are reused by later threads and never freed.
+std::atomic<ThreadEpoch*> thread_epochs = nullptr;
+
+class ThreadEpochHolder {
+ public:
+  explicit ThreadEpochHolder(ThreadEpoch* record) : record(record) {}
+
+  ~ThreadEpochHolder() { record->in_use.store(false); }
+
+  ThreadEpoch* const record;
+};
+
 }  // namespace
 
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadEpochHolder> tls_thread_epoch;
+
+namespace {
+
+ThreadEpoch& GetThreadEpoch() {
+  if (tls_thread_epoch.get() == nullptr) {
+    ThreadEpoch* record = nullptr;
+    for (ThreadEpoch* it = thread_epochs.load(); it; it = it->next) {
+      bool in_use = false;
+      if (it->in_use.compare_exchange_strong(in_use, true)) {
+        record = it;
+        break;
+      }
+    }
+    if (!record) {
+      record = new ThreadEpoch();
+      record->next = thread_epochs.load();
+      while (!thread_epochs.compare_exchange_weak(record->next, record)) {
+      }
+    }
+    tls_thread_epoch.reset(new ThreadEpochHolder(record));
+  }
+  return *tls_thread_epoch.get()->record;
+}
+
+// Keeps the task queue entries looked up on the current thread alive.
+class EpochGuard {
+ public:
+  EpochGuard() : record_(GetThreadEpoch()) {
+    if (record_.depth++ == 0) {
+      record_.epoch.store(global_epoch.load());
+    }
+  }
+
+  ~EpochGuard() {
+    if (--record_.depth == 0) {
+      record_.epoch.store(kQuiescent);
+    }
+  }
+
+ private:
+  ThreadEpoch& record_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EpochGuard);
+};
+
+int64_t ToTicks(fml::TimePoint time) {
+  // Avoid a collision with kNoPendingTasks for tasks at TimePoint::Min().
+  return std::max(time.ToEpochDelta().ToNanoseconds(), kNoPendingTasks + 1);
+}
+
+void LowerNextTargetTime(TaskQueueEntry& entry, const TaskInbox& inbox) {
+  if (inbox.IsEmpty()) {
+    return;
+  }
+  const int64_t ticks = ToTicks(inbox.GetEarliestTargetTime());
+  const int64_t next_target_time = entry.next_target_time.load();
+  if (next_target_time == kNoPendingTasks || ticks < next_target_time) {
+    entry.next_target_time.store(ticks);
+  }
+}
+
+// Moves the registered tasks of the entry into its task source and publishes
+// the state of the task source. Requires |entry.mutex|.
+void UpdateTaskSource(TaskQueueEntry& entry) {
+  // Threads computing a wake up time look at the inboxes before they look at
+  // |next_target_time|. Lowering it before the tasks are taken out of the
+  // inboxes ensures that they cannot miss tasks that are being moved.
+  LowerNextTargetTime(entry, entry.primary_inbox);
+  if (!entry.secondary_paused.load()) {
+    LowerNextTargetTime(entry, entry.secondary_inbox);
+  }
+  entry.primary_inbox.MoveTo(*entry.task_source);
+  entry.secondary_inbox.MoveTo(*entry.task_source);
+  entry.secondary_paused.store(entry.task_source->IsSecondaryPaused());
+  entry.next_target_time.store(
+      entry.task_source->IsEmpty()
+          ? kNoPendingTasks
+          : ToTicks(entry.task_source->Top().task.GetTargetTime()));
+}
+
+}  // namespace
+
+/// Locks the mutex of a task queue and then the mutexes of the task queues
+/// it owns, and updates their task sources.
+class MessageLoopTaskQueues::GroupLock {
+ public:
+  GroupLock(const MessageLoopTaskQueues& queues, TaskQueueEntry& owner) {
+    owner.mutex.lock();
+    entries_.push_back(&owner);
+    for (TaskQueueId subsumed : owner.owner_of) {
+      TaskQueueEntry& entry = queues.GetEntryChecked(subsumed);
+      entry.mutex.lock();
+      entries_.push_back(&entry);
+    }
+    for (TaskQueueEntry* entry : entries_) {
+      UpdateTaskSource(*entry);
+    }
+  }
+
+  ~GroupLock() {
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+      (*it)->mutex.unlock();
+    }
+  }
+
+  TaskQueueEntry& owner() const { return *entries_.front(); }
+
+  /// The owner followed by the task queues it owns.
+  const std::vector<TaskQueueEntry*>& entries() const { return entries_; }
+
+ private:
+  std::vector<TaskQueueEntry*> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GroupLock);
+};
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
-    : subsumed_by(_kUnmerged), created_for(created_for_arg) {
+    : next_target_time(kNoPendingTasks),
+      secondary_paused(false),
+      subsumed_by(_kUnmerged),
+      created_for(created_for_arg) {
   wakeable = NULL;
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
@@ -49,9 +206,29 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
   std::lock_guard guard(queue_mutex_);
-  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
-  ++task_queue_id_counter_;
-  queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  ReclaimEntries();
+  TaskQueueId loop_id = _kUnmerged;
+  if (!free_queue_ids_.empty()) {
+    // Give the reused slot a new id, so that the id of the disposed queue
+    // does not refer to the new one.
+    const TaskQueueId freed_id = free_queue_ids_.back();
+    free_queue_ids_.pop_back();
+    loop_id = TaskQueueId(freed_id + kMaxEntries);
+    if (loop_id < freed_id || loop_id == _kUnmerged) {
+      loop_id = TaskQueueId(freed_id % kMaxEntries);
+    }
+  } else {
+    FML_CHECK(task_queue_id_counter_ < kMaxEntries) << "Too many task queues.";
+    loop_id = TaskQueueId(task_queue_id_counter_);
+    ++task_queue_id_counter_;
+  }
+  const size_t segment_index = (loop_id % kMaxEntries) / kEntriesPerSegment;
+  auto& segment = entry_segments_[segment_index];
+  if (!segment.load()) {
+    segment.store(new EntrySegment());
+  }
+  segment.load()->entries[loop_id % kEntriesPerSegment].store(
+      new TaskQueueEntry(loop_id));
   return loop_id;
 }
 
@@ -63,26 +240,83 @@ MessageLoopTaskQueues::MessageLoopTaskQueues()
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
+TaskQueueEntry* MessageLoopTaskQueues::GetEntry(TaskQueueId queue_id) const {
+  const size_t slot_index = queue_id % kMaxEntries;
+  EntrySegment* segment =
+      entry_segments_[slot_index / kEntriesPerSegment].load();
+  if (!segment) {
+    return nullptr;
+  }
+  TaskQueueEntry* entry =
+      segment->entries[slot_index % kEntriesPerSegment].load();
+  if (!entry || entry->created_for != queue_id) {
+    return nullptr;
+  }
+  return entry;
+}
+
+TaskQueueEntry& MessageLoopTaskQueues::GetEntryChecked(
+    TaskQueueId queue_id) const {
+  TaskQueueEntry* entry = GetEntry(queue_id);
+  FML_CHECK(entry) << "Unknown task queue " << queue_id;
+  return *entry;
+}
+
+void MessageLoopTaskQueues::RetireEntry(TaskQueueId queue_id) {
+  const size_t slot_index = queue_id % kMaxEntries;
+  auto& slot = entry_segments_[slot_index / kEntriesPerSegment]
+                   .load()
+                   ->entries[slot_index % kEntriesPerSegment];
+  FML_DCHECK(slot.load() && slot.load()->created_for == queue_id);
+  std::unique_ptr<TaskQueueEntry> entry(slot.exchange(nullptr));
+  free_queue_ids_.push_back(queue_id);
+  // Threads that enter an epoch guard from now on cannot see the entry.
+  const uint64_t epoch = global_epoch.fetch_add(1) + 1;
+  retired_entries_.emplace_back(epoch, std::move(entry));
+}
+
+void MessageLoopTaskQueues::ReclaimEntries() {
+  if (retired_entries_.empty()) {
+    return;
+  }
+  uint64_t oldest_epoch = std::numeric_limits<uint64_t>::max();
+  for (ThreadEpoch* it = thread_epochs.load(); it; it = it->next) {
+    const uint64_t epoch = it->epoch.load();
+    if (epoch != kQuiescent) {
+      oldest_epoch = std::min(oldest_epoch, epoch);
+    }
+  }
+  retired_entries_.erase(
+      std::remove_if(retired_entries_.begin(), retired_entries_.end(),
+                     [oldest_epoch](const auto& retired) {
+                       return retired.first <= oldest_epoch;
+                     }),
+      retired_entries_.end());
+}
+
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
   std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::set<TaskQueueId> subsumed_set;
+  {
+    std::lock_guard entry_lock(queue_entry.mutex);
+    FML_DCHECK(queue_entry.subsumed_by == _kUnmerged);
+    subsumed_set = queue_entry.owner_of;
+  }
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.erase(subsumed);
+    RetireEntry(subsumed);
   }
-  // Erase owner queue_id at last to avoid &subsumed_set from being invalid
-  queue_entries_.erase(queue_id);
+  RetireEntry(queue_id);
+  ReclaimEntries();
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
-  queue_entry->task_source->ShutDown();
-  for (auto& subsumed : subsumed_set) {
-    queue_entries_.at(subsumed)->task_source->ShutDown();
+  EpochGuard epoch_guard;
+  GroupLock lock(*this, GetEntryChecked(queue_id));
+  FML_DCHECK(lock.owner().subsumed_by == _kUnmerged);
+  for (TaskQueueEntry* entry : lock.entries()) {
+    entry->task_source->ShutDown();
+    UpdateTaskSource(*entry);
   }
 }
 
@@ -95,73 +329,110 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
-  TaskQueueId loop_to_wake = queue_id;
-  if (queue_entry->subsumed_by != _kUnmerged) {
-    loop_to_wake = queue_entry->subsumed_by;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  const size_t order = order_.fetch_add(1, std::memory_order_relaxed);
+  const DelayedTask delayed_task(order, task, target_time, task_source_grade);
+  if (task_source_grade == TaskSourceGrade::kDartMicroTasks) {
+    queue_entry.secondary_inbox.Push(delayed_task);
+  } else {
+    queue_entry.primary_inbox.Push(delayed_task);
   }
 
-  // This can happen when the secondary tasks are paused.
-  if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  // If the queue is merged or unmerged concurrently, |Merge| and |Unmerge|
+  // are guaranteed to see the task and wake up the right loop.
+  const size_t loop_to_wake = queue_entry.subsumed_by.load();
+  if (loop_to_wake == _kUnmerged) {
+    WakeUp(queue_entry);
+  } else {
+    WakeUp(GetEntryChecked(TaskQueueId(loop_to_wake)));
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  return HasPendingTasksUnlocked(queue_id);
+  EpochGuard epoch_guard;
+  GroupLock lock(*this, GetEntryChecked(queue_id));
+  return HasPendingTasksLocked(lock);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
-  if (!HasPendingTasksUnlocked(queue_id)) {
+  EpochGuard epoch_guard;
+  GroupLock lock(*this, GetEntryChecked(queue_id));
+  if (!HasPendingTasksLocked(lock)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskLocked(lock);
 
-  if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
-  } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
-  }
+  WakeUp(lock.owner());
 
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
   fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
   const auto task_source_grade = top.task.GetTaskSourceGrade();
+  TaskQueueEntry& top_entry = GetEntryChecked(top.task_queue_id);
+  top_entry.task_source->PopTask(task_source_grade);
+  UpdateTaskSource(top_entry);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
 
-void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
-                                           fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+void MessageLoopTaskQueues::WakeUp(TaskQueueEntry& entry) const {
+  // Subsumed queues are serviced by the loop of their owner.
+  if (entry.subsumed_by != _kUnmerged) {
+    return;
+  }
+  std::lock_guard wake_lock(entry.wake_mutex);
+  if (!entry.wakeable) {
+    return;
+  }
+  std::optional<fml::TimePoint> wake_time = GetNextWakeTime(entry);
+  if (wake_time.has_value()) {
+    entry.wakeable->WakeUp(wake_time.value());
+  }
+}
+
+std::optional<fml::TimePoint> MessageLoopTaskQueues::GetNextWakeTime(
+    const TaskQueueEntry& entry) const {
+  std::optional<fml::TimePoint> wake_time;
+  auto update_wake_time = [&wake_time](fml::TimePoint time) {
+    if (!wake_time.has_value() || time < wake_time.value()) {
+      wake_time = time;
+    }
+  };
+  // The inboxes must be looked at first, see |UpdateTaskSource|.
+  auto visit = [&update_wake_time](const TaskQueueEntry& visited) {
+    if (!visited.primary_inbox.IsEmpty()) {
+      update_wake_time(visited.primary_inbox.GetEarliestTargetTime());
+    }
+    if (!visited.secondary_paused.load() &&
+        !visited.secondary_inbox.IsEmpty()) {
+      update_wake_time(visited.secondary_inbox.GetEarliestTargetTime());
+    }
+    const int64_t next_target_time = visited.next_target_time.load();
+    if (next_target_time != kNoPendingTasks) {
+      update_wake_time(fml::TimePoint::FromTicks(next_target_time));
+    }
+  };
+
+  visit(entry);
+  for (TaskQueueId subsumed : entry.owner_of) {
+    visit(GetEntryChecked(subsumed));
   }
+  return wake_time;
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  if (queue_entry->subsumed_by != _kUnmerged) {
+  EpochGuard epoch_guard;
+  GroupLock lock(*this, GetEntryChecked(queue_id));
+  if (lock.owner().subsumed_by != _kUnmerged) {
     return 0;
   }
 
   size_t total_tasks = 0;
-  total_tasks += queue_entry->task_source->GetNumPendingTasks();
-
-  auto& subsumed_set = queue_entry->owner_of;
-  for (auto& subsumed : subsumed_set) {
-    const auto& subsumed_entry = queue_entries_.at(subsumed);
-    total_tasks += subsumed_entry->task_source->GetNumPendingTasks();
+  for (const TaskQueueEntry* entry : lock.entries()) {
+    total_tasks += entry->task_source->GetNumPendingTasks();
   }
   return total_tasks;
 }
@@ -169,33 +440,33 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::lock_guard entry_lock(queue_entry.mutex);
+  queue_entry.task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::lock_guard entry_lock(queue_entry.mutex);
+  queue_entry.task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  EpochGuard epoch_guard;
+  GroupLock lock(*this, GetEntryChecked(queue_id));
   std::vector<fml::closure> observers;
 
-  if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
+  if (lock.owner().subsumed_by != _kUnmerged) {
     return observers;
   }
 
-  for (const auto& observer : queue_entries_.at(queue_id)->task_observers) {
-    observers.push_back(observer.second);
-  }
-
-  auto& subsumed_set = queue_entries_.at(queue_id)->owner_of;
-  for (auto& subsumed : subsumed_set) {
-    for (const auto& observer : queue_entries_.at(subsumed)->task_observers) {
+  for (const TaskQueueEntry* entry : lock.entries()) {
+    for (const auto& observer : entry->task_observers) {
       observers.push_back(observer.second);
     }
   }
@@ -205,193 +476,190 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::scoped_lock lock(queue_entry.mutex, queue_entry.wake_mutex);
+  FML_CHECK(!queue_entry.wakeable) << "Wakeable can only be set once.";
+  queue_entry.wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
-  auto& owner_entry = queue_entries_.at(owner);
-  auto& subsumed_entry = queue_entries_.at(subsumed);
-  auto& subsumed_set = owner_entry->owner_of;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& owner_entry = GetEntryChecked(owner);
+  TaskQueueEntry& subsumed_entry = GetEntryChecked(subsumed);
+  std::scoped_lock lock(owner_entry.mutex, subsumed_entry.mutex);
+  auto& subsumed_set = owner_entry.owner_of;
   if (subsumed_set.find(subsumed) != subsumed_set.end()) {
     return true;
   }
 
-  // Won't check owner_entry->owner_of, because it may contains items when
+  // Won't check owner_entry.owner_of, because it may contains items when
   // merged with other different queues.
 
-  // Ensure owner_entry->subsumed_by being _kUnmerged
-  if (owner_entry->subsumed_by != _kUnmerged) {
+  // Ensure owner_entry.subsumed_by being _kUnmerged
+  if (owner_entry.subsumed_by != _kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: owner_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
-                     << ", owner->subsumed_by=" << owner_entry->subsumed_by;
+                     << ", owner->subsumed_by="
+                     << owner_entry.subsumed_by.load();
     return false;
   }
-  // Ensure subsumed_entry->owner_of being empty
-  if (!subsumed_entry->owner_of.empty()) {
+  // Ensure subsumed_entry.owner_of being empty
+  if (!subsumed_entry.owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread merging failed: subsumed_entry already owns others, owner="
         << owner << ", subsumed=" << subsumed
-        << ", subsumed->owner_of.size()=" << subsumed_entry->owner_of.size();
+        << ", subsumed->owner_of.size()=" << subsumed_entry.owner_of.size();
     return false;
   }
-  // Ensure subsumed_entry->subsumed_by being _kUnmerged
-  if (subsumed_entry->subsumed_by != _kUnmerged) {
+  // Ensure subsumed_entry.subsumed_by being _kUnmerged
+  if (subsumed_entry.subsumed_by != _kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: subsumed_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
                      << ", subsumed->subsumed_by="
-                     << subsumed_entry->subsumed_by;
+                     << subsumed_entry.subsumed_by.load();
     return false;
   }
-  // All checking is OK, set merged state.
-  owner_entry->owner_of.insert(subsumed);
-  subsumed_entry->subsumed_by = owner;
-
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+  // All checking is OK, set merged state. The owner takes over waking up for
+  // the tasks of the subsumed queue before tasks are registered with it.
+  {
+    std::lock_guard wake_lock(owner_entry.wake_mutex);
+    owner_entry.owner_of.insert(subsumed);
   }
+  subsumed_entry.subsumed_by = owner;
+
+  WakeUp(owner_entry);
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& owner_entry = queue_entries_.at(owner);
-  if (owner_entry->owner_of.empty()) {
+  EpochGuard epoch_guard;
+  TaskQueueEntry& owner_entry = GetEntryChecked(owner);
+  TaskQueueEntry& subsumed_entry = GetEntryChecked(subsumed);
+  std::unique_lock owner_lock(owner_entry.mutex, std::defer_lock);
+  std::unique_lock subsumed_lock(subsumed_entry.mutex, std::defer_lock);
+  if (owner == subsumed) {
+    owner_lock.lock();
+  } else {
+    std::lock(owner_lock, subsumed_lock);
+  }
+  if (owner_entry.owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
         << owner << ", subsumed=" << subsumed;
     return false;
   }
-  if (owner_entry->subsumed_by != _kUnmerged) {
+  if (owner_entry.subsumed_by != _kUnmerged) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry was subsumed by others, owner="
         << owner << ", subsumed=" << subsumed
-        << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
+        << ", owner_entry->subsumed_by=" << owner_entry.subsumed_by.load();
     return false;
   }
-  if (queue_entries_.at(subsumed)->subsumed_by == _kUnmerged) {
+  if (subsumed_entry.subsumed_by == _kUnmerged) {
     FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed;
     return false;
   }
-  if (owner_entry->owner_of.find(subsumed) == owner_entry->owner_of.end()) {
+  if (owner_entry.owner_of.find(subsumed) == owner_entry.owner_of.end()) {
     FML_LOG(WARNING) << "Thread unmerging failed: owner_entry didn't own the "
                         "given subsumed queue id, owner="
                      << owner << ", subsumed=" << subsumed;
     return false;
   }
 
-  queue_entries_.at(subsumed)->subsumed_by = _kUnmerged;
-  owner_entry->owner_of.erase(subsumed);
-
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+  subsumed_entry.subsumed_by = _kUnmerged;
+  {
+    std::lock_guard wake_lock(owner_entry.wake_mutex);
+    owner_entry.owner_of.erase(subsumed);
   }
 
-  if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
-  }
+  WakeUp(owner_entry);
+  WakeUp(subsumed_entry);
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
-  auto& subsumed_set = queue_entries_.at(owner)->owner_of;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& owner_entry = GetEntryChecked(owner);
+  std::lock_guard entry_lock(owner_entry.mutex);
+  auto& subsumed_set = owner_entry.owner_of;
   return subsumed_set.find(subsumed) != subsumed_set.end();
 }
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
-  return queue_entries_.at(owner)->owner_of;
+  EpochGuard epoch_guard;
+  TaskQueueEntry& owner_entry = GetEntryChecked(owner);
+  std::lock_guard entry_lock(owner_entry.mutex);
+  return owner_entry.owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::lock_guard entry_lock(queue_entry.mutex);
+  queue_entry.task_source->PauseSecondary();
+  UpdateTaskSource(queue_entry);
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->ResumeSecondary();
+  EpochGuard epoch_guard;
+  TaskQueueEntry& queue_entry = GetEntryChecked(queue_id);
+  std::lock_guard entry_lock(queue_entry.mutex);
+  queue_entry.task_source->ResumeSecondary();
+  UpdateTaskSource(queue_entry);
   // Schedule a wake as needed.
-  if (HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
-  }
+  WakeUp(queue_entry);
 }
 
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
-bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
-    TaskQueueId queue_id) const {
-  const auto& entry = queue_entries_.at(queue_id);
-  bool is_subsumed = entry->subsumed_by != _kUnmerged;
-  if (is_subsumed) {
+bool MessageLoopTaskQueues::HasPendingTasksLocked(const GroupLock& lock) const {
+  if (lock.owner().subsumed_by != _kUnmerged) {
     return false;
   }
-
-  if (!entry->task_source->IsEmpty()) {
-    return true;
-  }
-
-  auto& subsumed_set = entry->owner_of;
-  return std::any_of(
-      subsumed_set.begin(), subsumed_set.end(), [&](const auto& subsumed) {
-        return !queue_entries_.at(subsumed)->task_source->IsEmpty();
-      });
-}
-
-fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
-    TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
+  const auto& entries = lock.entries();
+  return std::any_of(entries.begin(), entries.end(), [](const auto* entry) {
+    return !entry->task_source->IsEmpty();
+  });
 }
 
-TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
-  FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
-  if (entry->owner_of.empty()) {
-    FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskLocked(
+    const GroupLock& lock) const {
+  FML_DCHECK(HasPendingTasksLocked(lock));
+  const auto& entries = lock.entries();
+  if (entries.size() == 1u) {
+    FML_CHECK(!entries.front()->task_source->IsEmpty());
+    return entries.front()->task_source->Top();
   }
 
   // Use optional for the memory of TopTask object.
   std::optional<TaskSource::TopTask> top_task;
 
-  std::function<void(const TaskSource*)> top_task_updater =
-      [&top_task](const TaskSource* source) {
-        if (source && !source->IsEmpty()) {
-          TaskSource::TopTask other_task = source->Top();
-          if (!top_task.has_value() || top_task->task > other_task.task) {
-            top_task.emplace(other_task);
-          }
-        }
-      };
-
-  TaskSource* owner_tasks = entry->task_source.get();
-  top_task_updater(owner_tasks);
-
-  for (TaskQueueId subsumed : entry->owner_of) {
-    TaskSource* subsumed_tasks = queue_entries_.at(subsumed)->task_source.get();
-    top_task_updater(subsumed_tasks);
-  }
-  // At least one task at the top because PeekNextTaskUnlocked() is called after
-  // HasPendingTasksUnlocked()
+  for (const TaskQueueEntry* entry : entries) {
+    const TaskSource* source = entry->task_source.get();
+    if (source && !source->IsEmpty()) {
+      TaskSource::TopTask other_task = source->Top();
+      if (!top_task.has_value() || top_task->task > other_task.task) {
+        top_task.emplace(other_task);
+      }
+    }
+  }
+  // At least one task at the top because PeekNextTaskLocked() is called after
+  // HasPendingTasksLocked()
   FML_CHECK(top_task.has_value());
   // Covered by FML_CHECK.
   // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
@@ -5,10 +5,14 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -16,6 +20,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_inbox.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
 #include "flutter/fml/wakeable.h"
@@ -29,20 +34,49 @@ static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
 /// this isn't the case when TaskQueues are merged via
 /// \p fml::MessageLoopTaskQueues::Merge.
+///
+/// Registering a task does not acquire any lock that is shared with other
+/// task queues or with the loop running the tasks. The task is pushed onto a
+/// lock-free inbox instead, which the loop moves into the task source the
+/// next time it looks for a task to run.
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
+
+  /// Guards the task source, the observers and the merge state. Registering
+  /// a task does not acquire it.
+  std::mutex mutex;
+
+  /// Serializes the wake ups of the loop servicing this TaskQueue along with
+  /// the reads of |owner_of| used to compute the wake up time. It is the last
+  /// lock acquired by any thread.
+  std::mutex wake_mutex;
+
+  /// Written while holding both |mutex| and |wake_mutex|.
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
 
+  /// Tasks registered since the task source was last updated. Tasks of the
+  /// secondary grade are kept apart so that they do not wake up the loop
+  /// while the secondary source is paused.
+  TaskInbox primary_inbox;
+  TaskInbox secondary_inbox;
+
+  /// The target time of the next task of |task_source| in ticks, and whether
+  /// its secondary source is paused. These are published while holding
+  /// |mutex| so that wake up times can be computed without acquiring it.
+  std::atomic<int64_t> next_target_time;
+  std::atomic_bool secondary_paused;
+
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
-  /// empty, this TaskQueue does not own any other TaskQueues.
+  /// empty, this TaskQueue does not own any other TaskQueues. Written while
+  /// holding both |mutex| and |wake_mutex|.
   std::set<TaskQueueId> owner_of;
 
   /// Identifies the TaskQueue that subsumes this TaskQueue. If it is _kUnmerged
   /// it indicates that this TaskQueue is not owned by any other TaskQueue.
-  TaskQueueId subsumed_by;
+  std::atomic<size_t> subsumed_by;
 
   TaskQueueId created_for;
 
@@ -139,25 +173,66 @@ class MessageLoopTaskQueues {
 
  private:
   class MergedQueuesRunner;
+  class GroupLock;
+
+  static constexpr size_t kEntriesPerSegment = 256;
+  static constexpr size_t kMaxSegments = 4096;
+  // The number of task queues that can exist at the same time. The slot of a
+  // queue in the table is its id modulo this number, the remaining bits of
+  // the id count how often the slot has been reused.
+  static constexpr size_t kMaxEntries = kEntriesPerSegment * kMaxSegments;
+
+  struct EntrySegment {
+    std::array<std::atomic<TaskQueueEntry*>, kEntriesPerSegment> entries = {};
+  };
 
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
-  void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
+  // Returns the entry of the given queue or nullptr if there is none, which
+  // includes queues that were disposed and whose slot was reused. Unless
+  // |queue_mutex_| is held, the entry may only be used within an |EpochGuard|.
+  TaskQueueEntry* GetEntry(TaskQueueId queue_id) const;
+
+  TaskQueueEntry& GetEntryChecked(TaskQueueId queue_id) const;
+
+  // Removes the entry from the table and makes its slot available to new task
+  // queues. It is deleted by |ReclaimEntries| once no thread can still be
+  // using it.
+  void RetireEntry(TaskQueueId queue_id);
+
+  void ReclaimEntries();
+
+  // Wakes up the loop servicing |entry| at the target time of the next task
+  // of the queue or of the queues it owns, if there is any.
+  void WakeUp(TaskQueueEntry& entry) const;
+
+  std::optional<fml::TimePoint> GetNextWakeTime(
+      const TaskQueueEntry& entry) const;
+
+  bool HasPendingTasksLocked(const GroupLock& lock) const;
+
+  TaskSource::TopTask PeekNextTaskLocked(const GroupLock& lock) const;
 
-  bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
+  // Guards the creation and disposal of task queues. Registering and running
+  // tasks, as well as merging and unmerging task queues, does not acquire it.
+  std::mutex queue_mutex_;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  // Task queue entries indexed by their id. Segments are allocated on demand
+  // and never freed, so entries can be looked up without a lock.
+  std::array<std::atomic<EntrySegment*>, kMaxSegments> entry_segments_ = {};
 
-  fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
+  // Disposed entries along with the epoch they were disposed at.
+  std::vector<std::pair<uint64_t, std::unique_ptr<TaskQueueEntry>>>
+      retired_entries_;
 
-  mutable std::mutex queue_mutex_;
-  std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
+  // Ids of disposed task queues, whose slots are reused by new task queues.
+  std::vector<TaskQueueId> free_queue_ids_;
 
   size_t task_queue_id_counter_;
 
-  std::atomic_int order_;
+  std::atomic_size_t order_;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(MessageLoopTaskQueues);
 };
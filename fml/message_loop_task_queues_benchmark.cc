@@ -66,5 +66,78 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Measures registering tasks from |state.range(0)| threads at once, either
+// all with a single task queue or each with a task queue of its own.
+static void RegisterTasksContended(benchmark::State& state,
+                                   bool shared_queue) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_producers = state.range(0);
+  const int num_tasks_per_producer = 1000;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < (shared_queue ? 1 : num_producers); i++) {
+    queue_ids.push_back(task_queues->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    std::vector<std::thread> threads;
+    CountDownLatch producers_ready(num_producers);
+    CountDownLatch start(1);
+    CountDownLatch producers_done(num_producers);
+    for (int i = 0; i < num_producers; i++) {
+      const TaskQueueId queue_id = queue_ids[shared_queue ? 0 : i];
+      threads.emplace_back([&, queue_id]() {
+        producers_ready.CountDown();
+        start.Wait();
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+        }
+        producers_done.CountDown();
+      });
+    }
+    producers_ready.Wait();
+    state.ResumeTiming();
+
+    start.CountDown();
+    producers_done.Wait();
+
+    state.PauseTiming();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& queue_id : queue_ids) {
+      task_queues->DisposeTasks(queue_id);
+    }
+    state.ResumeTiming();
+  }
+
+  for (const auto& queue_id : queue_ids) {
+    task_queues->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+static void BM_RegisterTasksContendedSharedQueue(
+    benchmark::State& state) {  // NOLINT
+  RegisterTasksContended(state, /*shared_queue=*/true);
+}
+
+static void BM_RegisterTasksContendedQueuePerProducer(
+    benchmark::State& state) {  // NOLINT
+  RegisterTasksContended(state, /*shared_queue=*/false);
+}
+
+BENCHMARK(BM_RegisterTasksContendedSharedQueue)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->UseRealTime();
+BENCHMARK(BM_RegisterTasksContendedQueuePerProducer)
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
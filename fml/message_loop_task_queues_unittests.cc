@@ -451,5 +451,27 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, ReusesTheSlotsOfDisposedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto live_queue = task_queue->CreateTaskQueue();
+
+  // More queues than can exist at the same time.
+  constexpr size_t kQueueCount = (1u << 20) + 1;
+  auto previous_queue = task_queue->CreateTaskQueue();
+  task_queue->Dispose(previous_queue);
+  for (size_t i = 0; i < kQueueCount; i++) {
+    auto queue = task_queue->CreateTaskQueue();
+    // The id of a disposed queue is not handed out again right away.
+    ASSERT_NE(previous_queue, queue);
+    task_queue->Dispose(queue);
+    previous_queue = queue;
+  }
+
+  task_queue->RegisterTask(
+      live_queue, []() {}, ChronoTicksSinceEpoch());
+  ASSERT_TRUE(task_queue->HasPendingTasks(live_queue));
+  task_queue->Dispose(live_queue);
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -339,3 +339,111 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksOnCurrentThread) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+  fml::AutoResetWaitableEvent latch;
+  bool runs_tasks_on_current_thread = false;
+  loop->GetTaskRunner()->PostTask([&]() {
+    runs_tasks_on_current_thread = loop->RunsTasksOnCurrentThread();
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_TRUE(runs_tasks_on_current_thread);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopStealsTasksPostedByWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 8;
+  fml::CountDownLatch latch(kCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  task_runner->PostTask([&]() {
+    // These tasks are queued with the current worker, the other workers have
+    // to steal them to run them.
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTask([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::scoped_lock lock(thread_ids_mutex);
+        thread_ids.insert(std::this_thread::get_id());
+        latch.CountDown();
+      });
+    }
+  });
+  latch.Wait();
+  ASSERT_GT(thread_ids.size(), 1u);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedDuringShutdown) {
+  const size_t kCount = 10000;
+  std::atomic_size_t run_count = 0;
+  std::thread poster;
+  {
+    auto loop = fml::ConcurrentMessageLoop::Create(4u);
+    auto task_runner = loop->GetTaskRunner();
+    fml::AutoResetWaitableEvent started;
+    poster = std::thread([task_runner, &run_count, &started]() {
+      for (size_t i = 0; i < kCount; ++i) {
+        task_runner->PostTask([&run_count]() { run_count++; });
+        if (i == 0) {
+          started.Signal();
+        }
+      }
+    });
+    started.Wait();
+    // The loop is terminated while tasks are still being posted.
+  }
+  poster.join();
+  ASSERT_EQ(run_count, kCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopPostsTaskToAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    std::scoped_lock lock(thread_ids_mutex);
+    thread_ids.insert(std::this_thread::get_id());
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopWorkersCanRunPendingTasks) {
+  // A single worker waits for a task it posted, which is queued behind it.
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&]() {
+    std::atomic_bool ran = false;
+    task_runner->PostTask([&ran]() { ran = true; });
+    while (!ran) {
+      ASSERT_TRUE(task_runner->RunPendingTaskOnWorker());
+    }
+    ASSERT_FALSE(task_runner->RunPendingTaskOnWorker());
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopOnlyRunsPendingTasksOnWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+  bool ran = false;
+  task_runner->PostTask([&ran]() { ran = true; });
+  ASSERT_FALSE(task_runner->RunPendingTaskOnWorker());
+  ASSERT_FALSE(ran);
+  unblock.Signal();
+}
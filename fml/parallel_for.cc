@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+// State shared between the calling thread and the worker tasks of a
+// |ParallelFor|. The job is owned by the caller, so it is only touched after
+// an index was successfully claimed.
+struct ParallelForState {
+  const std::function<void(size_t)>* job = nullptr;
+  const size_t count = 0u;
+  std::atomic_size_t next_index = 0u;
+
+  std::mutex completion_mutex;
+  std::condition_variable completion_cv;
+  size_t completed = 0u;
+
+  explicit ParallelForState(size_t p_count) : count(p_count) {}
+
+  // Claims and runs indices until none are left.
+  void Run() {
+    size_t ran = 0u;
+    for (auto index = next_index.fetch_add(1u); index < count;
+         index = next_index.fetch_add(1u)) {
+      (*job)(index);
+      ran++;
+    }
+    if (ran == 0u) {
+      return;
+    }
+    std::scoped_lock lock(completion_mutex);
+    completed += ran;
+    if (completed == count) {
+      completion_cv.notify_all();
+    }
+  }
+
+  void WaitForCompletion() {
+    std::unique_lock lock(completion_mutex);
+    completion_cv.wait(lock, [&]() { return completed == count; });
+  }
+};
+
+}  // namespace
+
+void ParallelFor(size_t count,
+                 const std::function<void(size_t)>& job,
+                 const std::shared_ptr<ConcurrentTaskRunner>& task_runner,
+                 const char* trace_name) {
+  if (count == 0u) {
+    return;
+  }
+  if (!task_runner || count == 1u) {
+    for (size_t i = 0; i < count; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>(count);
+  state->job = &job;
+
+  const size_t worker_tasks = std::min<size_t>(
+      count - 1u, std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < worker_tasks; i++) {
+    task_runner->PostTask([state, trace_name]() {
+      TRACE_EVENT0("flutter", trace_name);
+      state->Run();
+    });
+  }
+  state->Run();
+  state->WaitForCompletion();
+}
+
+}  // namespace fml
@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PARALLEL_FOR_H_
+#define FLUTTER_FML_PARALLEL_FOR_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Calls |job| with every index in [0, count) and returns once all
+///             calls have returned.
+///
+///             The calls are spread over the calling thread and up to
+///             `count - 1` tasks posted to |task_runner|. Every thread claims
+///             indices until none are left, so this doesn't deadlock when
+///             called from one of the workers or when all workers are busy.
+///             Posted tasks that start after all indices have been claimed
+///             return without touching |job|.
+///
+///             Jobs must not wait for other tasks of |task_runner|, as those
+///             may be queued behind the tasks posted here.
+///
+/// @param[in]  count        The number of indices.
+/// @param[in]  job          The job to call with each index. Called
+///                          concurrently from several threads.
+/// @param[in]  task_runner  The task runner of the workers, or nullptr to run
+///                          all jobs on the calling thread.
+/// @param[in]  trace_name   The name of the trace event around each worker
+///                          task. Must have static storage duration.
+///
+void ParallelFor(size_t count,
+                 const std::function<void(size_t)>& job,
+                 const std::shared_ptr<ConcurrentTaskRunner>& task_runner,
+                 const char* trace_name = "fml::ParallelFor");
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PARALLEL_FOR_H_
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/parallel_for.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(ParallelForTest, CallsJobWithEveryIndexOnce) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  std::vector<std::atomic_int> calls(1000);
+  ParallelFor(
+      calls.size(), [&](size_t index) { calls[index]++; },
+      loop->GetTaskRunner());
+  for (const auto& call : calls) {
+    EXPECT_EQ(call, 1);
+  }
+}
+
+TEST(ParallelForTest, RunsJobsOnWorkers) {
+  auto loop = ConcurrentMessageLoop::Create(2);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  // Each job blocks until another thread ran a job, so the calling thread
+  // cannot run all of them.
+  std::atomic_size_t started = 0u;
+  ParallelFor(
+      2u,
+      [&](size_t) {
+        started++;
+        while (started < 2u) {
+          std::this_thread::yield();
+        }
+        std::scoped_lock lock(mutex);
+        threads.insert(std::this_thread::get_id());
+      },
+      loop->GetTaskRunner());
+  EXPECT_EQ(threads.size(), 2u);
+  EXPECT_EQ(threads.count(std::this_thread::get_id()), 1u);
+}
+
+TEST(ParallelForTest, RunsJobsOnCallingThreadWithoutTaskRunner) {
+  size_t calls = 0u;
+  ParallelFor(
+      10u,
+      [&](size_t index) {
+        EXPECT_EQ(index, calls);
+        calls++;
+      },
+      nullptr);
+  EXPECT_EQ(calls, 10u);
+}
+
+TEST(ParallelForTest, CanBeNestedOnBusyWorkers) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  std::atomic_size_t calls = 0u;
+  ParallelFor(
+      4u,
+      [&](size_t) {
+        ParallelFor(
+            4u, [&](size_t) { calls++; }, loop->GetTaskRunner());
+      },
+      loop->GetTaskRunner());
+  EXPECT_EQ(calls, 16u);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/task_inbox.h"
+
+#include <limits>
+
+namespace fml {
+
+namespace {
+
+constexpr int64_t kNoTargetTime = std::numeric_limits<int64_t>::max();
+
+int64_t ToTicks(fml::TimePoint time) {
+  return time.ToEpochDelta().ToNanoseconds();
+}
+
+}  // namespace
+
+TaskInbox::TaskInbox() : head_(nullptr), earliest_target_time_(kNoTargetTime) {}
+
+TaskInbox::~TaskInbox() {
+  Node* node = head_.exchange(nullptr);
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+void TaskInbox::Push(const DelayedTask& task) {
+  Node* node = new Node{task, head_.load(std::memory_order_relaxed)};
+  while (!head_.compare_exchange_weak(node->next, node)) {
+  }
+
+  // The bound is lowered after the task is visible to the consumer, see
+  // `MoveTo`.
+  const int64_t target_time = ToTicks(task.GetTargetTime());
+  int64_t earliest = earliest_target_time_.load();
+  while (target_time < earliest &&
+         !earliest_target_time_.compare_exchange_weak(earliest, target_time)) {
+  }
+}
+
+size_t TaskInbox::MoveTo(TaskSource& task_source) {
+  if (IsEmpty()) {
+    return 0;
+  }
+
+  // The bound is reset before the tasks are taken. A task that is pushed
+  // concurrently is either taken here, or it is left in the inbox and lowers
+  // the bound after the reset. In both cases the bound is never higher than
+  // the target time of any task left in the inbox.
+  earliest_target_time_.store(kNoTargetTime);
+  Node* node = head_.exchange(nullptr);
+
+  size_t count = 0;
+  while (node) {
+    task_source.RegisterTask(node->task);
+    Node* next = node->next;
+    delete node;
+    node = next;
+    count++;
+  }
+  return count;
+}
+
+bool TaskInbox::IsEmpty() const {
+  return head_.load() == nullptr;
+}
+
+fml::TimePoint TaskInbox::GetEarliestTargetTime() const {
+  return fml::TimePoint::FromTicks(earliest_target_time_.load());
+}
+
+}  // namespace fml
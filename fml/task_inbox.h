@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_INBOX_H_
+#define FLUTTER_FML_TASK_INBOX_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/delayed_task.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_source.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+/**
+ * A lock-free multi-producer, single-consumer collection of tasks that have
+ * been registered with a task queue but not yet moved into its `TaskSource`.
+ *
+ * Any number of threads may push tasks concurrently without blocking each
+ * other or the consumer. The consumer takes all pushed tasks at once with
+ * `MoveTo`. Only one thread may act as the consumer at a time, the task
+ * dispatcher guarantees this by only calling `MoveTo` while holding the lock
+ * of the task queue the inbox belongs to.
+ *
+ * Along with the tasks, the inbox maintains a lower bound for their target
+ * times so that producers can decide when the loop has to wake up without
+ * looking at the `TaskSource`.
+ */
+class TaskInbox {
+ public:
+  TaskInbox();
+
+  /// Drops the tasks that were not moved into a task source.
+  ~TaskInbox();
+
+  /// Adds a task. Safe to call from any thread.
+  void Push(const DelayedTask& task);
+
+  /// Moves all tasks pushed so far into `task_source`. Must only be called by
+  /// the consumer.
+  ///
+  /// @return The number of tasks that were moved.
+  size_t MoveTo(TaskSource& task_source);
+
+  /// Returns true if no tasks were pushed since the last call to `MoveTo`.
+  bool IsEmpty() const;
+
+  /// A lower bound for the target times of the tasks in the inbox. It may be
+  /// lower than the earliest target time of the tasks if tasks are moved
+  /// concurrently. Meaningless if the inbox is empty.
+  fml::TimePoint GetEarliestTargetTime() const;
+
+ private:
+  struct Node {
+    DelayedTask task;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_;
+  std::atomic<int64_t> earliest_target_time_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskInbox);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_INBOX_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/task_inbox.h"
+#include "flutter/fml/time/chrono_timestamp_provider.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskInboxTests, MovesTasksInOrder) {
+  TaskInbox inbox;
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int value = 0;
+  inbox.Push(
+      {1, [&] { value = 1; }, time_stamp, TaskSourceGrade::kUnspecified});
+  inbox.Push(
+      {2, [&] { value = 2; }, time_stamp, TaskSourceGrade::kUnspecified});
+  ASSERT_FALSE(inbox.IsEmpty());
+  ASSERT_EQ(inbox.MoveTo(task_source), 2u);
+  ASSERT_TRUE(inbox.IsEmpty());
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 2u);
+  task_source.Top().task.GetTask()();
+  task_source.PopTask(TaskSourceGrade::kUnspecified);
+  ASSERT_EQ(value, 1);
+  task_source.Top().task.GetTask()();
+  task_source.PopTask(TaskSourceGrade::kUnspecified);
+  ASSERT_EQ(value, 2);
+}
+
+TEST(TaskInboxTests, TracksEarliestTargetTime) {
+  TaskInbox inbox;
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  inbox.Push({1, [] {}, time_stamp + fml::TimeDelta::FromMilliseconds(5),
+              TaskSourceGrade::kUnspecified});
+  inbox.Push({2, [] {}, time_stamp, TaskSourceGrade::kUnspecified});
+  inbox.Push({3, [] {}, time_stamp + fml::TimeDelta::FromMilliseconds(1),
+              TaskSourceGrade::kUnspecified});
+  ASSERT_EQ(inbox.GetEarliestTargetTime(), time_stamp);
+
+  inbox.MoveTo(task_source);
+  inbox.Push({4, [] {}, time_stamp + fml::TimeDelta::FromMilliseconds(2),
+              TaskSourceGrade::kUnspecified});
+  ASSERT_EQ(inbox.GetEarliestTargetTime(),
+            time_stamp + fml::TimeDelta::FromMilliseconds(2));
+}
+
+TEST(TaskInboxTests, ConcurrentPushesAreNotLost) {
+  constexpr size_t kProducers = 8;
+  constexpr size_t kTasksPerProducer = 1000;
+  TaskInbox inbox;
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < kProducers; i++) {
+    producers.emplace_back([&inbox, time_stamp, i]() {
+      for (size_t j = 0; j < kTasksPerProducer; j++) {
+        inbox.Push({i * kTasksPerProducer + j, [] {}, time_stamp,
+                    TaskSourceGrade::kUnspecified});
+      }
+    });
+  }
+
+  // Drain concurrently with the producers.
+  size_t moved = 0;
+  while (moved < kProducers * kTasksPerProducer / 2) {
+    moved += inbox.MoveTo(task_source);
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  moved += inbox.MoveTo(task_source);
+
+  ASSERT_EQ(moved, kProducers * kTasksPerProducer);
+  ASSERT_EQ(task_source.GetNumPendingTasks(), kProducers * kTasksPerProducer);
+  ASSERT_TRUE(inbox.IsEmpty());
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -100,4 +100,8 @@ void TaskSource::ResumeSecondary() {
   FML_DCHECK(secondary_pause_requests_ >= 0);
 }
 
+bool TaskSource::IsSecondaryPaused() const {
+  return secondary_pause_requests_ > 0;
+}
+
 }  // namespace fml
@@ -71,6 +71,9 @@ class TaskSource {
   /// Resume providing tasks from secondary task heap.
   void ResumeSecondary();
 
+  /// Returns true if tasks from the secondary task heap are not provided.
+  bool IsSecondaryPaused() const;
+
  private:
   const fml::TaskQueueId task_queue_id_;
   fml::DelayedTaskQueue primary_task_queue_;
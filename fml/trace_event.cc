@@ -11,20 +11,21 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 namespace fml {
 namespace tracing {
 
-#if FLUTTER_TIMELINE_ENABLED
-
 namespace {
 
 int64_t DefaultMicrosSource() {
   return -1;
 }
 
+#if FLUTTER_TIMELINE_ENABLED
 AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
+#endif  // FLUTTER_TIMELINE_ENABLED
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
 
 inline void FlutterTimelineEvent(const char* label,
@@ -34,34 +35,59 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  // The ring buffer is available in all runtime modes, including release.
+  // Counters are recorded along with their values by |TraceCounter|.
+  if (type != Dart_Timeline_Event_Counter && TraceRingBuffer::IsEnabled()) {
+    TraceRingBuffer::AddEvent(
+        label,
+        timestamp0 >= 0 ? timestamp0
+                        : TimePoint::Now().ToEpochDelta().ToMicroseconds(),
+        timestamp1_or_async_id, type);
+  }
+#if FLUTTER_TIMELINE_ENABLED
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
   if (handler && gAllowlist.Query(label)) {
     handler(label, timestamp0, timestamp1_or_async_id, type, argument_count,
             argument_names, argument_values);
   }
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 }  // namespace
 
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {
+#if FLUTTER_TIMELINE_ENABLED
   gAllowlist.Fill(allowlist);
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {
+#if FLUTTER_TIMELINE_ENABLED
   gTimelineEventHandler = handler;
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 bool TraceHasTimelineEventHandler() {
+#if FLUTTER_TIMELINE_ENABLED
   return static_cast<bool>(
       gTimelineEventHandler.load(std::memory_order_relaxed));
+#else   // FLUTTER_TIMELINE_ENABLED
+  return false;
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 int64_t TraceGetTimelineMicros() {
+#if FLUTTER_TIMELINE_ENABLED
   return gTimelineMicrosSource.load()();
+#else   // FLUTTER_TIMELINE_ENABLED
+  return -1;
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 void TraceSetTimelineMicrosSource(TimelineMicrosSource source) {
+#if FLUTTER_TIMELINE_ENABLED
   gTimelineMicrosSource = source;
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 size_t TraceNonce() {
@@ -310,108 +336,5 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
   );
 }
 
-#else  // FLUTTER_TIMELINE_ENABLED
-
-void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
-
-void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
-
-bool TraceHasTimelineEventHandler() {
-  return false;
-}
-
-int64_t TraceGetTimelineMicros() {
-  return -1;
-}
-
-void TraceSetTimelineMicrosSource(TimelineMicrosSource source) {}
-
-size_t TraceNonce() {
-  return 0;
-}
-
-void TraceTimelineEvent(TraceArg category_group,
-                        TraceArg name,
-                        int64_t timestamp_micros,
-                        TraceIDArg identifier,
-                        Dart_Timeline_Event_Type type,
-                        const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
-
-void TraceTimelineEvent(TraceArg category_group,
-                        TraceArg name,
-                        TraceIDArg identifier,
-                        Dart_Timeline_Event_Type type,
-                        const std::vector<const char*>& c_names,
-                        const std::vector<std::string>& values) {}
-
-void TraceEvent0(TraceArg category_group, TraceArg name) {}
-
-void TraceEvent1(TraceArg category_group,
-                 TraceArg name,
-                 TraceArg arg1_name,
-                 TraceArg arg1_val) {}
-
-void TraceEvent2(TraceArg category_group,
-                 TraceArg name,
-                 TraceArg arg1_name,
-                 TraceArg arg1_val,
-                 TraceArg arg2_name,
-                 TraceArg arg2_val) {}
-
-void TraceEventEnd(TraceArg name) {}
-
-void TraceEventAsyncComplete(TraceArg category_group,
-                             TraceArg name,
-                             TimePoint begin,
-                             TimePoint end) {}
-
-void TraceEventAsyncBegin0(TraceArg category_group,
-                           TraceArg name,
-                           TraceIDArg id) {}
-
-void TraceEventAsyncEnd0(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id) {}
-
-void TraceEventAsyncBegin1(TraceArg category_group,
-                           TraceArg name,
-                           TraceIDArg id,
-                           TraceArg arg1_name,
-                           TraceArg arg1_val) {}
-
-void TraceEventAsyncEnd1(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id,
-                         TraceArg arg1_name,
-                         TraceArg arg1_val) {}
-
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
-
-void TraceEventInstant1(TraceArg category_group,
-                        TraceArg name,
-                        TraceArg arg1_name,
-                        TraceArg arg1_val) {}
-
-void TraceEventInstant2(TraceArg category_group,
-                        TraceArg name,
-                        TraceArg arg1_name,
-                        TraceArg arg1_val,
-                        TraceArg arg2_name,
-                        TraceArg arg2_val) {}
-
-void TraceEventFlowBegin0(TraceArg category_group,
-                          TraceArg name,
-                          TraceIDArg id) {}
-
-void TraceEventFlowStep0(TraceArg category_group,
-                         TraceArg name,
-                         TraceIDArg id) {}
-
-void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
-}
-
-#endif  // FLUTTER_TIMELINE_ENABLED
-
 }  // namespace tracing
 }  // namespace fml
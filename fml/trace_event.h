@@ -41,10 +41,12 @@
 #include <cstdint>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -234,11 +236,35 @@ SplitArguments(Key key, Value value, Args... args) {
 
 size_t TraceNonce();
 
+inline void TraceCounterRingBufferValues(TraceArg name,
+                                         int64_t timestamp_micros,
+                                         TraceIDArg identifier) {}
+
+template <typename Key, typename Value, typename... Args>
+void TraceCounterRingBufferValues(TraceArg name,
+                                  int64_t timestamp_micros,
+                                  TraceIDArg identifier,
+                                  Key key,
+                                  Value value,
+                                  Args... args) {
+  // The ring buffer only keeps numeric values.
+  if constexpr (std::is_arithmetic_v<Value>) {
+    TraceRingBuffer::AddCounterEvent(name, timestamp_micros, identifier, key,
+                                     static_cast<int64_t>(value));
+  }
+  TraceCounterRingBufferValues(name, timestamp_micros, identifier, args...);
+}
+
 template <typename... Args>
 void TraceCounter(TraceArg category,
                   TraceArg name,
                   TraceIDArg identifier,
                   Args... args) {
+  if (TraceRingBuffer::IsEnabled()) {
+    TraceCounterRingBufferValues(
+        name, TimePoint::Now().ToEpochDelta().ToMicroseconds(), identifier,
+        args...);
+  }
 #if FLUTTER_TIMELINE_ENABLED
   auto split = SplitArguments(args...);
   TraceTimelineEvent(category, name, identifier, Dart_Timeline_Event_Counter,
@@ -254,15 +280,6 @@ void TraceCounterNopHACK(TraceArg category,
                          TraceIDArg identifier,
                          Args... args) {}
 
-template <typename... Args>
-void TraceEvent(TraceArg category, TraceArg name, Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
-  auto split = SplitArguments(args...);
-  TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
-                     split.second);
-#endif  // FLUTTER_TIMELINE_ENABLED
-}
-
 void TraceEvent0(TraceArg category_group, TraceArg name);
 
 void TraceEvent1(TraceArg category_group,
@@ -277,6 +294,19 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_name,
                  TraceArg arg2_val);
 
+template <typename... Args>
+void TraceEvent(TraceArg category, TraceArg name, Args... args) {
+#if FLUTTER_TIMELINE_ENABLED
+  auto split = SplitArguments(args...);
+  TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
+                     split.second);
+#else   // FLUTTER_TIMELINE_ENABLED
+  // Still record the begin event in the trace ring buffer, which does not
+  // keep arguments, to match the end event of |ScopedInstantEnd|.
+  TraceEvent0(category, name);
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
 void TraceEventEnd(TraceArg name);
 
 template <typename... Args>
@@ -285,9 +315,13 @@ void TraceEventAsyncComplete(TraceArg category_group,
                              TimePoint begin,
                              TimePoint end,
                              Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
   auto identifier = TraceNonce();
+#if FLUTTER_TIMELINE_ENABLED
   const auto split = SplitArguments(args...);
+#else   // FLUTTER_TIMELINE_ENABLED
+  // Only the trace ring buffer records events, and it does not keep arguments.
+  const std::pair<std::vector<const char*>, std::vector<std::string>> split;
+#endif  // FLUTTER_TIMELINE_ENABLED
 
   if (begin > end) {
     std::swap(begin, end);
@@ -313,7 +347,6 @@ void TraceEventAsyncComplete(TraceArg category_group,
                      split.first,                    // names
                      split.second                    // values
   );
-#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 void TraceEventAsyncBegin0(TraceArg category_group,
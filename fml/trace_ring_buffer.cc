@@ -0,0 +1,373 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// An event slot of a thread buffer. All fields are atomics so that the slot
+// can be read while its thread overwrites it. The sequence acts as a seqlock:
+// it is zero while the slot is being written, and otherwise the 1-based index
+// of the event in the thread's sequence of events.
+struct EventSlot {
+  std::atomic<uint64_t> sequence = {0};
+  std::atomic<const char*> name = {nullptr};
+  std::atomic<int64_t> timestamp_micros = {0};
+  std::atomic<int64_t> id = {0};
+  std::atomic<Dart_Timeline_Event_Type> type = {Dart_Timeline_Event_Begin};
+  std::atomic<const char*> counter_name = {nullptr};
+  std::atomic<int64_t> counter_value = {0};
+};
+
+struct Event {
+  const char* name;
+  int64_t timestamp_micros;
+  int64_t id;
+  Dart_Timeline_Event_Type type;
+  const char* counter_name;
+  int64_t counter_value;
+};
+
+class ThreadBuffer {
+ public:
+  ThreadBuffer() = default;
+
+  // Only called by the thread that owns the buffer.
+  void Add(const char* name,
+           int64_t timestamp_micros,
+           int64_t id,
+           Dart_Timeline_Event_Type type,
+           const char* counter_name,
+           int64_t counter_value) {
+    const uint64_t index = write_count_.load(std::memory_order_relaxed);
+    EventSlot& slot = slots_[index % slots_.size()];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp_micros.store(timestamp_micros, std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    slot.counter_name.store(counter_name, std::memory_order_relaxed);
+    slot.counter_value.store(counter_value, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    write_count_.store(index + 1, std::memory_order_release);
+  }
+
+  // May be called on any thread. Appends the events that are not being
+  // overwritten concurrently, oldest first.
+  void Collect(std::vector<Event>& events) const {
+    const uint64_t end = write_count_.load(std::memory_order_acquire);
+    uint64_t begin = read_start_.load(std::memory_order_relaxed);
+    if (end > slots_.size()) {
+      begin = std::max<uint64_t>(begin, end - slots_.size());
+    }
+    for (uint64_t index = begin; index < end; index++) {
+      const EventSlot& slot = slots_[index % slots_.size()];
+      const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      Event event = {
+          slot.name.load(std::memory_order_relaxed),
+          slot.timestamp_micros.load(std::memory_order_relaxed),
+          slot.id.load(std::memory_order_relaxed),
+          slot.type.load(std::memory_order_relaxed),
+          slot.counter_name.load(std::memory_order_relaxed),
+          slot.counter_value.load(std::memory_order_relaxed),
+      };
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence == index + 1 &&
+          slot.sequence.load(std::memory_order_relaxed) == sequence) {
+        events.push_back(event);
+      }
+    }
+  }
+
+  // May be called on any thread.
+  void Clear() {
+    read_start_.store(write_count_.load(std::memory_order_acquire),
+                      std::memory_order_relaxed);
+  }
+
+  // Only called while no thread owns the buffer.
+  void Reset(int64_t thread_id, std::string thread_name) {
+    thread_id_ = thread_id;
+    thread_name_ = std::move(thread_name);
+    read_start_.store(0, std::memory_order_relaxed);
+    write_count_.store(0, std::memory_order_release);
+  }
+
+  // The members below are guarded by the mutex of the registry.
+  int64_t thread_id_ = 0;
+  std::string thread_name_;
+  bool in_use_ = false;
+
+ private:
+  std::array<EventSlot, TraceRingBuffer::kEventsPerThread> slots_;
+  std::atomic<uint64_t> write_count_ = {0};
+  std::atomic<uint64_t> read_start_ = {0};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+// The buffers of all threads that have recorded events. Buffers are never
+// destroyed, so that events of exited threads can still be collected and
+// threads exiting during shutdown can return their buffers.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  int64_t next_thread_id = 1;
+  std::string last_jank_trace;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// The name of the current thread, set by |SetCurrentThreadName| before the
+// thread recorded its first event.
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<std::string> tls_thread_name;
+
+// Owns a buffer on behalf of a thread, and returns it to the registry when
+// the thread exits.
+class ThreadBufferLease {
+ public:
+  ThreadBufferLease() {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    for (const auto& buffer : registry.buffers) {
+      if (!buffer->in_use_) {
+        buffer_ = buffer.get();
+        break;
+      }
+    }
+    if (buffer_ == nullptr) {
+      registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+      buffer_ = registry.buffers.back().get();
+    }
+    const std::string* thread_name = tls_thread_name.get();
+    buffer_->Reset(registry.next_thread_id++,
+                   thread_name ? *thread_name : std::string());
+    buffer_->in_use_ = true;
+  }
+
+  ~ThreadBufferLease() {
+    std::scoped_lock lock(GetRegistry().mutex);
+    buffer_->in_use_ = false;
+  }
+
+  ThreadBuffer& buffer() { return *buffer_; }
+
+  void SetThreadName(const std::string& name) {
+    std::scoped_lock lock(GetRegistry().mutex);
+    buffer_->thread_name_ = name;
+  }
+
+ private:
+  ThreadBuffer* buffer_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBufferLease);
+};
+
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<ThreadBufferLease> tls_lease;
+
+ThreadBuffer& GetCurrentThreadBuffer() {
+  if (tls_lease.get() == nullptr) {
+    tls_lease.reset(new ThreadBufferLease());
+  }
+  return tls_lease.get()->buffer();
+}
+
+const char* GetPhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    default:
+      // Complete events are not recorded by fml.
+      return nullptr;
+  }
+}
+
+bool HasId(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+    case Dart_Timeline_Event_Counter:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void WriteEscapedString(std::ostream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          static constexpr char kHexDigits[] = "0123456789abcdef";
+          stream << "\\u00" << kHexDigits[*c >> 4] << kHexDigits[*c & 0xf];
+        } else {
+          stream << *c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+std::atomic_bool TraceRingBuffer::enabled_ = false;
+
+void TraceRingBuffer::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRingBuffer::AddEvent(const char* name,
+                               int64_t timestamp_micros,
+                               int64_t id,
+                               Dart_Timeline_Event_Type type) {
+  GetCurrentThreadBuffer().Add(name, timestamp_micros, id, type, nullptr, 0);
+}
+
+void TraceRingBuffer::AddCounterEvent(const char* name,
+                                      int64_t timestamp_micros,
+                                      int64_t id,
+                                      const char* counter_name,
+                                      int64_t counter_value) {
+  GetCurrentThreadBuffer().Add(name, timestamp_micros, id,
+                               Dart_Timeline_Event_Counter, counter_name,
+                               counter_value);
+}
+
+void TraceRingBuffer::SetCurrentThreadName(const std::string& name) {
+  // Don't obtain a buffer for threads that may never record events.
+  if (ThreadBufferLease* lease = tls_lease.get()) {
+    lease->SetThreadName(name);
+  } else {
+    tls_thread_name.reset(new std::string(name));
+  }
+}
+
+void TraceRingBuffer::Clear() {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& buffer : registry.buffers) {
+    buffer->Clear();
+  }
+}
+
+std::string TraceRingBuffer::GetChromeTraceJSON() {
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  std::vector<Event> events;
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& buffer : registry.buffers) {
+    events.clear();
+    buffer->Collect(events);
+    if (!events.empty() && !buffer->thread_name_.empty()) {
+      // Metadata events name the threads in trace viewers.
+      if (!first) {
+        stream << ",";
+      }
+      first = false;
+      stream << "{\"name\":\"thread_name\",\"ph\":\"M\"";
+      stream << ",\"pid\":0,\"tid\":" << buffer->thread_id_;
+      stream << ",\"args\":{\"name\":";
+      WriteEscapedString(stream, buffer->thread_name_.c_str());
+      stream << "}}";
+    }
+    for (const auto& event : events) {
+      const char* phase = GetPhase(event.type);
+      if (phase == nullptr || event.name == nullptr) {
+        continue;
+      }
+      if (!first) {
+        stream << ",";
+      }
+      first = false;
+      stream << "{\"name\":";
+      WriteEscapedString(stream, event.name);
+      stream << ",\"ph\":\"" << phase << "\"";
+      stream << ",\"ts\":" << event.timestamp_micros;
+      stream << ",\"pid\":0,\"tid\":" << buffer->thread_id_;
+      if (event.type == Dart_Timeline_Event_Instant) {
+        stream << ",\"s\":\"t\"";
+      }
+      if (HasId(event.type)) {
+        stream << ",\"id\":" << event.id;
+      }
+      if (event.type == Dart_Timeline_Event_Flow_End) {
+        stream << ",\"bp\":\"e\"";
+      }
+      if (event.type == Dart_Timeline_Event_Counter &&
+          event.counter_name != nullptr) {
+        stream << ",\"args\":{";
+        WriteEscapedString(stream, event.counter_name);
+        stream << ":" << event.counter_value << "}";
+      }
+      stream << "}";
+    }
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+void TraceRingBuffer::CaptureJankTrace() {
+  std::string trace = GetChromeTraceJSON();
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  registry.last_jank_trace = std::move(trace);
+}
+
+std::string TraceRingBuffer::GetLastJankTrace() {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  return registry.last_jank_trace;
+}
+
+}  // namespace tracing
+}  // namespace fml
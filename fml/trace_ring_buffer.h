@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the most recent trace events of every thread in memory so
+///             that the moments before a slow frame can be inspected without
+///             a tracing session, including in release builds.
+///
+///             Each thread records into a fixed size ring buffer of its own,
+///             without taking locks or allocating memory. The only exception
+///             is the first event of a thread, which obtains a buffer from a
+///             shared pool. Buffers of exited threads are kept, so that their
+///             events remain available until a new thread reuses the buffer.
+///
+///             Only the pointer to the name of an event is recorded. Names
+///             must therefore have static storage duration, which is the case
+///             for the string literals passed to the TRACE_EVENT macros.
+///             Categories and arguments are not recorded, except for the
+///             integral values of counters.
+///
+class TraceRingBuffer {
+ public:
+  /// The number of most recent events kept for each thread.
+  static constexpr size_t kEventsPerThread = 2048u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables or disables recording of the events added through
+  ///             fml/trace_event.h. Recording is disabled by default.
+  ///
+  static void SetEnabled(bool enabled);
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record an event in the ring buffer of the calling thread,
+  ///             overwriting its oldest event if the buffer is full.
+  ///
+  ///             Events are recorded regardless of |IsEnabled|.
+  ///
+  /// @param[in]  name              The name of the event. Must have static
+  ///                               storage duration.
+  /// @param[in]  timestamp_micros  The time of the event on the clock of
+  ///                               |fml::TimePoint|.
+  /// @param[in]  id                The identifier of async and flow events.
+  /// @param[in]  type              The type of the event.
+  ///
+  static void AddEvent(const char* name,
+                       int64_t timestamp_micros,
+                       int64_t id,
+                       Dart_Timeline_Event_Type type);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the value of a counter in the ring buffer of the
+  ///             calling thread, see |AddEvent|.
+  ///
+  /// @param[in]  name              The name of the counter. Must have static
+  ///                               storage duration.
+  /// @param[in]  timestamp_micros  The time of the event on the clock of
+  ///                               |fml::TimePoint|.
+  /// @param[in]  id                The identifier of the counter instance.
+  /// @param[in]  counter_name      The name of the value. Must have static
+  ///                               storage duration.
+  /// @param[in]  counter_value     The value.
+  ///
+  static void AddCounterEvent(const char* name,
+                              int64_t timestamp_micros,
+                              int64_t id,
+                              const char* counter_name,
+                              int64_t counter_value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Set the name under which the events of the calling thread
+  ///             are listed in the trace. Called by |fml::Thread| for the
+  ///             threads it names.
+  ///
+  static void SetCurrentThreadName(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discard the events recorded so far by all threads.
+  ///
+  static void Clear();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the recorded events of all threads in the Chrome JSON
+  ///             trace event format, which can be loaded by Perfetto UI and
+  ///             chrome://tracing.
+  ///
+  ///             Events that are being overwritten while the trace is
+  ///             collected are left out.
+  ///
+  static std::string GetChromeTraceJSON();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collect the recorded events, see |GetChromeTraceJSON|, and
+  ///             keep them until the next capture. Meant to be called when a
+  ///             frame missed its deadline, so that the trace leading up to
+  ///             the most recent jank can be retrieved later.
+  ///
+  static void CaptureJankTrace();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the trace collected by the last call to
+  ///             |CaptureJankTrace|, or an empty string if there was none.
+  ///
+  static std::string GetLastJankTrace();
+
+ private:
+  static std::atomic_bool enabled_;
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TraceRingBuffer);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
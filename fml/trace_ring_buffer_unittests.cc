@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <string>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+size_t CountOccurrences(const std::string& string, const std::string& part) {
+  size_t count = 0;
+  for (size_t pos = string.find(part); pos != std::string::npos;
+       pos = string.find(part, pos + part.size())) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(TraceRingBufferTest, RecordsAddedEvents) {
+  TraceRingBuffer::Clear();
+  TraceRingBuffer::AddEvent("RingBufferBegin", 10, 0,
+                            Dart_Timeline_Event_Begin);
+  TraceRingBuffer::AddEvent("RingBufferAsync", 20, 42,
+                            Dart_Timeline_Event_Async_Begin);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferBegin\",\"ph\":\"B\",\"ts\":10,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferAsync\",\"ph\":\"b\",\"ts\":20,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"id\":42}"), std::string::npos);
+}
+
+TEST(TraceRingBufferTest, KeepsTheMostRecentEventsOfAThread) {
+  TraceRingBuffer::Clear();
+  for (size_t i = 0; i < TraceRingBuffer::kEventsPerThread; i++) {
+    TraceRingBuffer::AddEvent("RingBufferOld", 0, 0,
+                              Dart_Timeline_Event_Instant);
+  }
+  for (size_t i = 0; i < TraceRingBuffer::kEventsPerThread; i++) {
+    TraceRingBuffer::AddEvent("RingBufferNew", 0, 0,
+                              Dart_Timeline_Event_Instant);
+  }
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferOld"), 0u);
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferNew"),
+            TraceRingBuffer::kEventsPerThread);
+}
+
+TEST(TraceRingBufferTest, KeepsEventsOfExitedThreads) {
+  TraceRingBuffer::Clear();
+  std::thread thread([]() {
+    TraceRingBuffer::AddEvent("RingBufferThread", 0, 0,
+                              Dart_Timeline_Event_Instant);
+  });
+  thread.join();
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferThread"), 1u);
+}
+
+TEST(TraceRingBufferTest, ClearDiscardsEvents) {
+  TraceRingBuffer::AddEvent("RingBufferCleared", 0, 0,
+                            Dart_Timeline_Event_Instant);
+  TraceRingBuffer::Clear();
+  TraceRingBuffer::AddEvent("RingBufferKept", 0, 0,
+                            Dart_Timeline_Event_Instant);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferCleared"), 0u);
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferKept"), 1u);
+}
+
+TEST(TraceRingBufferTest, EscapesNames) {
+  TraceRingBuffer::Clear();
+  TraceRingBuffer::AddEvent("Ring\"Buffer\\\n", 0, 0,
+                            Dart_Timeline_Event_Instant);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_NE(trace.find("\"name\":\"Ring\\\"Buffer\\\\\\u000a\""),
+            std::string::npos);
+}
+
+TEST(TraceRingBufferTest, RecordsTraceEventsOnlyWhenEnabled) {
+  TraceRingBuffer::Clear();
+  { TRACE_EVENT0("flutter", "RingBufferDisabled"); }
+  TraceRingBuffer::SetEnabled(true);
+  { TRACE_EVENT0("flutter", "RingBufferEnabled"); }
+  TraceRingBuffer::SetEnabled(false);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferDisabled"), 0u);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferEnabled\",\"ph\":\"B\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferEnabled\",\"ph\":\"E\""),
+            std::string::npos);
+}
+
+TEST(TraceRingBufferTest, RecordsEventsWithArguments) {
+  TraceRingBuffer::Clear();
+  auto begin = TimePoint::FromEpochDelta(TimeDelta::FromMicroseconds(10));
+  auto end = TimePoint::FromEpochDelta(TimeDelta::FromMicroseconds(20));
+  TraceRingBuffer::SetEnabled(true);
+  { FML_TRACE_EVENT("flutter", "RingBufferArguments", "count", 1); }
+  TraceEventAsyncComplete("flutter", "RingBufferAsyncComplete", begin, end);
+  TraceRingBuffer::SetEnabled(false);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferArguments\",\"ph\":\"B\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferArguments\",\"ph\":\"E\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"RingBufferAsyncComplete\",\"ph\":\"b\",\"ts\":10,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"RingBufferAsyncComplete\",\"ph\":\"e\",\"ts\":20,"),
+            std::string::npos);
+}
+
+TEST(TraceRingBufferTest, RecordsCounterValues) {
+  TraceRingBuffer::Clear();
+  TraceRingBuffer::SetEnabled(true);
+  FML_TRACE_COUNTER("flutter", "RingBufferCounter", 7, "Frames", 42, "Name",
+                    "skipped");
+  TraceRingBuffer::SetEnabled(false);
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_EQ(CountOccurrences(trace, "RingBufferCounter"), 1u);
+  EXPECT_NE(trace.find("{\"name\":\"RingBufferCounter\",\"ph\":\"C\""),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"id\":7,\"args\":{\"Frames\":42}}"),
+            std::string::npos);
+}
+
+TEST(TraceRingBufferTest, NamesThreads) {
+  TraceRingBuffer::Clear();
+  std::thread thread([]() {
+    TraceRingBuffer::SetCurrentThreadName("ring.buffer");
+    TraceRingBuffer::AddEvent("RingBufferNamedThread", 0, 0,
+                              Dart_Timeline_Event_Instant);
+  });
+  thread.join();
+
+  auto trace = TraceRingBuffer::GetChromeTraceJSON();
+  EXPECT_NE(trace.find("{\"name\":\"thread_name\",\"ph\":\"M\","),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"name\":\"ring.buffer\"}}"),
+            std::string::npos);
+}
+
+TEST(TraceRingBufferTest, CapturesJankTrace) {
+  TraceRingBuffer::Clear();
+  TraceRingBuffer::AddEvent("RingBufferJank", 0, 0,
+                            Dart_Timeline_Event_Instant);
+  TraceRingBuffer::CaptureJankTrace();
+  TraceRingBuffer::Clear();
+
+  EXPECT_EQ(CountOccurrences(TraceRingBuffer::GetLastJankTrace(),
+                             "RingBufferJank"),
+            1u);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
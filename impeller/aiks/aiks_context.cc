@@ -4,12 +4,45 @@
 
 #include "impeller/aiks/aiks_context.h"
 
+#include <atomic>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/base/thread.h"
+#include "impeller/entity/pipeline_variant_profile.h"
+#include "impeller/entity/render_target_cache.h"
 
 namespace impeller {
 
-AiksContext::AiksContext(std::shared_ptr<Context> context)
-    : context_(std::move(context)) {
+static constexpr const char* kPipelineVariantsFileName =
+    "flutter.impeller.pipeline_variants";
+
+// New variants are usually created in bursts while an application shows a
+// screen for the first time. Wait for a number of frames before persisting
+// them so that a burst is written to disk once.
+static constexpr size_t kPipelineVariantsPersistInterval = 120u;
+
+// The state shared with the tasks that write the pipeline variants, which may
+// outlive the context.
+struct AiksContext::PipelineVariantsStore {
+  fml::UniqueFD cache_directory;
+  // |fml::WriteAtomically| writes through a temporary file with a fixed name,
+  // so writes must not overlap.
+  Mutex write_mutex;
+  // Whether a write was posted and has not finished yet.
+  std::atomic_bool write_pending = false;
+
+  explicit PipelineVariantsStore(fml::UniqueFD p_cache_directory)
+      : cache_directory(std::move(p_cache_directory)) {}
+};
+
+AiksContext::AiksContext(std::shared_ptr<Context> context,
+                         fml::UniqueFD cache_directory)
+    : context_(std::move(context)),
+      pipeline_variants_store_(std::make_shared<PipelineVariantsStore>(
+          std::move(cache_directory))) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -19,10 +52,79 @@ AiksContext::AiksContext(std::shared_ptr<Context> context)
     return;
   }
 
+  PrewarmPipelineVariants();
+
   is_valid_ = true;
 }
 
-AiksContext::~AiksContext() = default;
+AiksContext::~AiksContext() {
+  if (IsValid()) {
+    // Don't block the teardown on disk IO. Without workers, the variants
+    // recorded since the last periodic write are lost.
+    PersistPipelineVariants(/*can_block=*/false);
+  }
+}
+
+void AiksContext::PrewarmPipelineVariants() {
+  const auto& cache_directory = pipeline_variants_store_->cache_directory;
+  if (!cache_directory.is_valid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "AiksContext::PrewarmPipelineVariants");
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_directory,
+                                                  kPipelineVariantsFileName);
+  if (!mapping) {
+    return;
+  }
+  PipelineVariantProfile profile;
+  if (!profile.Load(*mapping)) {
+    return;
+  }
+  content_context_->PrewarmPipelineVariants(profile);
+  // The prewarmed variants are already on disk.
+  persisted_variant_generation_ =
+      content_context_->GetPipelineVariantProfile()->GetGeneration();
+}
+
+void AiksContext::PersistPipelineVariants(bool can_block) {
+  auto store = pipeline_variants_store_;
+  if (!store->cache_directory.is_valid()) {
+    return;
+  }
+  auto profile = content_context_->GetPipelineVariantProfile();
+  const auto generation = profile->GetGeneration();
+  if (generation == persisted_variant_generation_) {
+    return;
+  }
+  auto worker_task_runner = context_->GetConcurrentWorkerTaskRunner();
+  if (!worker_task_runner && !can_block) {
+    return;
+  }
+  // Keep at most one write in flight. Variants recorded in the meantime are
+  // written by a later call.
+  if (store->write_pending.exchange(true)) {
+    return;
+  }
+  persisted_variant_generation_ = generation;
+
+  auto persist = [profile, store]() {
+    TRACE_EVENT0("impeller", "AiksContext::PersistPipelineVariants");
+    {
+      Lock lock(store->write_mutex);
+      auto data = profile->Serialize();
+      if (!data || !fml::WriteAtomically(store->cache_directory,
+                                         kPipelineVariantsFileName, *data)) {
+        FML_LOG(ERROR) << "Could not persist pipeline variants to disk.";
+      }
+    }
+    store->write_pending = false;
+  };
+  if (!worker_task_runner) {
+    persist();
+    return;
+  }
+  worker_task_runner->PostTask(persist);
+}
 
 bool AiksContext::IsValid() const {
   return is_valid_;
@@ -36,13 +138,31 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
+bool AiksContext::GetPrefersSignedDistanceFieldText() const {
+  return prefers_signed_distance_field_text_;
+}
+
+void AiksContext::SetPrefersSignedDistanceFieldText(
+    bool prefers_signed_distance_field) {
+  prefers_signed_distance_field_text_ = prefers_signed_distance_field;
+}
+
 bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
   if (!IsValid()) {
     return false;
   }
 
   if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+    auto render_target_cache = content_context_->GetRenderTargetCache();
+    render_target_cache->Start();
+    auto result = picture.pass->Render(*content_context_, render_target);
+    render_target_cache->End();
+    if (++renders_since_variants_persisted_ >=
+        kPipelineVariantsPersistInterval) {
+      renders_since_variants_persisted_ = 0u;
+      PersistPipelineVariants(/*can_block=*/true);
+    }
+    return result;
   }
 
   return true;
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
@@ -18,7 +19,18 @@ class RenderPass;
 
 class AiksContext {
  public:
-  AiksContext(std::shared_ptr<Context> context);
+  //----------------------------------------------------------------------------
+  /// @brief      Construct a new AiksContext.
+  ///
+  /// @param[in]  context          The Impeller context that Aiks uses to
+  ///                              allocate resources and create pipelines.
+  /// @param[in]  cache_directory  An optional directory the pipeline variants
+  ///                              used by the application are persisted to.
+  ///                              The variants recorded by previous runs are
+  ///                              prewarmed when the context is created.
+  ///
+  AiksContext(std::shared_ptr<Context> context,
+              fml::UniqueFD cache_directory = {});
 
   ~AiksContext();
 
@@ -30,11 +42,33 @@ class AiksContext {
 
   bool Render(const Picture& picture, RenderTarget& render_target);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether text recorded for this context should be rendered
+  ///             from a signed distance field glyph atlas.
+  ///
+  /// @see        |TextFrame::SetPrefersSignedDistanceField|
+  ///
+  bool GetPrefersSignedDistanceFieldText() const;
+
+  void SetPrefersSignedDistanceFieldText(bool prefers_signed_distance_field);
+
  private:
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
+  struct PipelineVariantsStore;
+  std::shared_ptr<PipelineVariantsStore> pipeline_variants_store_;
+  uint64_t persisted_variant_generation_ = 0u;
+  size_t renders_since_variants_persisted_ = 0u;
+  bool prefers_signed_distance_field_text_ = false;
   bool is_valid_ = false;
 
+  void PrewarmPipelineVariants();
+
+  // Writes the pipeline variants recorded since the last write to the cache
+  // directory, on a worker if the context has any. Otherwise the write only
+  // happens if |can_block|.
+  void PersistPipelineVariants(bool can_block);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AiksContext);
 };
 
@@ -4,6 +4,7 @@
 
 #include "impeller/core/allocator.h"
 
+#include "flutter/fml/frame_counters.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/range.h"
@@ -42,6 +43,12 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
+  // Host visible buffers are mostly transient, such as the host buffers and
+  // staging buffers of a frame, and would drown out the persistent
+  // allocations.
+  if (desc.storage_mode != StorageMode::kHostVisible) {
+    fml::FrameCounters::Add(fml::FrameCounters::kBytesAllocated, desc.size);
+  }
   return OnCreateBuffer(desc);
 }
 
@@ -55,6 +62,8 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
+  fml::FrameCounters::Add(fml::FrameCounters::kBytesAllocated,
+                          desc.GetByteSizeOfBaseMipLevel());
   return OnCreateTexture(desc);
 }
 
@@ -4,6 +4,7 @@
 
 #include "impeller/core/texture.h"
 
+#include "flutter/fml/frame_counters.h"
 #include "impeller/base/validation.h"
 
 namespace impeller {
@@ -23,6 +24,7 @@ bool Texture::SetContents(const uint8_t* contents,
   if (!OnSetContents(contents, length, slice)) {
     return false;
   }
+  fml::FrameCounters::Add(fml::FrameCounters::kTextureUploads);
   intent_ = TextureIntent::kUploadFromHost;
   is_opaque_ = is_opaque;
   return true;
@@ -41,6 +43,7 @@ bool Texture::SetContents(std::shared_ptr<const fml::Mapping> mapping,
   if (!OnSetContents(std::move(mapping), slice)) {
     return false;
   }
+  fml::FrameCounters::Add(fml::FrameCounters::kTextureUploads);
   intent_ = TextureIntent::kUploadFromHost;
   is_opaque_ = is_opaque;
   return true;
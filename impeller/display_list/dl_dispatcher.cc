@@ -1105,9 +1105,12 @@ void DlDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                 SkScalar x,
                                 SkScalar y) {
   Scalar scale = canvas_.GetCurrentTransformation().GetMaxBasisLengthXY();
-  canvas_.DrawTextFrame(TextFrameFromTextBlob(blob, scale),  //
-                        impeller::Point{x, y},               //
-                        paint_                               //
+  auto text_frame = TextFrameFromTextBlob(blob, scale);
+  text_frame.SetPrefersSignedDistanceField(
+      prefers_signed_distance_field_text_);
+  canvas_.DrawTextFrame(text_frame,             //
+                        impeller::Point{x, y},  //
+                        paint_                  //
   );
 }
 
@@ -1188,4 +1191,9 @@ Picture DlDispatcher::EndRecordingAsPicture() {
   return canvas_.EndRecordingAsPicture();
 }
 
+void DlDispatcher::SetPrefersSignedDistanceFieldText(
+    bool prefers_signed_distance_field) {
+  prefers_signed_distance_field_text_ = prefers_signed_distance_field;
+}
+
 }  // namespace impeller
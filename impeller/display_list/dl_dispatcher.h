@@ -23,6 +23,14 @@ class DlDispatcher final : public flutter::DlOpReceiver {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render the text blobs dispatched from now on from a signed
+  ///             distance field glyph atlas, see
+  ///             |TextFrame::SetPrefersSignedDistanceField|. Disabled by
+  ///             default.
+  ///
+  void SetPrefersSignedDistanceFieldText(bool prefers_signed_distance_field);
+
   // |flutter::DlOpReceiver|
   void setAntiAlias(bool aa) override;
 
@@ -223,6 +231,7 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  bool prefers_signed_distance_field_text_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DlDispatcher);
 };
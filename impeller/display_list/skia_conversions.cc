@@ -4,9 +4,22 @@
 
 #include "impeller/display_list/skia_conversions.h"
 
+#include "flutter/fml/thread_local.h"
+
 namespace impeller {
 namespace skia_conversions {
 
+// Paths are converted many times per frame. Reusing a builder per thread
+// avoids growing the path storage from scratch for every conversion.
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<PathBuilder> tls_path_builder;
+
+static PathBuilder& GetThreadLocalPathBuilder() {
+  if (tls_path_builder.get() == nullptr) {
+    tls_path_builder.reset(new PathBuilder());
+  }
+  return tls_path_builder.get()->Reset();
+}
+
 Rect ToRect(const SkRect& rect) {
   return Rect::MakeLTRB(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
 }
@@ -53,7 +66,7 @@ Path ToPath(const SkPath& path) {
     };
   };
 
-  PathBuilder builder;
+  auto& builder = GetThreadLocalPathBuilder();
   PathData data;
   auto verb = SkPath::Verb::kDone_Verb;
   do {
@@ -119,11 +132,15 @@ Path ToPath(const SkPath& path) {
   }
   builder.SetConvexity(path.isConvex() ? Convexity::kConvex
                                        : Convexity::kUnknown);
-  return builder.TakePath(fill_type);
+  auto result = builder.TakePath(fill_type);
+  // SkPaths that share a generation ID share the same immutable path data.
+  // This lets derived data such as tessellations be reused across frames.
+  result.SetIdentity(path.getGenerationID());
+  return result;
 }
 
 Path ToPath(const SkRRect& rrect) {
-  return PathBuilder{}
+  return GetThreadLocalPathBuilder()
       .AddRoundedRect(ToRect(rrect.getBounds()), ToRoundingRadii(rrect))
       .SetConvexity(Convexity::kConvex)
       .TakePath();
@@ -76,6 +76,15 @@ bool ClipContents::CanInheritOpacity(const Entity& entity) const {
 
 void ClipContents::SetInheritedOpacity(Scalar opacity) {}
 
+std::optional<TessellationJob> ClipContents::GetTessellationJob(
+    const ContentContext& renderer,
+    const Entity& entity) const {
+  if (!geometry_) {
+    return std::nullopt;
+  }
+  return geometry_->GetTessellationJob(renderer, entity);
+}
+
 bool ClipContents::Render(const ContentContext& renderer,
                           const Entity& entity,
                           RenderPass& pass) const {
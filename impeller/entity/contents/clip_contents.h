@@ -47,6 +47,11 @@ class ClipContents final : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  std::optional<TessellationJob> GetTessellationJob(
+      const ContentContext& renderer,
+      const Entity& entity) const override;
+
  private:
   std::unique_ptr<Geometry> geometry_;
   Entity::ClipOperation clip_op_ = Entity::ClipOperation::kIntersect;
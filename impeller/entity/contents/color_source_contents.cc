@@ -51,6 +51,15 @@ void ColorSourceContents::SetInheritedOpacity(Scalar opacity) {
   inherited_opacity_ = opacity;
 }
 
+std::optional<TessellationJob> ColorSourceContents::GetTessellationJob(
+    const ContentContext& renderer,
+    const Entity& entity) const {
+  if (!geometry_) {
+    return std::nullopt;
+  }
+  return geometry_->GetTessellationJob(renderer, entity);
+}
+
 bool ColorSourceContents::ShouldRender(
     const Entity& entity,
     const std::optional<Rect>& stencil_coverage) const {
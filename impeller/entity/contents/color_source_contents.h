@@ -39,6 +39,11 @@ class ColorSourceContents : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  std::optional<TessellationJob> GetTessellationJob(
+      const ContentContext& renderer,
+      const Entity& entity) const override;
+
   Scalar GetOpacity() const;
 
   const std::shared_ptr<Geometry>& GetGeometry() const;
@@ -7,9 +7,13 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/thread_local.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/entity/pipeline_variant_profile.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_pass.h"
@@ -18,6 +22,16 @@
 
 namespace impeller {
 
+namespace {
+
+// The tessellators of threads other than the one that created the content
+// context, such as the workers recording subpasses. Tessellators keep scratch
+// buffers and cannot be shared between threads.
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<std::shared_ptr<Tessellator>>
+    tls_tessellator;
+
+}  // namespace
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -158,13 +172,19 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
 
 ContentContext::ContentContext(std::shared_ptr<Context> context)
     : context_(std::move(context)),
+      tessellator_thread_id_(std::this_thread::get_id()),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(std::make_shared<TessellationCache>()),
+      pipeline_variant_profile_(std::make_shared<PipelineVariantProfile>()),
       alpha_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
       color_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
+      sdf_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
       scene_context_(std::make_shared<scene::SceneContext>(context_)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  render_target_cache_ =
+      std::make_shared<RenderTargetCache>(context_->GetResourceAllocator());
   auto default_options = ContentContextOptions{
       .color_attachment_pixel_format =
           context_->GetCapabilities()->GetDefaultColorFormat()};
@@ -293,6 +313,8 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
   glyph_atlas_color_pipelines_[default_options] =
       CreateDefaultPipeline<GlyphAtlasColorPipeline>(*context_);
+  glyph_atlas_sdf_pipelines_[default_options] =
+      CreateDefaultPipeline<GlyphAtlasSdfPipeline>(*context_);
   geometry_color_pipelines_[default_options] =
       CreateDefaultPipeline<GeometryColorPipeline>(*context_);
   yuv_to_rgb_filter_pipelines_[default_options] =
@@ -351,11 +373,13 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   RenderTarget subpass_target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *GetRenderTargetCache(), texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfigMSAA, std::nullopt);
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *GetRenderTargetCache(), texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfig, std::nullopt);
   }
   auto subpass_texture = subpass_target.GetRenderTargetTexture();
@@ -391,13 +415,103 @@ std::shared_ptr<scene::SceneContext> ContentContext::GetSceneContext() const {
 }
 
 std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
-  return tessellator_;
+  auto thread_id = std::this_thread::get_id();
+  if (thread_id == tessellator_thread_id_) {
+    return tessellator_;
+  }
+  if (tls_tessellator.get() == nullptr) {
+    tls_tessellator.reset(
+        new std::shared_ptr<Tessellator>(std::make_shared<Tessellator>()));
+  }
+  return *tls_tessellator.get();
+}
+
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<RenderTargetCache> ContentContext::GetRenderTargetCache()
+    const {
+  return render_target_cache_;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ContentContext::GetSubpassTaskRunner() const {
+  if (!concurrent_subpasses_enabled_) {
+    return nullptr;
+  }
+  return context_->GetConcurrentWorkerTaskRunner();
+}
+
+void ContentContext::SetConcurrentSubpassesEnabled(bool enabled) {
+  concurrent_subpasses_enabled_ = enabled;
+}
+
+std::shared_ptr<PipelineVariantProfile>
+ContentContext::GetPipelineVariantProfile() const {
+  return pipeline_variant_profile_;
+}
+
+size_t ContentContext::PrewarmPipelineVariants(
+    const PipelineVariantProfile& profile) const {
+  if (!IsValid()) {
+    return 0u;
+  }
+  auto pipeline_library = context_->GetPipelineLibrary();
+  // Prewarming is much cheaper when the driver has the binaries of the
+  // variants cached, which makes a difference for the first frames.
+  TRACE_EVENT1("impeller", __FUNCTION__, "pipeline_cache_warm",
+               pipeline_library->IsPipelineCacheWarm() ? "true" : "false");
+  Lock lock(pipelines_mutex_);
+  std::vector<PipelineDescriptor> descriptors;
+  std::vector<PipelineEmplacer> emplacers;
+  std::unordered_map<const void*, size_t> queued_variant_counts;
+  for (const auto& entry : profile.GetEntries()) {
+    VisitPipelineVariants([&](const char* name, auto& variants) {
+      if (entry.pipeline != name) {
+        return;
+      }
+      auto& queued = queued_variant_counts[&variants];
+      if (PrewarmPipelineVariant(variants, entry.options,
+                                 variants.size() + queued, descriptors,
+                                 emplacers)) {
+        queued++;
+      }
+      // Keep the entry so that it is persisted again even though the variant
+      // will not be created on first use.
+      pipeline_variant_profile_->Record(entry.pipeline, entry.options);
+    });
+  }
+  auto futures = pipeline_library->PrecreatePipelines(descriptors);
+  FML_DCHECK(futures.size() == emplacers.size());
+  for (size_t i = 0; i < futures.size(); i++) {
+    emplacers[i](std::move(futures[i]));
+  }
+  return futures.size();
+}
+
+void ContentContext::RecordPipelineVariant(
+    const void* variants,
+    const ContentContextOptions& opts) const {
+  VisitPipelineVariants([&](const char* name, const auto& candidate) {
+    if (static_cast<const void*>(&candidate) == variants) {
+      pipeline_variant_profile_->Record(name, opts);
+    }
+  });
 }
 
 std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext(
     GlyphAtlas::Type type) const {
-  return type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_atlas_context_
-                                                : color_glyph_atlas_context_;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_glyph_atlas_context_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_glyph_atlas_context_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_glyph_atlas_context_;
+  }
+  FML_UNREACHABLE();
 }
 
 std::shared_ptr<Context> ContentContext::GetContext() const {
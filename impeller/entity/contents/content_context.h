@@ -4,13 +4,20 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/entity.h"
@@ -33,6 +40,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -175,6 +183,8 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<BlendVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
@@ -328,6 +338,9 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class TessellationCache;
+class RenderTargetCache;
+class PipelineVariantProfile;
 
 class ContentContext {
  public:
@@ -339,8 +352,51 @@ class ContentContext {
 
   std::shared_ptr<scene::SceneContext> GetSceneContext() const;
 
+  /// @brief  The tessellator for the calling thread. Tessellators are not
+  ///         thread safe, so threads other than the one that created this
+  ///         context (such as workers recording subpasses concurrently) each
+  ///         get one of their own.
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief  A cache of path tessellations that persists across frames.
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  /// @brief  The allocator used for the render targets of subpasses. Textures
+  ///         are recycled across frames delimited by calls to
+  ///         |RenderTargetAllocator::Start| and |RenderTargetAllocator::End|.
+  std::shared_ptr<RenderTargetCache> GetRenderTargetCache() const;
+
+  /// @brief  The task runner that independent subpasses are recorded on,
+  ///         which is the worker task runner of the context, or nullptr if
+  ///         there is none or concurrent subpasses are disabled.
+  ///
+  ///         Recording may wait for pipelines that the pipeline library
+  ///         builds on the same workers. Workers run the pending tasks of the
+  ///         pool while they wait, see |WaitForPipeline|.
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetSubpassTaskRunner() const;
+
+  /// @brief  Whether independent subpasses may be recorded concurrently on
+  ///         the task runner returned by |GetSubpassTaskRunner|, which
+  ///         returns nullptr otherwise. Enabled by default.
+  void SetConcurrentSubpassesEnabled(bool enabled);
+
+  /// @brief  The pipeline variants that were created by this context, either
+  ///         on first use or by |PrewarmPipelineVariants|.
+  std::shared_ptr<PipelineVariantProfile> GetPipelineVariantProfile() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start building the pipeline variants of a profile recorded by
+  ///             a previous run so that they are ready when first used.
+  ///
+  ///             Variants are built asynchronously by the pipeline library of
+  ///             the context and are only waited on when they are first used.
+  ///             Entries for pipelines that are unknown or not supported by
+  ///             this device are ignored.
+  ///
+  /// @return     The number of variants whose creation was started.
+  ///
+  size_t PrewarmPipelineVariants(const PipelineVariantProfile& profile) const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -482,6 +538,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -749,6 +810,7 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -816,38 +878,217 @@ class ContentContext {
       opts.wireframe = true;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    // The lock only guards the containers. Pipelines are waited for without
+    // holding it, so that threads recording subpasses concurrently don't wait
+    // for pipelines that other threads are waiting to be built.
+    bool has_variant = false;
+    PipelineFuture<PipelineDescriptor> variant_future;
+    PipelineFuture<PipelineDescriptor> prototype_future;
+    {
+      Lock lock(pipelines_mutex_);
+      if (auto found = container.find(opts); found != container.end()) {
+        has_variant = true;
+        variant_future = found->second->GetPipelineFuture();
+      } else {
+        auto prototype = container.find(
+            {.color_attachment_pixel_format =
+                 context_->GetCapabilities()->GetDefaultColorFormat()});
+
+        // The prototype must always be initialized in the constructor.
+        FML_CHECK(prototype != container.end());
+        prototype_future = prototype->second->GetPipelineFuture();
+      }
+    }
+    if (has_variant) {
+      return WaitForPipeline(variant_future);
     }
 
-    auto prototype = container.find(
-        {.color_attachment_pixel_format =
-             context_->GetCapabilities()->GetDefaultColorFormat()});
+    auto pipeline = WaitForPipeline(prototype_future);
+    if (!pipeline) {
+      return nullptr;
+    }
 
-    // The prototype must always be initialized in the constructor.
-    FML_CHECK(prototype != container.end());
+    {
+      Lock lock(pipelines_mutex_);
+      // Another thread may have created the variant while this one waited.
+      auto found = container.find(opts);
+      if (found == container.end()) {
+        auto variant_count = container.size();
+        auto variant = std::make_unique<TypedPipeline>(pipeline->CreateVariant(
+            [&opts, variant_count](PipelineDescriptor& desc) {
+              opts.ApplyToPipelineDescriptor(desc);
+              desc.SetLabel(
+                  SPrintF("%s V#%zu", desc.GetLabel().c_str(), variant_count));
+            }));
+        found = container.emplace(opts, std::move(variant)).first;
+        RecordPipelineVariant(&container, opts);
+      }
+      variant_future = found->second->GetPipelineFuture();
+    }
+    return WaitForPipeline(variant_future);
+  }
 
-    auto pipeline = prototype->second->WaitAndGet();
-    if (!pipeline) {
+  std::shared_ptr<Pipeline<PipelineDescriptor>> WaitForPipeline(
+      const PipelineFuture<PipelineDescriptor>& future) const {
+    if (!future.IsValid()) {
       return nullptr;
     }
+    // A worker recording a subpass must not block on a pipeline that is
+    // queued behind it on the same workers, so it runs the pending tasks
+    // until the pipeline is ready or none are left.
+    if (auto task_runner = context_->GetConcurrentWorkerTaskRunner()) {
+      while (future.future.wait_for(std::chrono::seconds(0)) !=
+                 std::future_status::ready &&
+             task_runner->RunPendingTaskOnWorker()) {
+      }
+    }
+    return future.Get();
+  }
 
-    auto variant_future = pipeline->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
+  using PipelineEmplacer =
+      std::function<void(PipelineFuture<PipelineDescriptor> future)>;
+
+  // Appends the descriptor of a variant that doesn't exist yet to
+  // |descriptors|, along with a callback that stores the variant once the
+  // pipeline library started creating it.
+  template <class TypedPipeline>
+  bool PrewarmPipelineVariant(Variants<TypedPipeline>& container,
+                              ContentContextOptions opts,
+                              size_t variant_index,
+                              std::vector<PipelineDescriptor>& descriptors,
+                              std::vector<PipelineEmplacer>& emplacers) const {
+    if (wireframe_) {
+      opts.wireframe = true;
+    }
+
+    if (container.find(opts) != container.end()) {
+      return false;
+    }
+
+    auto prototype = container.find(
+        {.color_attachment_pixel_format =
+             context_->GetCapabilities()->GetDefaultColorFormat()});
+    // Pipelines not supported by the device have no prototype.
+    if (prototype == container.end()) {
+      return false;
+    }
+
+    // Unlike |GetPipeline|, this doesn't wait for the prototype to be built.
+    auto desc = prototype->second->GetDescriptor();
+    if (!desc.has_value()) {
+      return false;
+    }
+    opts.ApplyToPipelineDescriptor(desc.value());
+    desc->SetLabel(
+        SPrintF("%s V#%zu", desc->GetLabel().c_str(), variant_index));
+    descriptors.push_back(std::move(desc.value()));
+    emplacers.push_back(
+        [&container, opts](PipelineFuture<PipelineDescriptor> future) {
+          container.try_emplace(
+              opts, std::make_unique<TypedPipeline>(std::move(future)));
         });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container[opts] = std::move(variant);
-    return variant_pipeline;
+    return true;
+  }
+
+  // Calls `visitor(name, variants)` for the variants of every pipeline. The
+  // names identify the pipelines in persisted |PipelineVariantProfile|s and
+  // must not change.
+  template <class Visitor>
+  void VisitPipelineVariants(Visitor&& visitor) const {
+#ifdef IMPELLER_DEBUG
+    visitor("checkerboard", checkerboard_pipelines_);
+#endif  // IMPELLER_DEBUG
+    visitor("solid_fill", solid_fill_pipelines_);
+    visitor("linear_gradient_fill", linear_gradient_fill_pipelines_);
+    visitor("radial_gradient_fill", radial_gradient_fill_pipelines_);
+    visitor("conical_gradient_fill", conical_gradient_fill_pipelines_);
+    visitor("sweep_gradient_fill", sweep_gradient_fill_pipelines_);
+    visitor("linear_gradient_ssbo_fill", linear_gradient_ssbo_fill_pipelines_);
+    visitor("radial_gradient_ssbo_fill", radial_gradient_ssbo_fill_pipelines_);
+    visitor("conical_gradient_ssbo_fill",
+            conical_gradient_ssbo_fill_pipelines_);
+    visitor("sweep_gradient_ssbo_fill", sweep_gradient_ssbo_fill_pipelines_);
+    visitor("rrect_blur", rrect_blur_pipelines_);
+    visitor("texture_blend", texture_blend_pipelines_);
+    visitor("texture", texture_pipelines_);
+    visitor("position_uv", position_uv_pipelines_);
+    visitor("tiled_texture", tiled_texture_pipelines_);
+    visitor("gaussian_blur_alpha_decal", gaussian_blur_alpha_decal_pipelines_);
+    visitor("gaussian_blur_alpha_nodecal",
+            gaussian_blur_alpha_nodecal_pipelines_);
+    visitor("gaussian_blur_noalpha_decal",
+            gaussian_blur_noalpha_decal_pipelines_);
+    visitor("gaussian_blur_noalpha_nodecal",
+            gaussian_blur_noalpha_nodecal_pipelines_);
+    visitor("border_mask_blur", border_mask_blur_pipelines_);
+    visitor("morphology_filter", morphology_filter_pipelines_);
+    visitor("color_matrix_color_filter", color_matrix_color_filter_pipelines_);
+    visitor("linear_to_srgb_filter", linear_to_srgb_filter_pipelines_);
+    visitor("srgb_to_linear_filter", srgb_to_linear_filter_pipelines_);
+    visitor("clip", clip_pipelines_);
+    visitor("glyph_atlas", glyph_atlas_pipelines_);
+    visitor("glyph_atlas_color", glyph_atlas_color_pipelines_);
+    visitor("glyph_atlas_sdf", glyph_atlas_sdf_pipelines_);
+    visitor("geometry_color", geometry_color_pipelines_);
+    visitor("yuv_to_rgb_filter", yuv_to_rgb_filter_pipelines_);
+    visitor("porter_duff_blend", porter_duff_blend_pipelines_);
+    visitor("blend_color", blend_color_pipelines_);
+    visitor("blend_colorburn", blend_colorburn_pipelines_);
+    visitor("blend_colordodge", blend_colordodge_pipelines_);
+    visitor("blend_darken", blend_darken_pipelines_);
+    visitor("blend_difference", blend_difference_pipelines_);
+    visitor("blend_exclusion", blend_exclusion_pipelines_);
+    visitor("blend_hardlight", blend_hardlight_pipelines_);
+    visitor("blend_hue", blend_hue_pipelines_);
+    visitor("blend_lighten", blend_lighten_pipelines_);
+    visitor("blend_luminosity", blend_luminosity_pipelines_);
+    visitor("blend_multiply", blend_multiply_pipelines_);
+    visitor("blend_overlay", blend_overlay_pipelines_);
+    visitor("blend_saturation", blend_saturation_pipelines_);
+    visitor("blend_screen", blend_screen_pipelines_);
+    visitor("blend_softlight", blend_softlight_pipelines_);
+    visitor("framebuffer_blend_color", framebuffer_blend_color_pipelines_);
+    visitor("framebuffer_blend_colorburn",
+            framebuffer_blend_colorburn_pipelines_);
+    visitor("framebuffer_blend_colordodge",
+            framebuffer_blend_colordodge_pipelines_);
+    visitor("framebuffer_blend_darken", framebuffer_blend_darken_pipelines_);
+    visitor("framebuffer_blend_difference",
+            framebuffer_blend_difference_pipelines_);
+    visitor("framebuffer_blend_exclusion",
+            framebuffer_blend_exclusion_pipelines_);
+    visitor("framebuffer_blend_hardlight",
+            framebuffer_blend_hardlight_pipelines_);
+    visitor("framebuffer_blend_hue", framebuffer_blend_hue_pipelines_);
+    visitor("framebuffer_blend_lighten", framebuffer_blend_lighten_pipelines_);
+    visitor("framebuffer_blend_luminosity",
+            framebuffer_blend_luminosity_pipelines_);
+    visitor("framebuffer_blend_multiply",
+            framebuffer_blend_multiply_pipelines_);
+    visitor("framebuffer_blend_overlay", framebuffer_blend_overlay_pipelines_);
+    visitor("framebuffer_blend_saturation",
+            framebuffer_blend_saturation_pipelines_);
+    visitor("framebuffer_blend_screen", framebuffer_blend_screen_pipelines_);
+    visitor("framebuffer_blend_softlight",
+            framebuffer_blend_softlight_pipelines_);
   }
 
+  void RecordPipelineVariant(const void* variants,
+                             const ContentContextOptions& opts) const;
+
   bool is_valid_ = false;
+  // Guards the pipeline variant containers, which are populated on first use
+  // by subpasses that may be recorded concurrently (see |EntityPass|).
+  mutable Mutex pipelines_mutex_;
+  bool concurrent_subpasses_enabled_ = true;
+  std::thread::id tessellator_thread_id_;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<RenderTargetCache> render_target_cache_;
+  std::shared_ptr<PipelineVariantProfile> pipeline_variant_profile_;
   std::shared_ptr<GlyphAtlasContext> alpha_glyph_atlas_context_;
   std::shared_ptr<GlyphAtlasContext> color_glyph_atlas_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_glyph_atlas_context_;
   std::shared_ptr<scene::SceneContext> scene_context_;
   bool wireframe_ = false;
 
@@ -118,6 +118,12 @@ void Contents::SetInheritedOpacity(Scalar opacity) {
                     "Contents::CanAcceptOpacity returns false.";
 }
 
+std::optional<TessellationJob> Contents::GetTessellationJob(
+    const ContentContext& renderer,
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
 bool Contents::ShouldRender(const Entity& entity,
                             const std::optional<Rect>& stencil_coverage) const {
   if (!stencil_coverage.has_value()) {
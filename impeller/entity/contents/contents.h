@@ -14,6 +14,7 @@
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/renderer/snapshot.h"
+#include "impeller/tessellator/batch_tessellator.h"
 
 namespace impeller {
 
@@ -117,6 +118,15 @@ class Contents {
   ///        Use of this method is invalid if CanAcceptOpacity returns false.
   virtual void SetInheritedOpacity(Scalar opacity);
 
+  /// @brief Returns path tessellation work needed to render this contents
+  ///        with the given entity that may be performed ahead of time on a
+  ///        worker thread. See `Geometry::GetTessellationJob`.
+  ///
+  ///        By default contents have no such work.
+  virtual std::optional<TessellationJob> GetTessellationJob(
+      const ContentContext& renderer,
+      const Entity& entity) const;
+
  private:
   std::optional<Rect> coverage_hint_;
   std::optional<Size> color_source_size_;
@@ -6,6 +6,7 @@
 
 #include <optional>
 #include <type_traits>
+#include <vector>
 #include <utility>
 
 #include "impeller/core/formats.h"
@@ -89,21 +90,13 @@ static bool CommonRender(const ContentContext& renderer,
   using VS = GlyphAtlasPipeline::VertexShader;
   using FS = GlyphAtlasPipeline::FragmentShader;
 
-  // Common vertex uniforms for all glyphs.
-  VS::FrameInfo frame_info;
-  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
-  frame_info.atlas_size =
-      Vector2{static_cast<Scalar>(atlas->GetTexture()->GetSize().width),
-              static_cast<Scalar>(atlas->GetTexture()->GetSize().height)};
-  frame_info.offset = offset;
-  frame_info.is_translation_scale =
+  const bool is_translation_scale =
       entity.GetTransformation().IsTranslationScaleOnly();
-  frame_info.entity_transform = entity.GetTransformation();
-
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  const auto atlas_type = atlas->GetType();
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (is_translation_scale &&
+      atlas_type != GlyphAtlas::Type::kSignedDistanceField) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -112,22 +105,19 @@ static bool CommonRender(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Signed distance fields are drawn at arbitrary scales and are always
+    // sampled linearly.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNearest;
+  auto sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
 
   FS::FragInfo frag_info;
   frag_info.text_color = ToVector(color.Premultiply());
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
 
-  FS::BindGlyphAtlasSampler(
-      cmd,                  // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
-
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
   // unit-sized quad. The size of the glyph is specified in per instance data
@@ -139,56 +129,99 @@ static bool CommonRender(const ContentContext& renderer,
                                                 Point{0, 1}, Point{1, 0},
                                                 Point{0, 1}, Point{1, 1}};
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  size_t vertex_count = 0;
+  // Look up every glyph once and count the glyphs on each page of the atlas.
+  // Glyphs on different pages are drawn by separate commands.
+  const size_t page_count = atlas->GetPageCount();
+  std::vector<size_t> page_glyph_counts(page_count, 0u);
+  std::vector<std::optional<GlyphAtlas::Location>> glyph_locations;
   for (const auto& run : frame.GetRuns()) {
-    vertex_count += run.GetGlyphPositions().size();
+    const Font font = GlyphAtlas::GetAtlasFont(atlas_type, run.GetFont());
+    for (const auto& glyph_position : run.GetGlyphPositions()) {
+      FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
+      auto location = atlas->FindFontGlyphLocation(font_glyph_pair);
+      if (!location.has_value() || location->page >= page_count) {
+        VALIDATION_LOG << "Could not find glyph position in the atlas.";
+        location = std::nullopt;
+      } else {
+        page_glyph_counts[location->page]++;
+      }
+      glyph_locations.push_back(location);
+    }
   }
-  vertex_count *= 6;
-
-  auto buffer_view = host_buffer.Emplace(
-      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
-      [&](uint8_t* contents) {
-        VS::PerVertexData vtx;
-        size_t vertex_offset = 0;
-        for (const auto& run : frame.GetRuns()) {
-          const Font& font = run.GetFont();
-          for (const auto& glyph_position : run.GetGlyphPositions()) {
-            FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
-            auto maybe_atlas_glyph_bounds =
-                atlas->FindFontGlyphBounds(font_glyph_pair);
-            if (!maybe_atlas_glyph_bounds.has_value()) {
-              VALIDATION_LOG << "Could not find glyph position in the atlas.";
-              continue;
-            }
-            auto atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
-            vtx.atlas_glyph_bounds = Vector4(
-                atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
-                atlas_glyph_bounds.size.width, atlas_glyph_bounds.size.height);
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.origin.x,
-                                       glyph_position.glyph.bounds.origin.y,
-                                       glyph_position.glyph.bounds.size.width,
-                                       glyph_position.glyph.bounds.size.height);
-            vtx.glyph_position = glyph_position.position;
-
-            for (const auto& point : unit_points) {
-              vtx.unit_position = point;
-              ::memcpy(contents + vertex_offset, &vtx,
-                       sizeof(VS::PerVertexData));
-              vertex_offset += sizeof(VS::PerVertexData);
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  for (size_t page = 0; page < page_count; page++) {
+    if (page_glyph_counts[page] == 0u) {
+      continue;
+    }
+    auto texture = atlas->GetTexture(page);
+
+    Command page_cmd = cmd;
+
+    // Common vertex uniforms for all glyphs on the page.
+    VS::FrameInfo frame_info;
+    frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+    frame_info.atlas_size =
+        Vector2{static_cast<Scalar>(texture->GetSize().width),
+                static_cast<Scalar>(texture->GetSize().height)};
+    frame_info.offset = offset;
+    frame_info.is_translation_scale = is_translation_scale;
+    frame_info.entity_transform = entity.GetTransformation();
+
+    VS::BindFrameInfo(page_cmd, host_buffer.EmplaceUniform(frame_info));
+
+    FS::BindGlyphAtlasSampler(page_cmd,  // command
+                              texture,   // texture
+                              sampler    // sampler
+    );
+
+    const size_t vertex_count = page_glyph_counts[page] * unit_points.size();
+    auto buffer_view = host_buffer.Emplace(
+        vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          VS::PerVertexData vtx;
+          size_t vertex_offset = 0;
+          size_t glyph_index = 0;
+          for (const auto& run : frame.GetRuns()) {
+            for (const auto& glyph_position : run.GetGlyphPositions()) {
+              const auto& location = glyph_locations[glyph_index++];
+              if (!location.has_value() || location->page != page) {
+                continue;
+              }
+              const auto& atlas_glyph_bounds = location->bounds;
+              vtx.atlas_glyph_bounds = Vector4(
+                  atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
+                  atlas_glyph_bounds.size.width,
+                  atlas_glyph_bounds.size.height);
+              vtx.glyph_bounds =
+                  Vector4(glyph_position.glyph.bounds.origin.x,
+                          glyph_position.glyph.bounds.origin.y,
+                          glyph_position.glyph.bounds.size.width,
+                          glyph_position.glyph.bounds.size.height);
+              vtx.glyph_position = glyph_position.position;
+
+              for (const auto& point : unit_points) {
+                vtx.unit_position = point;
+                ::memcpy(contents + vertex_offset, &vtx,
+                         sizeof(VS::PerVertexData));
+                vertex_offset += sizeof(VS::PerVertexData);
+              }
             }
           }
-        }
-      });
-
-  cmd.BindVertices({
-      .vertex_buffer = buffer_view,
-      .index_buffer = {},
-      .vertex_count = vertex_count,
-      .index_type = IndexType::kNone,
-  });
-
-  return pass.AddCommand(cmd);
+        });
+
+    page_cmd.BindVertices({
+        .vertex_buffer = buffer_view,
+        .index_buffer = {},
+        .vertex_count = vertex_count,
+        .index_type = IndexType::kNone,
+    });
+
+    if (!pass.AddCommand(std::move(page_cmd))) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool TextContents::Render(const ContentContext& renderer,
@@ -213,10 +246,16 @@ bool TextContents::Render(const ContentContext& renderer,
   cmd.label = "TextFrame";
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+      break;
   }
   cmd.stencil_reference = entity.GetStencilDepth();
 
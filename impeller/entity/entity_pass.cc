@@ -4,12 +4,15 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <variant>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/parallel_for.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -24,6 +27,7 @@
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/command.h"
@@ -36,6 +40,13 @@
 
 namespace impeller {
 
+namespace {
+
+/// Runs of fewer independent subpasses are rendered on the calling thread.
+constexpr size_t kMinConcurrentSubpasses = 2u;
+
+}  // namespace
+
 EntityPass::EntityPass() = default;
 
 EntityPass::~EntityPass() = default;
@@ -176,9 +187,10 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   RenderTarget target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
@@ -189,9 +201,10 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
     );
   } else {
     target = RenderTarget::CreateOffscreen(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfig{
             .storage_mode = StorageMode::kDevicePrivate,
             .load_action = LoadAction::kDontCare,
@@ -334,7 +347,8 @@ bool EntityPass::Render(ContentContext& renderer,
   // provided by the caller.
   else {
     root_render_target.SetupStencilAttachment(
-        *renderer.GetContext(), color0.texture->GetSize(),
+        *renderer.GetContext(), *renderer.GetRenderTargetCache(),
+        color0.texture->GetSize(),
         renderer.GetContext()->GetCapabilities()->SupportsOffscreenMSAA(),
         "ImpellerOnscreen",
         GetDefaultStencilConfig(reads_from_onscreen_backdrop));
@@ -434,106 +448,281 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       pass_context.EndPass();
     }
 
-    if (stencil_coverage_stack.empty()) {
-      // The current clip is empty. This means the pass texture won't be
-      // visible, so skip it.
-      return EntityPass::EntityResult::Skip();
-    }
-    auto stencil_coverage_back = stencil_coverage_stack.back().coverage;
-    if (!stencil_coverage_back.has_value()) {
-      return EntityPass::EntityResult::Skip();
+    auto pass_size =
+        pass_context.GetPassTarget().GetRenderTarget().GetRenderTargetSize();
+    std::optional<SubpassTarget> subpass_target;
+    auto status = CreateSubpassTarget(
+        *subpass, renderer, root_pass_size, pass_size, global_pass_position,
+        stencil_coverage_stack, backdrop_filter_contents != nullptr,
+        subpass_target);
+    if (status != EntityResult::kSuccess) {
+      return {{}, status};
     }
 
-    // The maximum coverage of the subpass. Subpasses textures should never
-    // extend outside the parent pass texture or the current clip coverage.
-    auto coverage_limit =
-        Rect(global_pass_position, Size(pass_context.GetPassTarget()
-                                            .GetRenderTarget()
-                                            .GetRenderTargetSize()))
-            .Intersection(stencil_coverage_back.value());
-    if (!coverage_limit.has_value()) {
-      return EntityPass::EntityResult::Skip();
+    // Stencil textures aren't shared between EntityPasses (as much of the
+    // time they are transient).
+    if (!subpass->OnRender(
+            renderer,                         // renderer
+            root_pass_size,                   // root_pass_size
+            subpass_target->target,           // pass_target
+            subpass_target->coverage.origin,  // global_pass_position
+            subpass_target->coverage.origin -
+                global_pass_position,  // local_pass_position
+            ++pass_depth,              // pass_depth
+            stencil_coverage_stack,    // stencil_coverage_stack
+            subpass->stencil_depth_,   // stencil_depth_floor
+            backdrop_filter_contents   // backdrop_filter_contents
+            )) {
+      // Validation error messages are triggered for all `OnRender()` failure
+      // cases.
+      return EntityPass::EntityResult::Failure();
     }
 
-    coverage_limit =
-        coverage_limit->Intersection(Rect::MakeSize(root_pass_size));
-    if (!coverage_limit.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
+    return GetEntityForSubpassTarget(*subpass, subpass_target.value(),
+                                     global_pass_position);
+  } else {
+    FML_UNREACHABLE();
+  }
 
-    auto subpass_coverage = (subpass->flood_clip_ || backdrop_filter_contents)
-                                ? coverage_limit
-                                : GetSubpassCoverage(*subpass, coverage_limit);
-    if (!subpass_coverage.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
+  return EntityPass::EntityResult::Success(element_entity);
+}
 
-    auto subpass_size = ISize(subpass_coverage->size);
-    if (subpass_size.IsEmpty()) {
-      return EntityPass::EntityResult::Skip();
-    }
+bool EntityPass::IsIndependentSubpass(const Element& element) {
+  const auto subpass_ptr = std::get_if<std::unique_ptr<EntityPass>>(&element);
+  if (!subpass_ptr) {
+    return false;
+  }
+  auto subpass = subpass_ptr->get();
+  // Backdrop filters read from the parent pass, and collapsed subpasses are
+  // recorded into the render pass of the parent.
+  return !subpass->backdrop_filter_proc_.has_value() &&
+         !subpass->delegate_->CanElide() &&
+         !subpass->delegate_->CanCollapseIntoParentPass(subpass);
+}
 
-    auto subpass_target = CreateRenderTarget(
-        renderer,                                  // renderer
-        subpass_size,                              // size
-        subpass->GetTotalPassReads(renderer) > 0,  // readable
-        clear_color_.Premultiply());               // clear_color
+EntityPass::EntityResult::Status EntityPass::CreateSubpassTarget(
+    const EntityPass& subpass,
+    ContentContext& renderer,
+    ISize root_pass_size,
+    ISize pass_size,
+    Point global_pass_position,
+    const StencilCoverageStack& stencil_coverage_stack,
+    bool has_backdrop_filter,
+    std::optional<SubpassTarget>& subpass_target) const {
+  if (stencil_coverage_stack.empty()) {
+    // The current clip is empty. This means the pass texture won't be
+    // visible, so skip it.
+    return EntityResult::kSkip;
+  }
+  auto stencil_coverage_back = stencil_coverage_stack.back().coverage;
+  if (!stencil_coverage_back.has_value()) {
+    return EntityResult::kSkip;
+  }
 
-    if (!subpass_target.IsValid()) {
-      VALIDATION_LOG << "Subpass render target is invalid.";
-      return EntityPass::EntityResult::Failure();
-    }
+  // The maximum coverage of the subpass. Subpasses textures should never
+  // extend outside the parent pass texture or the current clip coverage.
+  auto coverage_limit = Rect(global_pass_position, Size(pass_size))
+                            .Intersection(stencil_coverage_back.value());
+  if (!coverage_limit.has_value()) {
+    return EntityResult::kSkip;
+  }
 
-    // Stencil textures aren't shared between EntityPasses (as much of the
-    // time they are transient).
-    if (!subpass->OnRender(renderer,                  // renderer
-                           root_pass_size,            // root_pass_size
-                           subpass_target,            // pass_target
-                           subpass_coverage->origin,  // global_pass_position
-                           subpass_coverage->origin -
-                               global_pass_position,  // local_pass_position
-                           ++pass_depth,              // pass_depth
-                           stencil_coverage_stack,    // stencil_coverage_stack
-                           subpass->stencil_depth_,   // stencil_depth_floor
-                           backdrop_filter_contents  // backdrop_filter_contents
-                           )) {
-      // Validation error messages are triggered for all `OnRender()` failure
-      // cases.
-      return EntityPass::EntityResult::Failure();
+  coverage_limit = coverage_limit->Intersection(Rect::MakeSize(root_pass_size));
+  if (!coverage_limit.has_value()) {
+    return EntityResult::kSkip;
+  }
+
+  auto subpass_coverage = (subpass.flood_clip_ || has_backdrop_filter)
+                              ? coverage_limit
+                              : GetSubpassCoverage(subpass, coverage_limit);
+  if (!subpass_coverage.has_value()) {
+    return EntityResult::kSkip;
+  }
+
+  auto subpass_size = ISize(subpass_coverage->size);
+  if (subpass_size.IsEmpty()) {
+    return EntityResult::kSkip;
+  }
+
+  auto target = CreateRenderTarget(
+      renderer,                                 // renderer
+      subpass_size,                             // size
+      subpass.GetTotalPassReads(renderer) > 0,  // readable
+      clear_color_.Premultiply());              // clear_color
+
+  if (!target.IsValid()) {
+    VALIDATION_LOG << "Subpass render target is invalid.";
+    return EntityResult::kFailure;
+  }
+
+  subpass_target.emplace(SubpassTarget{
+      .coverage = subpass_coverage.value(),
+      .target = target,
+  });
+  return EntityResult::kSuccess;
+}
+
+EntityPass::EntityResult EntityPass::GetEntityForSubpassTarget(
+    const EntityPass& subpass,
+    const SubpassTarget& subpass_target,
+    Point global_pass_position) const {
+  // The subpass target's texture may have changed during OnRender.
+  auto subpass_texture =
+      subpass_target.target.GetRenderTarget().GetRenderTargetTexture();
+
+  auto offscreen_texture_contents =
+      subpass.delegate_->CreateContentsForSubpassTarget(
+          subpass_texture,
+          Matrix::MakeTranslation(Vector3{-global_pass_position}) *
+              subpass.xformation_);
+
+  if (!offscreen_texture_contents) {
+    // This is an error because the subpass delegate said the pass couldn't
+    // be collapsed into its parent. Yet, when asked how it want's to
+    // postprocess the offscreen texture, it couldn't give us an answer.
+    //
+    // Theoretically, we could collapse the pass now. But that would be
+    // wasteful as we already have the offscreen texture and we don't want
+    // to discard it without ever using it. Just make the delegate do the
+    // right thing.
+    return EntityPass::EntityResult::Failure();
+  }
+
+  Entity element_entity;
+  element_entity.SetContents(std::move(offscreen_texture_contents));
+  element_entity.SetStencilDepth(subpass.stencil_depth_);
+  element_entity.SetBlendMode(subpass.blend_mode_);
+  element_entity.SetTransformation(Matrix::MakeTranslation(
+      Vector3(subpass_target.coverage.origin - global_pass_position)));
+  return EntityPass::EntityResult::Success(element_entity);
+}
+
+std::vector<EntityPass::EntityResult>
+EntityPass::GetEntitiesForIndependentSubpasses(
+    size_t first_element,
+    size_t count,
+    ContentContext& renderer,
+    InlinePassContext& pass_context,
+    ISize root_pass_size,
+    Point global_pass_position,
+    uint32_t pass_depth,
+    StencilCoverageStack& stencil_coverage_stack) const {
+  TRACE_EVENT0("impeller", "EntityPass::IndependentSubpasses");
+  std::vector<EntityResult> results(count, EntityResult::Skip());
+
+  // Independent subpasses don't change the parent pass, so the coverage of
+  // all of them is computed against the current clip up front.
+  auto pass_size =
+      pass_context.GetPassTarget().GetRenderTarget().GetRenderTargetSize();
+  std::vector<std::optional<SubpassTarget>> targets(count);
+  std::vector<size_t> visible;
+  for (size_t i = 0; i < count; i++) {
+    const auto& subpass =
+        *std::get<std::unique_ptr<EntityPass>>(elements_[first_element + i]);
+    auto status = CreateSubpassTarget(
+        subpass, renderer, root_pass_size, pass_size, global_pass_position,
+        stencil_coverage_stack, /*has_backdrop_filter=*/false, targets[i]);
+    if (status == EntityResult::kSuccess) {
+      visible.push_back(i);
+    } else {
+      results[i].status = status;
     }
+  }
 
-    // The subpass target's texture may have changed during OnRender.
-    auto subpass_texture =
-        subpass_target.GetRenderTarget().GetRenderTargetTexture();
-
-    auto offscreen_texture_contents =
-        subpass->delegate_->CreateContentsForSubpassTarget(
-            subpass_texture,
-            Matrix::MakeTranslation(Vector3{-global_pass_position}) *
-                subpass->xformation_);
-
-    if (!offscreen_texture_contents) {
-      // This is an error because the subpass delegate said the pass couldn't
-      // be collapsed into its parent. Yet, when asked how it want's to
-      // postprocess the offscreen texture, it couldn't give us an answer.
-      //
-      // Theoretically, we could collapse the pass now. But that would be
-      // wasteful as we already have the offscreen texture and we don't want
-      // to discard it without ever using it. Just make the delegate do the
-      // right thing.
-      return EntityPass::EntityResult::Failure();
+  // Each subpass appends to the clip coverage of its own copy of the stack.
+  std::vector<StencilCoverageStack> stencil_coverage_stacks(
+      count, stencil_coverage_stack);
+  fml::ParallelFor(
+      visible.size(),
+      [&](size_t index) {
+        auto i = visible[index];
+        const auto& subpass = *std::get<std::unique_ptr<EntityPass>>(
+            elements_[first_element + i]);
+        auto& subpass_target = targets[i].value();
+        // The command buffers of the subpass are created, recorded and
+        // submitted on the thread that runs this task.
+        if (!subpass.OnRender(
+                renderer,                        // renderer
+                root_pass_size,                  // root_pass_size
+                subpass_target.target,           // pass_target
+                subpass_target.coverage.origin,  // global_pass_position
+                subpass_target.coverage.origin -
+                    global_pass_position,    // local_pass_position
+                pass_depth + 1,              // pass_depth
+                stencil_coverage_stacks[i],  // stencil_coverage_stack
+                subpass.stencil_depth_       // stencil_depth_floor
+                )) {
+          // Validation error messages are triggered for all `OnRender()`
+          // failure cases.
+          results[i] = EntityResult::Failure();
+          return;
+        }
+        results[i].status = EntityResult::kSuccess;
+      },
+      renderer.GetSubpassTaskRunner(), "EntityPass::WorkerTask");
+
+  for (auto i : visible) {
+    if (results[i].status != EntityResult::kSuccess) {
+      continue;
     }
+    const auto& subpass =
+        *std::get<std::unique_ptr<EntityPass>>(elements_[first_element + i]);
+    results[i] = GetEntityForSubpassTarget(subpass, targets[i].value(),
+                                           global_pass_position);
+  }
 
-    element_entity.SetContents(std::move(offscreen_texture_contents));
-    element_entity.SetStencilDepth(subpass->stencil_depth_);
-    element_entity.SetBlendMode(subpass->blend_mode_);
-    element_entity.SetTransformation(Matrix::MakeTranslation(
-        Vector3(subpass_coverage->origin - global_pass_position)));
-  } else {
-    FML_UNREACHABLE();
+  // The clips of a subpass are restored by the parent after the subpass (see
+  // `Canvas::Restore`), so only the last subpass of a run can leave clip
+  // coverage behind for the parent to restore.
+  if (!visible.empty()) {
+    stencil_coverage_stack = std::move(stencil_coverage_stacks[visible.back()]);
   }
+  return results;
+}
 
-  return EntityPass::EntityResult::Success(element_entity);
+void EntityPass::PrepareTessellations(const ContentContext& renderer) const {
+  auto worker_task_runner =
+      renderer.GetContext()->GetConcurrentWorkerTaskRunner();
+  if (!worker_task_runner) {
+    return;
+  }
+
+  std::vector<TessellationJob> jobs;
+  for (const auto& element : elements_) {
+    auto entity = std::get_if<Entity>(&element);
+    if (!entity || !entity->GetContents()) {
+      continue;
+    }
+    // Elements are rendered with an additional translation only, so the
+    // scale the paths are tessellated at matches the one used when
+    // rendering.
+    auto job = entity->GetContents()->GetTessellationJob(renderer, *entity);
+    if (job.has_value()) {
+      jobs.push_back(job.value());
+    }
+  }
+  // A single path gains nothing from being handed to a worker.
+  if (jobs.size() < 2u) {
+    return;
+  }
+
+  TRACE_EVENT0("impeller", "EntityPass::PrepareTessellations");
+  auto outputs = BatchTessellator::Tessellate(jobs, worker_task_runner);
+  // The elements of this pass are rendered on the calling thread, which takes
+  // the prepared triangles from its tessellator.
+  auto tessellator = renderer.GetTessellator();
+  for (size_t i = 0; i < jobs.size(); i++) {
+    // Paths that failed to tessellate are tried again when rendered.
+    if (outputs[i].result != Tessellator::Result::kSuccess) {
+      continue;
+    }
+    tessellator->AddPreparedTessellation(
+        this, jobs[i].path, jobs[i].fill_type, jobs[i].scale,
+        Tessellator::PreparedTessellation{
+            .vertices = std::move(outputs[i].vertices),
+            .indices = std::move(outputs[i].indices),
+        });
+  }
 }
 
 bool EntityPass::OnRender(
@@ -703,86 +892,129 @@ bool EntityPass::OnRender(
     render_element(backdrop_entity);
   }
 
-  for (const auto& element : elements_) {
-    EntityResult result =
-        GetEntityForElement(element,                 // element
-                            renderer,                // renderer
-                            pass_context,            // pass_context
-                            root_pass_size,          // root_pass_size
-                            global_pass_position,    // global_pass_position
-                            pass_depth,              // pass_depth
-                            stencil_coverage_stack,  // stencil_coverage_stack
-                            stencil_depth_floor);    // stencil_depth_floor
-
-    switch (result.status) {
-      case EntityResult::kSuccess:
-        break;
-      case EntityResult::kFailure:
-        // All failure cases should be covered by specific validation messages
-        // in `GetEntityForElement()`.
-        return false;
-      case EntityResult::kSkip:
-        continue;
-    };
+  PrepareTessellations(renderer);
+  // Prepared tessellations are only valid for this render of the pass. Drop
+  // the ones left over by elements that were culled or failed to render.
+  fml::ScopedCleanupClosure discard_prepared_tessellations(
+      [tessellator = renderer.GetTessellator(), this]() {
+        tessellator->DiscardPreparedTessellations(this);
+      });
+
+  const bool can_render_subpasses_concurrently =
+      renderer.GetSubpassTaskRunner() != nullptr;
+  for (size_t element_index = 0; element_index < elements_.size();) {
+    std::vector<EntityResult> results;
 
     //--------------------------------------------------------------------------
-    /// Setup advanced blends.
+    /// Render runs of independent subpasses concurrently.
     ///
 
-    if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
-      if (renderer.GetDeviceCapabilities().SupportsFramebufferFetch()) {
-        auto src_contents = result.entity.GetContents();
-        auto contents = std::make_shared<FramebufferBlendContents>();
-        contents->SetChildContents(src_contents);
-        contents->SetBlendMode(result.entity.GetBlendMode());
-        result.entity.SetContents(std::move(contents));
-        result.entity.SetBlendMode(BlendMode::kSource);
-      } else {
-        // End the active pass and flush the buffer before rendering "advanced"
-        // blends. Advanced blends work by binding the current render target
-        // texture as an input ("destination"), blending with a second texture
-        // input ("source"), writing the result to an intermediate texture, and
-        // finally copying the data from the intermediate texture back to the
-        // render target texture. And so all of the commands that have written
-        // to the render target texture so far need to execute before it's bound
-        // for blending (otherwise the blend pass will end up executing before
-        // all the previous commands in the active pass).
-
-        if (!pass_context.EndPass()) {
-          VALIDATION_LOG
-              << "Failed to end the current render pass in order to read from "
-                 "the backdrop texture and apply an advanced blend.";
-          return false;
-        }
+    size_t independent_subpasses = 0u;
+    if (can_render_subpasses_concurrently) {
+      while (element_index + independent_subpasses < elements_.size() &&
+             IsIndependentSubpass(
+                 elements_[element_index + independent_subpasses])) {
+        independent_subpasses++;
+      }
+    }
 
-        // Amend an advanced blend filter to the contents, attaching the pass
-        // texture.
-        auto texture = pass_context.GetTexture();
-        if (!texture) {
-          VALIDATION_LOG << "Failed to fetch the color texture in order to "
-                            "apply an advanced blend.";
+    if (independent_subpasses >= kMinConcurrentSubpasses) {
+      results = GetEntitiesForIndependentSubpasses(
+          element_index,          // first_element
+          independent_subpasses,  // count
+          renderer,               // renderer
+          pass_context,           // pass_context
+          root_pass_size,         // root_pass_size
+          global_pass_position,   // global_pass_position
+          pass_depth,             // pass_depth
+          stencil_coverage_stack  // stencil_coverage_stack
+      );
+      element_index += independent_subpasses;
+    } else {
+      results.push_back(GetEntityForElement(
+          elements_[element_index],  // element
+          renderer,                  // renderer
+          pass_context,              // pass_context
+          root_pass_size,            // root_pass_size
+          global_pass_position,      // global_pass_position
+          pass_depth,                // pass_depth
+          stencil_coverage_stack,    // stencil_coverage_stack
+          stencil_depth_floor));     // stencil_depth_floor
+      element_index++;
+    }
+
+    for (auto& result : results) {
+      switch (result.status) {
+        case EntityResult::kSuccess:
+          break;
+        case EntityResult::kFailure:
+          // All failure cases should be covered by specific validation
+          // messages in `GetEntityForElement()`.
           return false;
+        case EntityResult::kSkip:
+          continue;
+      };
+
+      //------------------------------------------------------------------------
+      /// Setup advanced blends.
+      ///
+
+      if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+        if (renderer.GetDeviceCapabilities().SupportsFramebufferFetch()) {
+          auto src_contents = result.entity.GetContents();
+          auto contents = std::make_shared<FramebufferBlendContents>();
+          contents->SetChildContents(src_contents);
+          contents->SetBlendMode(result.entity.GetBlendMode());
+          result.entity.SetContents(std::move(contents));
+          result.entity.SetBlendMode(BlendMode::kSource);
+        } else {
+          // End the active pass and flush the buffer before rendering
+          // "advanced" blends. Advanced blends work by binding the current
+          // render target texture as an input ("destination"), blending with a
+          // second texture input ("source"), writing the result to an
+          // intermediate texture, and finally copying the data from the
+          // intermediate texture back to the render target texture. And so all
+          // of the commands that have written to the render target texture so
+          // far need to execute before it's bound for blending (otherwise the
+          // blend pass will end up executing before all the previous commands
+          // in the active pass).
+
+          if (!pass_context.EndPass()) {
+            VALIDATION_LOG << "Failed to end the current render pass in order "
+                              "to read from the backdrop texture and apply an "
+                              "advanced blend.";
+            return false;
+          }
+
+          // Amend an advanced blend filter to the contents, attaching the
+          // pass texture.
+          auto texture = pass_context.GetTexture();
+          if (!texture) {
+            VALIDATION_LOG << "Failed to fetch the color texture in order to "
+                              "apply an advanced blend.";
+            return false;
+          }
+
+          FilterInput::Vector inputs = {
+              FilterInput::Make(texture,
+                                result.entity.GetTransformation().Invert()),
+              FilterInput::Make(result.entity.GetContents())};
+          auto contents = ColorFilterContents::MakeBlend(
+              result.entity.GetBlendMode(), inputs);
+          contents->SetCoverageHint(result.entity.GetCoverage());
+          result.entity.SetContents(std::move(contents));
+          result.entity.SetBlendMode(BlendMode::kSource);
         }
-
-        FilterInput::Vector inputs = {
-            FilterInput::Make(texture,
-                              result.entity.GetTransformation().Invert()),
-            FilterInput::Make(result.entity.GetContents())};
-        auto contents = ColorFilterContents::MakeBlend(
-            result.entity.GetBlendMode(), inputs);
-        contents->SetCoverageHint(result.entity.GetCoverage());
-        result.entity.SetContents(std::move(contents));
-        result.entity.SetBlendMode(BlendMode::kSource);
       }
-    }
 
-    //--------------------------------------------------------------------------
-    /// Render the Element.
-    ///
+      //------------------------------------------------------------------------
+      /// Render the Element.
+      ///
 
-    if (!render_element(result.entity)) {
-      // Specific validation logs are handled in `render_element()`.
-      return false;
+      if (!render_element(result.entity)) {
+        // Specific validation logs are handled in `render_element()`.
+        return false;
+      }
     }
   }
 
@@ -125,6 +125,61 @@ class EntityPass {
     static EntityResult Skip() { return {{}, kSkip}; }
   };
 
+  /// The offscreen render target of a subpass and its coverage in the root
+  /// pass.
+  struct SubpassTarget {
+    Rect coverage;
+    EntityPassTarget target;
+  };
+
+  /// @brief  Whether the element is a subpass that is rendered to an offscreen
+  ///         texture without reading from the parent pass. Such subpasses
+  ///         don't depend on the parent pass or on their siblings.
+  static bool IsIndependentSubpass(const Element& element);
+
+  /// @brief  Compute the coverage of a subpass that is rendered to an
+  ///         offscreen texture and create its render target.
+  ///
+  /// @return `kSuccess` if `subpass_target` was set, `kSkip` if the subpass
+  ///         won't be visible, or `kFailure` if the render target couldn't be
+  ///         created.
+  EntityResult::Status CreateSubpassTarget(
+      const EntityPass& subpass,
+      ContentContext& renderer,
+      ISize root_pass_size,
+      ISize pass_size,
+      Point global_pass_position,
+      const StencilCoverageStack& stencil_coverage_stack,
+      bool has_backdrop_filter,
+      std::optional<SubpassTarget>& subpass_target) const;
+
+  /// @brief  Create the entity that draws the rendered offscreen texture of a
+  ///         subpass into this pass.
+  EntityResult GetEntityForSubpassTarget(const EntityPass& subpass,
+                                         const SubpassTarget& subpass_target,
+                                         Point global_pass_position) const;
+
+  /// @brief  Render a run of consecutive independent subpasses (see
+  ///         `IsIndependentSubpass()`) concurrently on the context's worker
+  ///         threads.
+  ///
+  ///         The render targets of the subpasses are created in element order
+  ///         on the calling thread. Each subpass then records and submits its
+  ///         own command buffers on a worker thread. All subpasses are done
+  ///         being submitted when this returns, so the command buffers of
+  ///         this pass that sample their textures are submitted after them.
+  ///
+  /// @return One result per subpass in element order.
+  std::vector<EntityResult> GetEntitiesForIndependentSubpasses(
+      size_t first_element,
+      size_t count,
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      ISize root_pass_size,
+      Point global_pass_position,
+      uint32_t pass_depth,
+      StencilCoverageStack& stencil_coverage_stack) const;
+
   EntityResult GetEntityForElement(const EntityPass::Element& element,
                                    ContentContext& renderer,
                                    InlinePassContext& pass_context,
@@ -201,6 +256,12 @@ class EntityPass {
                 const std::optional<InlinePassContext::RenderPassResult>&
                     collapsed_parent_pass = std::nullopt) const;
 
+  /// Tessellates the paths drawn by the entities of this pass (excluding
+  /// subpasses) concurrently on the context's worker threads and keeps the
+  /// results in the tessellator of the calling thread until the entities are
+  /// rendered.
+  void PrepareTessellations(const ContentContext& renderer) const;
+
   /// The list of renderable items in the scene. Each of these items is
   /// evaluated and recorded to an `EntityPassTarget` by the `OnRender` method.
   std::vector<Element> elements_;
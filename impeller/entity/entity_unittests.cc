@@ -3,14 +3,19 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/testing/testing.h"
 #include "fml/logging.h"
+#include "fml/synchronization/waitable_event.h"
 #include "fml/time/time_point.h"
 #include "gtest/gtest.h"
 #include "impeller/entity/contents/atlas_contents.h"
@@ -38,12 +43,17 @@
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#include "impeller/entity/pipeline_variant_profile.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/sigma.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/widgets.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 #include "impeller/runtime_stage/runtime_stage.h"
@@ -2415,6 +2425,400 @@ TEST_P(EntityTest, PointFieldGeometryDivisions) {
   ASSERT_EQ(PointFieldGeometry::ComputeCircleDivisions(20000.0, true), 140u);
 }
 
+TEST_P(EntityTest, TessellationCacheKeysRequirePathIdentity) {
+  auto path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  ASSERT_FALSE(TessellationCache::MakeKey(path, 1.0).has_value());
+
+  path.SetIdentity(42u);
+  auto key = TessellationCache::MakeKey(path, 1.0);
+  ASSERT_TRUE(key.has_value());
+  ASSERT_EQ(key->path_identity, 42u);
+  ASSERT_FLOAT_EQ(TessellationCache::GetBucketScale(key.value()), 1.0);
+
+  // Scales within the same bucket share a key and are never tessellated at a
+  // lower scale than requested.
+  auto key_a = TessellationCache::MakeKey(path, 1.05);
+  auto key_b = TessellationCache::MakeKey(path, 1.1);
+  ASSERT_TRUE(key_a.has_value() && key_b.has_value());
+  ASSERT_EQ(key_a->scale_bucket, key_b->scale_bucket);
+  ASSERT_GE(TessellationCache::GetBucketScale(key_a.value()), 1.1);
+
+  // Mutating the path drops its identity.
+  path.AddLinearComponent({0, 0}, {10, 10});
+  ASSERT_FALSE(path.GetIdentity().has_value());
+}
+
+TEST_P(EntityTest, TessellationCacheEvictsLeastRecentlyUsed) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  std::vector<float> vertices = {0, 0, 10, 0, 10, 10, 0, 10};
+  std::vector<uint16_t> indices = {0, 1, 2, 0, 2, 3};
+  // Each entry is 32 bytes of vertices and 12 bytes of indices.
+  TessellationCache cache(44u * 4u * 2u);
+
+  auto make_key = [](uint64_t identity) {
+    return TessellationCache::Key{.path_identity = identity};
+  };
+  for (uint64_t i = 1; i <= 8; i++) {
+    ASSERT_TRUE(cache
+                    .Insert(*allocator, make_key(i), vertices.data(),
+                            vertices.size(), indices.data(), indices.size())
+                    .has_value());
+  }
+  ASSERT_EQ(cache.GetEntryCount(), 8u);
+  ASSERT_EQ(cache.GetByteSize(), 8u * 44u);
+
+  // Touch the oldest entry so that the second oldest is evicted instead.
+  auto hit = cache.Get(make_key(1));
+  ASSERT_TRUE(hit.has_value());
+  ASSERT_EQ(hit->vertex_count, indices.size());
+  ASSERT_TRUE(cache
+                  .Insert(*allocator, make_key(9), vertices.data(),
+                          vertices.size(), indices.data(), indices.size())
+                  .has_value());
+  ASSERT_EQ(cache.GetEntryCount(), 8u);
+  ASSERT_TRUE(cache.Get(make_key(1)).has_value());
+  ASSERT_FALSE(cache.Get(make_key(2)).has_value());
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheRecyclesTexturesAcrossFrames) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+
+  cache.Start();
+  auto texture_a = cache.CreateTexture(desc);
+  auto texture_b = cache.CreateTexture(desc);
+  ASSERT_TRUE(texture_a && texture_b);
+  // Textures are never handed out twice in the same frame.
+  ASSERT_NE(texture_a, texture_b);
+  cache.End();
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetByteSize(), 2u * 100u * 100u * 4u);
+
+  // Textures still referenced outside of the cache are not recycled.
+  texture_b.reset();
+  cache.Start();
+  auto texture_c = cache.CreateTexture(desc);
+  ASSERT_NE(texture_c, texture_a);
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  // A different descriptor never matches.
+  auto other_desc = desc;
+  other_desc.size = {50, 50};
+  auto texture_d = cache.CreateTexture(other_desc);
+  ASSERT_NE(texture_d, texture_a);
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+  cache.End();
+
+  // Textures unused for longer than the keep-alive period are released.
+  texture_a.reset();
+  texture_c.reset();
+  texture_d.reset();
+  for (size_t i = 0; i <= RenderTargetCache::kDefaultKeepAliveFrames; i++) {
+    cache.Start();
+    cache.End();
+  }
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheRespectsByteBudget) {
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {10, 10};
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  RenderTargetCache cache(GetContext()->GetResourceAllocator(),
+                          /*keep_alive_frames=*/8u,
+                          /*max_bytes=*/3u * 400u);
+
+  // Textures created outside of a frame are not retained.
+  ASSERT_TRUE(cache.CreateTexture(desc));
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+
+  cache.Start();
+  std::vector<std::shared_ptr<Texture>> textures;
+  for (size_t i = 0; i < 5u; i++) {
+    textures.push_back(cache.CreateTexture(desc));
+  }
+  ASSERT_EQ(cache.GetEntryCount(), 5u);
+  textures.clear();
+  cache.End();
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+  ASSERT_LE(cache.GetByteSize(), cache.GetMaxByteSize());
+}
+
+TEST_P(EntityTest, PipelineVariantProfileRoundTrips) {
+  PipelineVariantProfile profile;
+  ContentContextOptions opts = {
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kMultiply,
+      .stencil_compare = CompareFunction::kEqual,
+      .stencil_operation = StencilOperation::kIncrementClamp,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_stencil_attachment = false,
+  };
+  ASSERT_TRUE(profile.Record("solid_fill", opts));
+  ASSERT_FALSE(profile.Record("solid_fill", opts));
+  ASSERT_TRUE(profile.Record("texture", opts));
+  ASSERT_EQ(profile.GetEntryCount(), 2u);
+
+  auto data = profile.Serialize();
+  ASSERT_TRUE(data);
+
+  PipelineVariantProfile loaded;
+  ASSERT_TRUE(loaded.Load(*data));
+  ASSERT_EQ(loaded.GetEntryCount(), 2u);
+  for (const auto& entry : loaded.GetEntries()) {
+    ASSERT_TRUE(entry.pipeline == "solid_fill" || entry.pipeline == "texture");
+    ASSERT_TRUE(ContentContextOptions::Equal{}(entry.options, opts));
+  }
+
+  std::string other_version = "impeller.pipeline_variants 2\n";
+  PipelineVariantProfile rejected;
+  ASSERT_FALSE(rejected.Load(fml::NonOwnedMapping(
+      reinterpret_cast<const uint8_t*>(other_version.data()),
+      other_version.size())));
+  ASSERT_EQ(rejected.GetEntryCount(), 0u);
+}
+
+TEST_P(EntityTest, ContentContextPrewarmsRecordedPipelineVariants) {
+  ContentContextOptions opts = {
+      .blend_mode = BlendMode::kScreen,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+  };
+
+  PipelineVariantProfile profile;
+  profile.Record("solid_fill", opts);
+  profile.Record("no_such_pipeline", opts);
+
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  auto recorded = content_context.GetPipelineVariantProfile();
+  ASSERT_EQ(recorded->GetEntryCount(), 0u);
+
+  ASSERT_EQ(content_context.PrewarmPipelineVariants(profile), 1u);
+  // Prewarming the same profile again doesn't create the variant twice.
+  ASSERT_EQ(content_context.PrewarmPipelineVariants(profile), 0u);
+  ASSERT_EQ(recorded->GetEntryCount(), 1u);
+  ASSERT_TRUE(content_context.GetSolidFillPipeline(opts));
+
+  // Variants created on first use are recorded as well.
+  opts.blend_mode = BlendMode::kMultiply;
+  ASSERT_TRUE(content_context.GetSolidFillPipeline(opts));
+  ASSERT_EQ(recorded->GetEntryCount(), 2u);
+}
+
+class OffscreenPassDelegate final : public EntityPassDelegate {
+ public:
+  OffscreenPassDelegate() = default;
+
+  // |EntityPassDelegate|
+  ~OffscreenPassDelegate() override = default;
+
+  // |EntityPassDelegate|
+  std::optional<Rect> GetCoverageRect() override { return std::nullopt; }
+
+  // |EntityPassDelgate|
+  bool CanElide() override { return false; }
+
+  // |EntityPassDelgate|
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override {
+    return false;
+  }
+
+  // |EntityPassDelgate|
+  std::shared_ptr<Contents> CreateContentsForSubpassTarget(
+      std::shared_ptr<Texture> target,
+      const Matrix& transform) override {
+    auto size_rect = Rect::MakeSize(target->GetSize());
+    auto contents = TextureContents::MakeRect(size_rect);
+    contents->SetTexture(target);
+    contents->SetSourceRect(size_rect);
+    return contents;
+  }
+};
+
+// Solid color contents that record the threads they are rendered on. While
+// |wait_for_concurrent_renders| is set, each render waits (for a bounded time)
+// until a second one has started, so that a single thread can't render all of
+// them.
+class ThreadRecordingContents final : public Contents {
+ public:
+  struct Log {
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic_size_t started_renders = 0u;
+    bool wait_for_concurrent_renders = false;
+  };
+
+  ThreadRecordingContents(Rect rect, Color color, std::shared_ptr<Log> log)
+      : contents_(
+            SolidColorContents::Make(PathBuilder{}.AddRect(rect).TakePath(),
+                                     color)),
+        log_(std::move(log)) {}
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override {
+    return contents_->GetCoverage(entity);
+  }
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override {
+    log_->started_renders++;
+    if (log_->wait_for_concurrent_renders) {
+      auto deadline = fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(5);
+      while (log_->started_renders < 2u && fml::TimePoint::Now() < deadline) {
+        std::this_thread::yield();
+      }
+    }
+    {
+      std::scoped_lock lock(log_->mutex);
+      log_->threads.insert(std::this_thread::get_id());
+    }
+    return contents_->Render(renderer, entity, pass);
+  }
+
+ private:
+  std::shared_ptr<Contents> contents_;
+  std::shared_ptr<Log> log_;
+};
+
+// Copies the pixels of the texture into host memory.
+std::optional<std::vector<uint8_t>> ReadPixels(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size =
+      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  auto buffer = context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!buffer || !command_buffer) {
+    return std::nullopt;
+  }
+  auto pass = command_buffer->CreateBlitPass();
+  if (!pass || !pass->AddCopy(texture, buffer) ||
+      !pass->EncodeCommands(context->GetResourceAllocator())) {
+    return std::nullopt;
+  }
+  fml::AutoResetWaitableEvent latch;
+  auto status = CommandBuffer::Status::kError;
+  if (!command_buffer->SubmitCommands(
+          [&latch, &status](CommandBuffer::Status submit_status) {
+            status = submit_status;
+            latch.Signal();
+          })) {
+    return std::nullopt;
+  }
+  latch.Wait();
+  if (status != CommandBuffer::Status::kCompleted) {
+    return std::nullopt;
+  }
+  auto contents = buffer->AsBufferView().contents;
+  return std::vector<uint8_t>(contents, contents + buffer_desc.size);
+}
+
+TEST_P(EntityTest, EntityPassRendersIndependentSubpassesConcurrently) {
+  if (!GetContext()->GetConcurrentWorkerTaskRunner()) {
+    GTEST_SKIP_("The context has no worker task runner.");
+  }
+  auto log = std::make_shared<ThreadRecordingContents::Log>();
+
+  // A run of independent subpasses, the last of which leaves a clip behind.
+  // The clip limits the coverage of the subpass after the run.
+  EntityPass pass;
+  for (size_t i = 0; i < 4u; i++) {
+    auto subpass = std::make_unique<EntityPass>();
+    Entity entity;
+    entity.SetContents(std::make_shared<ThreadRecordingContents>(
+        Rect::MakeXYWH(static_cast<Scalar>(i) * 100, 0, 100, 100),
+        Color::Red(), log));
+    subpass->AddEntity(entity);
+    if (i == 3u) {
+      auto clip = std::make_shared<ClipContents>();
+      clip->SetGeometry(Geometry::MakeFillPath(
+          PathBuilder{}.AddRect(Rect::MakeXYWH(150, 25, 200, 50)).TakePath()));
+      clip->SetClipOperation(Entity::ClipOperation::kIntersect);
+      Entity clip_entity;
+      clip_entity.SetContents(clip);
+      subpass->AddEntity(clip_entity);
+    }
+    subpass->SetDelegate(std::make_unique<OffscreenPassDelegate>());
+    pass.AddSubpass(std::move(subpass));
+  }
+  Entity separator;
+  separator.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath(),
+      Color::Green()));
+  pass.AddEntity(separator);
+  auto last_subpass = std::make_unique<EntityPass>();
+  Entity fill;
+  fill.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 400, 100)).TakePath(),
+      Color::Blue()));
+  last_subpass->AddEntity(fill);
+  last_subpass->SetDelegate(std::make_unique<OffscreenPassDelegate>());
+  pass.AddSubpass(std::move(last_subpass));
+
+  auto render = [&](bool concurrent) -> std::optional<std::vector<uint8_t>> {
+    ContentContext content_context(GetContext());
+    if (!content_context.IsValid()) {
+      return std::nullopt;
+    }
+    content_context.SetConcurrentSubpassesEnabled(concurrent);
+    log->wait_for_concurrent_renders = concurrent;
+    auto target = RenderTarget::CreateOffscreen(
+        *GetContext(), *content_context.GetRenderTargetCache(), {400, 100},
+        "Offscreen", RenderTarget::kDefaultColorAttachmentConfig,
+        std::nullopt);
+    if (!pass.Render(content_context, target)) {
+      return std::nullopt;
+    }
+    return ReadPixels(GetContext(), target.GetRenderTargetTexture());
+  };
+
+  auto serial_pixels = render(false);
+  ASSERT_TRUE(serial_pixels.has_value());
+  ASSERT_EQ(log->threads.size(), 1u);
+  ASSERT_EQ(log->threads.count(std::this_thread::get_id()), 1u);
+
+  log->threads.clear();
+  log->started_renders = 0u;
+  auto concurrent_pixels = render(true);
+  ASSERT_TRUE(concurrent_pixels.has_value());
+  // At least one subpass was recorded on a worker.
+  ASSERT_GT(log->threads.size(), 1u);
+  ASSERT_EQ(concurrent_pixels.value(), serial_pixels.value());
+}
+
+TEST_P(EntityTest, ContentContextTessellatorIsPerThread) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  auto tessellator = content_context.GetTessellator();
+  ASSERT_TRUE(tessellator);
+  ASSERT_EQ(content_context.GetTessellator(), tessellator);
+
+  std::shared_ptr<Tessellator> worker_tessellator;
+  std::thread worker([&]() {
+    worker_tessellator = content_context.GetTessellator();
+    ASSERT_EQ(content_context.GetTessellator(), worker_tessellator);
+  });
+  worker.join();
+  ASSERT_TRUE(worker_tessellator);
+  ASSERT_NE(worker_tessellator, tessellator);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 
+#include "impeller/entity/geometry/tessellation_cache.h"
+
 namespace impeller {
 
 FillPathGeometry::FillPathGeometry(const Path& path) : path_(path) {}
@@ -17,10 +19,47 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   auto& host_buffer = pass.GetTransientsBuffer();
   VertexBuffer vertex_buffer;
 
+  Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+
+  // Paths with a stable identity are tessellated once per scale bucket and
+  // then reused across frames from device memory.
+  auto tessellation_cache = renderer.GetTessellationCache();
+  auto cache_key = TessellationCache::MakeKey(path_, scale);
+  if (cache_key.has_value()) {
+    if (auto cached = tessellation_cache->Get(cache_key.value());
+        cached.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = cached.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransformation(),
+          .prevent_overdraw = false,
+      };
+    }
+    scale = TessellationCache::GetBucketScale(cache_key.value());
+  }
+  auto& allocator = *renderer.GetContext()->GetResourceAllocator();
+
   if (path_.GetFillType() == FillType::kNonZero &&  //
       path_.IsConvex()) {
-    auto [points, indices] = TessellateConvex(
-        path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()));
+    auto [points, indices] = TessellateConvex(path_.CreatePolyline(scale));
+
+    std::optional<VertexBuffer> cached;
+    if (cache_key.has_value()) {
+      cached = tessellation_cache->Insert(
+          allocator, cache_key.value(),
+          reinterpret_cast<const float*>(points.data()), points.size() * 2,
+          indices.data(), indices.size());
+    }
+    if (cached.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = cached.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransformation(),
+          .prevent_overdraw = false,
+      };
+    }
 
     vertex_buffer.vertex_buffer = host_buffer.Emplace(
         points.data(), points.size() * sizeof(Point), alignof(Point));
@@ -38,22 +77,47 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
-          const float* vertices, size_t vertices_count, const uint16_t* indices,
-          size_t indices_count) {
-        vertex_buffer.vertex_buffer = host_buffer.Emplace(
-            vertices, vertices_count * sizeof(float), alignof(float));
-        vertex_buffer.index_buffer = host_buffer.Emplace(
-            indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
-        vertex_buffer.vertex_count = indices_count;
-        vertex_buffer.index_type = IndexType::k16bit;
+  auto upload_tessellation = [&vertex_buffer, &host_buffer, &allocator,
+                              &tessellation_cache, &cache_key](
+                                 const float* vertices, size_t vertices_count,
+                                 const uint16_t* indices,
+                                 size_t indices_count) {
+    if (cache_key.has_value()) {
+      auto cached =
+          tessellation_cache->Insert(allocator, cache_key.value(), vertices,
+                                     vertices_count, indices, indices_count);
+      if (cached.has_value()) {
+        vertex_buffer = cached.value();
         return true;
-      });
-  if (tesselation_result != Tessellator::Result::kSuccess) {
-    return {};
+      }
+    }
+    vertex_buffer.vertex_buffer = host_buffer.Emplace(
+        vertices, vertices_count * sizeof(float), alignof(float));
+    vertex_buffer.index_buffer = host_buffer.Emplace(
+        indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
+    vertex_buffer.vertex_count = indices_count;
+    vertex_buffer.index_type = IndexType::k16bit;
+    return true;
+  };
+
+  // Use the tessellation prepared on worker threads by the pass being
+  // rendered, if there is one for this scale.
+  auto tessellator = renderer.GetTessellator();
+  if (auto prepared = tessellator->TakePreparedTessellation(
+          &path_, path_.GetFillType(), scale);
+      prepared.has_value()) {
+    if (!upload_tessellation(prepared->vertices.data(),
+                             prepared->vertices.size(),
+                             prepared->indices.data(),
+                             prepared->indices.size())) {
+      return {};
+    }
+  } else {
+    auto tesselation_result = tessellator->Tessellate(
+        path_.GetFillType(), path_.CreatePolyline(scale), upload_tessellation);
+    if (tesselation_result != Tessellator::Result::kSuccess) {
+      return {};
+    }
   }
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
@@ -138,6 +202,31 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   };
 }
 
+std::optional<TessellationJob> FillPathGeometry::GetTessellationJob(
+    const ContentContext& renderer,
+    const Entity& entity) const {
+  if (path_.GetFillType() == FillType::kNonZero &&  //
+      path_.IsConvex()) {
+    // Convex paths are cheap enough to triangulate inline.
+    return std::nullopt;
+  }
+
+  Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+  if (auto cache_key = TessellationCache::MakeKey(path_, scale);
+      cache_key.has_value()) {
+    if (renderer.GetTessellationCache()->Get(cache_key.value()).has_value()) {
+      return std::nullopt;
+    }
+    scale = TessellationCache::GetBucketScale(cache_key.value());
+  }
+
+  return TessellationJob{
+      .path = &path_,
+      .fill_type = path_.GetFillType(),
+      .scale = scale,
+  };
+}
+
 GeometryVertexType FillPathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -27,6 +27,11 @@ class FillPathGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  std::optional<TessellationJob> GetTessellationJob(
+      const ContentContext& renderer,
+      const Entity& entity) const override;
+
   // |Geometry|
   GeometryResult GetPositionUVBuffer(Rect texture_coverage,
                                      Matrix effect_transform,
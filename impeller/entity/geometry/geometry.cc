@@ -107,6 +107,12 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+std::optional<TessellationJob> Geometry::GetTessellationJob(
+    const ContentContext& renderer,
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
 std::unique_ptr<Geometry> Geometry::MakeFillPath(const Path& path) {
   return std::make_unique<FillPathGeometry>(path);
 }
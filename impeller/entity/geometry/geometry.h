@@ -10,6 +10,7 @@
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/tessellator/batch_tessellator.h"
 
 namespace impeller {
 
@@ -87,6 +88,20 @@ class Geometry {
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns CPU tessellation work this geometry will need to do
+  ///             when it is drawn by `entity`, so that it can be performed
+  ///             ahead of time on worker threads alongside the work of other
+  ///             geometries.
+  ///
+  ///             The triangles are handed back through the tessellator of
+  ///             the rendering thread, see
+  ///             `Tessellator::TakePreparedTessellation`.
+  ///
+  virtual std::optional<TessellationJob> GetTessellationJob(
+      const ContentContext& renderer,
+      const Entity& entity) const;
 };
 
 }  // namespace impeller
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <cmath>
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+std::optional<TessellationCache::Key> TessellationCache::MakeKey(
+    const Path& path,
+    Scalar scale) {
+  auto identity = path.GetIdentity();
+  if (!identity.has_value()) {
+    return std::nullopt;
+  }
+  if (!std::isfinite(scale) || scale <= 0.0f) {
+    return std::nullopt;
+  }
+  // Round up so that the tessellation generated at the bucket scale is at
+  // least as fine as the one requested.
+  auto bucket = static_cast<int32_t>(
+      std::ceil(std::log2(scale) * kScaleBucketsPerOctave));
+  return Key{
+      .path_identity = identity.value(),
+      .fill_type = path.GetFillType(),
+      .scale_bucket = bucket,
+  };
+}
+
+Scalar TessellationCache::GetBucketScale(const Key& key) {
+  return std::exp2(key.scale_bucket / kScaleBucketsPerOctave);
+}
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key) {
+  Lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  // Move the entry to the front of the LRU list.
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+std::optional<VertexBuffer> TessellationCache::Insert(Allocator& allocator,
+                                                      const Key& key,
+                                                      const float* vertices,
+                                                      size_t vertices_size,
+                                                      const uint16_t* indices,
+                                                      size_t indices_size) {
+  if (vertices == nullptr || indices == nullptr || vertices_size == 0u ||
+      indices_size == 0u) {
+    return std::nullopt;
+  }
+
+  const size_t vertex_bytes = vertices_size * sizeof(float);
+  const size_t index_bytes = indices_size * sizeof(uint16_t);
+  // Place the indices after the vertices at an offset that is suitably
+  // aligned for both.
+  constexpr size_t kAlignment = alignof(float);
+  const size_t index_offset =
+      (vertex_bytes + kAlignment - 1u) / kAlignment * kAlignment;
+  const size_t byte_size = index_offset + index_bytes;
+
+  // A single entry must not be able to flush most of the cache.
+  if (byte_size > max_bytes_ / 4u) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = byte_size;
+  auto buffer = allocator.CreateBuffer(desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertices),
+                              Range{0, vertex_bytes}, 0u) ||
+      !buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0, index_bytes}, index_offset)) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Cached Tessellation");
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = buffer->AsBufferView();
+  vertex_buffer.vertex_buffer.range = Range{0u, vertex_bytes};
+  vertex_buffer.index_buffer = buffer->AsBufferView();
+  vertex_buffer.index_buffer.range = Range{index_offset, index_bytes};
+  vertex_buffer.vertex_count = indices_size;
+  vertex_buffer.index_type = IndexType::k16bit;
+
+  Lock lock(mutex_);
+  if (auto found = index_.find(key); found != index_.end()) {
+    byte_size_ -= found->second->byte_size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  EvictToFit(byte_size);
+  entries_.push_front(Entry{
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .byte_size = byte_size,
+  });
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+  return vertex_buffer;
+}
+
+void TessellationCache::EvictToFit(size_t incoming_bytes) {
+  while (!entries_.empty() && byte_size_ + incoming_bytes > max_bytes_) {
+    const auto& victim = entries_.back();
+    byte_size_ -= victim.byte_size;
+    index_.erase(victim.key);
+    entries_.pop_back();
+  }
+}
+
+void TessellationCache::Clear() {
+  Lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0u;
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t TessellationCache::GetByteSize() const {
+  Lock lock(mutex_);
+  return byte_size_;
+}
+
+size_t TessellationCache::GetMaxByteSize() const {
+  return max_bytes_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A frame-spanning cache of path tessellations stored in device
+///             memory.
+///
+///             Entries are keyed by the stable identity of a path (see
+///             |Path::GetIdentity|), its fill type, and a quantized bucket of
+///             the scale the path is being drawn at. Tessellations are always
+///             generated at the upper bound of the scale bucket so that a
+///             cached tessellation never has fewer subdivisions than the
+///             scale it is drawn at requires.
+///
+///             The least recently used entries are evicted once the total
+///             size of the cached buffers exceeds the byte budget.
+///
+class TessellationCache {
+ public:
+  /// The default budget for all cached vertex and index data.
+  static constexpr size_t kDefaultMaxBytes = 8u * 1024u * 1024u;
+
+  /// The number of scale buckets per doubling of the scale factor.
+  static constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+  struct Key {
+    uint64_t path_identity = 0u;
+    FillType fill_type = FillType::kNonZero;
+    int32_t scale_bucket = 0;
+
+    struct Hash {
+      std::size_t operator()(const Key& k) const {
+        return fml::HashCombine(k.path_identity, k.fill_type, k.scale_bucket);
+      }
+    };
+
+    struct Equal {
+      constexpr bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.path_identity == rhs.path_identity &&
+               lhs.fill_type == rhs.fill_type &&
+               lhs.scale_bucket == rhs.scale_bucket;
+      }
+    };
+  };
+
+  explicit TessellationCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a cache key for drawing the given path at the given
+  ///             scale.
+  ///
+  /// @return     The key or std::nullopt if the path has no stable identity
+  ///             and may not be cached.
+  ///
+  static std::optional<Key> MakeKey(const Path& path, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale that tessellations for the given key must be
+  ///             generated at.
+  ///
+  static Scalar GetBucketScale(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Look up a previously cached tessellation and mark it as the
+  ///             most recently used.
+  ///
+  std::optional<VertexBuffer> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the given tessellation into device memory and cache it.
+  ///
+  /// @param[in]  allocator      The allocator used to create the buffer.
+  /// @param[in]  key            The key to cache the tessellation under.
+  /// @param[in]  vertices       Pointer to the vertex positions (x, y pairs).
+  /// @param[in]  vertices_size  The number of floats in `vertices`.
+  /// @param[in]  indices        Pointer to the triangle indices.
+  /// @param[in]  indices_size   The number of indices in `indices`.
+  ///
+  /// @return     The cached vertex buffer or std::nullopt if the tessellation
+  ///             could not be cached (for instance because it is too large
+  ///             for the cache budget).
+  ///
+  std::optional<VertexBuffer> Insert(Allocator& allocator,
+                                     const Key& key,
+                                     const float* vertices,
+                                     size_t vertices_size,
+                                     const uint16_t* indices,
+                                     size_t indices_size);
+
+  /// @brief      Drop all cached tessellations.
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+  size_t GetMaxByteSize() const;
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_bytes_;
+  mutable Mutex mutex_;
+  // Most recently used entries are at the front.
+  EntryList entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_
+      IPLR_GUARDED_BY(mutex_);
+  size_t byte_size_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  void EvictToFit(size_t incoming_bytes) IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
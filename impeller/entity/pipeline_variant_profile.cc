@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/pipeline_variant_profile.h"
+
+#include <sstream>
+#include <string_view>
+
+namespace impeller {
+
+static constexpr std::string_view kProfileMagic = "impeller.pipeline_variants";
+
+PipelineVariantProfile::PipelineVariantProfile() = default;
+
+PipelineVariantProfile::~PipelineVariantProfile() = default;
+
+bool PipelineVariantProfile::Record(const std::string& pipeline,
+                                    const ContentContextOptions& opts) {
+  Lock lock(mutex_);
+  return RecordLocked(pipeline, opts);
+}
+
+bool PipelineVariantProfile::RecordLocked(const std::string& pipeline,
+                                          const ContentContextOptions& opts) {
+  if (!entries_[pipeline].insert(opts).second) {
+    return false;
+  }
+  entry_count_++;
+  generation_++;
+  return true;
+}
+
+template <class T>
+static bool ReadEnum(std::istream& stream, T last, T& value) {
+  int raw = -1;
+  if (!(stream >> raw) || raw < 0 || raw > static_cast<int>(last)) {
+    return false;
+  }
+  value = static_cast<T>(raw);
+  return true;
+}
+
+static bool ReadBool(std::istream& stream, bool& value) {
+  int raw = -1;
+  if (!(stream >> raw) || (raw != 0 && raw != 1)) {
+    return false;
+  }
+  value = raw == 1;
+  return true;
+}
+
+static bool ReadOptions(std::istream& stream, ContentContextOptions& opts) {
+  int sample_count = 0;
+  if (!(stream >> sample_count) ||
+      (sample_count != static_cast<int>(SampleCount::kCount1) &&
+       sample_count != static_cast<int>(SampleCount::kCount4))) {
+    return false;
+  }
+  opts.sample_count = static_cast<SampleCount>(sample_count);
+  return ReadEnum(stream, BlendMode::kLast, opts.blend_mode) &&
+         ReadEnum(stream, CompareFunction::kGreaterEqual,
+                  opts.stencil_compare) &&
+         ReadEnum(stream, StencilOperation::kDecrementWrap,
+                  opts.stencil_operation) &&
+         ReadEnum(stream, PrimitiveType::kPoint, opts.primitive_type) &&
+         ReadEnum(stream, PixelFormat::kD32FloatS8UInt,
+                  opts.color_attachment_pixel_format) &&
+         ReadBool(stream, opts.has_stencil_attachment) &&
+         ReadBool(stream, opts.wireframe);
+}
+
+bool PipelineVariantProfile::Load(const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return false;
+  }
+  std::istringstream stream(std::string(
+      reinterpret_cast<const char*>(mapping.GetMapping()), mapping.GetSize()));
+
+  std::string magic;
+  int version = 0;
+  if (!(stream >> magic >> version) || magic != kProfileMagic ||
+      version != kVersion) {
+    return false;
+  }
+
+  Lock lock(mutex_);
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::istringstream line_stream(line);
+    std::string pipeline;
+    ContentContextOptions opts;
+    if (!(line_stream >> pipeline) || !ReadOptions(line_stream, opts)) {
+      continue;
+    }
+    RecordLocked(pipeline, opts);
+  }
+  return true;
+}
+
+std::shared_ptr<fml::Mapping> PipelineVariantProfile::Serialize() const {
+  std::ostringstream stream;
+  stream << kProfileMagic << " " << kVersion << "\n";
+  {
+    Lock lock(mutex_);
+    for (const auto& [pipeline, variants] : entries_) {
+      for (const auto& opts : variants) {
+        stream << pipeline << " " << static_cast<int>(opts.sample_count) << " "
+               << static_cast<int>(opts.blend_mode) << " "
+               << static_cast<int>(opts.stencil_compare) << " "
+               << static_cast<int>(opts.stencil_operation) << " "
+               << static_cast<int>(opts.primitive_type) << " "
+               << static_cast<int>(opts.color_attachment_pixel_format) << " "
+               << opts.has_stencil_attachment << " " << opts.wireframe
+               << "\n";
+      }
+    }
+  }
+  auto data = std::make_shared<std::string>(stream.str());
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(data->data()), data->size(),
+      [data](auto, auto) {});
+}
+
+std::vector<PipelineVariantProfile::Entry> PipelineVariantProfile::GetEntries()
+    const {
+  Lock lock(mutex_);
+  std::vector<Entry> entries;
+  entries.reserve(entry_count_);
+  for (const auto& [pipeline, variants] : entries_) {
+    for (const auto& opts : variants) {
+      entries.push_back(Entry{.pipeline = pipeline, .options = opts});
+    }
+  }
+  return entries;
+}
+
+size_t PipelineVariantProfile::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entry_count_;
+}
+
+uint64_t PipelineVariantProfile::GetGeneration() const {
+  Lock lock(mutex_);
+  return generation_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
+#include "impeller/entity/contents/content_context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The set of pipeline variants a |ContentContext| created, keyed
+///             by the name of the pipeline and the options of the variant.
+///
+///             Profiles are recorded while rendering, persisted, and used to
+///             prewarm the same variants the next time the application
+///             starts (see |ContentContext::PrewarmPipelineVariants|) so that
+///             the first frame using a variant does not stall on building
+///             it.
+///
+///             Recording and serialization may happen on different threads.
+///
+class PipelineVariantProfile {
+ public:
+  /// The version of the serialized format. Profiles of other versions are
+  /// ignored.
+  static constexpr int kVersion = 1;
+
+  struct Entry {
+    std::string pipeline;
+    ContentContextOptions options;
+  };
+
+  PipelineVariantProfile();
+
+  ~PipelineVariantProfile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that a variant of the named pipeline was used.
+  ///
+  /// @return     If the variant was not already part of the profile.
+  ///
+  bool Record(const std::string& pipeline, const ContentContextOptions& opts);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add the entries of a serialized profile to this one.
+  ///
+  /// @return     If the serialized profile could be read. Malformed entries
+  ///             are skipped.
+  ///
+  bool Load(const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize all entries of the profile.
+  ///
+  std::shared_ptr<fml::Mapping> Serialize() const;
+
+  std::vector<Entry> GetEntries() const;
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A counter that is incremented every time a new entry is
+  ///             added. Used to determine if a profile needs to be persisted
+  ///             again.
+  ///
+  uint64_t GetGeneration() const;
+
+ private:
+  using OptionsSet = std::unordered_set<ContentContextOptions,
+                                        ContentContextOptions::Hash,
+                                        ContentContextOptions::Equal>;
+
+  mutable Mutex mutex_;
+  std::unordered_map<std::string, OptionsSet> entries_ IPLR_GUARDED_BY(mutex_);
+  size_t entry_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  uint64_t generation_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  bool RecordLocked(const std::string& pipeline,
+                    const ContentContextOptions& opts) IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineVariantProfile);
+};
+
+}  // namespace impeller
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+namespace {
+
+bool DescriptorsMatch(const TextureDescriptor& a, const TextureDescriptor& b) {
+  return a.storage_mode == b.storage_mode &&  //
+         a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count &&  //
+         a.compression_type == b.compression_type;
+}
+
+size_t GetTextureByteSize(const TextureDescriptor& desc) {
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+}  // namespace
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t keep_alive_frames,
+                                     size_t max_bytes)
+    : RenderTargetAllocator(std::move(allocator)),
+      keep_alive_frames_(keep_alive_frames),
+      max_bytes_(max_bytes) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  {
+    Lock lock(mutex_);
+    // Textures created outside of a frame can't be tracked safely.
+    if (!in_frame_) {
+      return RenderTargetAllocator::CreateTexture(desc);
+    }
+    for (auto& entry : entries_) {
+      // A texture that is referenced elsewhere (or was already handed out
+      // this frame) may still be written or sampled by pending GPU work.
+      if (entry.used_this_frame || entry.texture.use_count() != 1) {
+        continue;
+      }
+      if (DescriptorsMatch(entry.texture->GetTextureDescriptor(), desc)) {
+        entry.used_this_frame = true;
+        entry.last_used_frame = frame_;
+        return entry.texture;
+      }
+    }
+  }
+
+  auto texture = RenderTargetAllocator::CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  const auto byte_size = GetTextureByteSize(desc);
+
+  Lock lock(mutex_);
+  // Textures that alone would take up most of the budget are not retained.
+  if (byte_size > max_bytes_ / 2u) {
+    return texture;
+  }
+  entries_.push_back(Entry{
+      .texture = texture,
+      .byte_size = byte_size,
+      .last_used_frame = frame_,
+      .used_this_frame = true,
+  });
+  byte_size_ += byte_size;
+  return texture;
+}
+
+void RenderTargetCache::Start() {
+  Lock lock(mutex_);
+  frame_++;
+  in_frame_ = true;
+  for (auto& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+}
+
+void RenderTargetCache::End() {
+  Lock lock(mutex_);
+  in_frame_ = false;
+
+  // Dropping the reference held by the cache is always safe. Pending command
+  // buffers keep the textures they use alive on their own.
+  for (size_t i = 0; i < entries_.size();) {
+    if (frame_ - entries_[i].last_used_frame > keep_alive_frames_) {
+      Evict(i);
+    } else {
+      i++;
+    }
+  }
+
+  if (byte_size_ <= max_bytes_) {
+    return;
+  }
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.last_used_frame > b.last_used_frame;
+            });
+  while (!entries_.empty() && byte_size_ > max_bytes_) {
+    Evict(entries_.size() - 1u);
+  }
+}
+
+void RenderTargetCache::Evict(size_t index) {
+  byte_size_ -= entries_[index].byte_size;
+  if (index != entries_.size() - 1u) {
+    entries_[index] = std::move(entries_.back());
+  }
+  entries_.pop_back();
+}
+
+void RenderTargetCache::Clear() {
+  Lock lock(mutex_);
+  entries_.clear();
+  byte_size_ = 0u;
+}
+
+size_t RenderTargetCache::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t RenderTargetCache::GetByteSize() const {
+  Lock lock(mutex_);
+  return byte_size_;
+}
+
+size_t RenderTargetCache::GetMaxByteSize() const {
+  return max_bytes_;
+}
+
+}  // namespace impeller
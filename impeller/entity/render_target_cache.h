@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that recycles the textures of
+///             offscreen render targets from one frame to the next.
+///
+///             Textures are matched by their full descriptor (size, format,
+///             sample count, storage mode, etc.). A texture is only handed
+///             out once per frame and only if nothing outside of the cache
+///             still references it. Textures that have not been used for
+///             more than the keep-alive number of frames are released at the
+///             end of a frame, as are the least recently used textures once
+///             the cache exceeds its byte budget.
+///
+class RenderTargetCache final : public RenderTargetAllocator {
+ public:
+  /// The number of frames an unused texture is retained for.
+  static constexpr size_t kDefaultKeepAliveFrames = 1u;
+
+  /// The default budget for all cached textures.
+  static constexpr size_t kDefaultMaxBytes = 128u * 1024u * 1024u;
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t keep_alive_frames = kDefaultKeepAliveFrames,
+                             size_t max_bytes = kDefaultMaxBytes);
+
+  // |RenderTargetAllocator|
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  /// @brief      Release all cached textures.
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+  size_t GetMaxByteSize() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<Texture> texture;
+    size_t byte_size = 0u;
+    uint64_t last_used_frame = 0u;
+    bool used_this_frame = false;
+  };
+
+  const size_t keep_alive_frames_;
+  const size_t max_bytes_;
+  mutable Mutex mutex_;
+  std::vector<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  size_t byte_size_ IPLR_GUARDED_BY(mutex_) = 0u;
+  uint64_t frame_ IPLR_GUARDED_BY(mutex_) = 0u;
+  bool in_frame_ IPLR_GUARDED_BY(mutex_) = false;
+
+  void Evict(size_t index) IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
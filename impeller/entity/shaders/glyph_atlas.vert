@@ -24,6 +24,9 @@ in highp vec2 unit_position;
 in highp vec2 glyph_position;
 
 out highp vec2 v_uv;
+// The number of pixels covered by a texel of the atlas. Only used when
+// rendering from signed distance field atlases.
+out highp float v_screen_pixels_per_texel;
 
 mat4 basis(mat4 m) {
   return mat4(m[0][0], m[0][1], m[0][2], 0.0,  //
@@ -79,4 +82,7 @@ void main() {
 
   gl_Position = frame_info.mvp * position;
   v_uv = uv_origin + unit_position * uv_size;
+  v_screen_pixels_per_texel =
+      length((basis_transform * vec4(glyph_bounds.z, 0.0, 0.0, 0.0)).xy) /
+      max(atlas_glyph_bounds.z, 1.0);
 }
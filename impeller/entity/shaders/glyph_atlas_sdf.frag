@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// The distance in texels from the outline that is encoded in the atlas. This
+// must match GlyphAtlas::kSignedDistanceFieldSpread.
+const float kSpread = 8.0;
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+uniform FragInfo {
+  f16vec4 text_color;
+}
+frag_info;
+
+in highp vec2 v_uv;
+in highp float v_screen_pixels_per_texel;
+
+out f16vec4 frag_color;
+
+void main() {
+  // The atlas stores 0.5 on the outline of the glyph and increases towards
+  // its inside.
+  float distance = float(texture(glyph_atlas_sampler, v_uv).a);
+  float screen_distance =
+      (distance - 0.5) * 2.0 * kSpread * v_screen_pixels_per_texel;
+  // Antialias over a single pixel centered on the outline.
+  float16_t coverage = float16_t(clamp(screen_distance + 0.5, 0.0, 1.0));
+  frag_color = frag_info.text_color * coverage;
+}
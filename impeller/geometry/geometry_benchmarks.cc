@@ -4,6 +4,8 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include <cmath>
+
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/tessellator/tessellator.h"
@@ -16,6 +18,11 @@ namespace {
 Path CreateCubic();
 /// Similar to the path above, but with all cubics replaced by quadratics.
 Path CreateQuadratic();
+/// A small path made of short quadratics, similar to a TrueType glyph outline.
+Path CreateGlyphOutline();
+/// A long path made of many cubics spanning a large area, similar to a line
+/// chart with smoothed data points.
+Path CreateChart();
 }  // namespace
 
 static Tessellator tess;
@@ -48,6 +55,32 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 
+template <class... Args>
+static void BM_Flatten(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto scale = std::get<Scalar>(args_tuple);
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    auto polyline = path.CreatePolyline(scale);
+    single_point_count = polyline.points.size();
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["PointsPerSecond"] =
+      benchmark::Counter(point_count, benchmark::Counter::kIsRate);
+  state.counters["SegmentsPerSecond"] = benchmark::Counter(
+      state.iterations() * path.GetComponentCount(),
+      benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_CAPTURE(BM_Flatten, glyph_outline, CreateGlyphOutline(), 1.0f);
+BENCHMARK_CAPTURE(BM_Flatten, glyph_outline_zoomed, CreateGlyphOutline(), 8.0f);
+BENCHMARK_CAPTURE(BM_Flatten, chart, CreateChart(), 1.0f);
+BENCHMARK_CAPTURE(BM_Flatten, chart_zoomed, CreateChart(), 4.0f);
+
 namespace {
 Path CreateCubic() {
   return PathBuilder{}
@@ -312,5 +345,42 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateGlyphOutline() {
+  // Roughly the outline of a lowercase "g" at a 16pt font size, drawn twice
+  // to mimic the inner and outer contours of a glyph.
+  PathBuilder builder;
+  for (auto offset : {Point{0, 0}, Point{3, 2}}) {
+    builder.MoveTo(Point{8.1, 1.2} + offset)
+        .QuadraticCurveTo(Point{11.4, 1.2} + offset, Point{11.9, 4.6} + offset)
+        .QuadraticCurveTo(Point{12.1, 6.3} + offset, Point{11.2, 7.8} + offset)
+        .QuadraticCurveTo(Point{12.3, 9.1} + offset, Point{12.0, 11.1} + offset)
+        .QuadraticCurveTo(Point{11.5, 14.6} + offset,
+                          Point{7.6, 15.1} + offset)
+        .QuadraticCurveTo(Point{3.9, 15.4} + offset, Point{2.9, 12.6} + offset)
+        .QuadraticCurveTo(Point{2.2, 10.4} + offset, Point{3.6, 8.7} + offset)
+        .QuadraticCurveTo(Point{2.4, 7.3} + offset, Point{2.7, 5.1} + offset)
+        .QuadraticCurveTo(Point{3.3, 1.4} + offset, Point{8.1, 1.2} + offset)
+        .Close();
+  }
+  return builder.TakePath();
+}
+
+Path CreateChart() {
+  // A smoothed line chart of 500 data points across a 2000 pixel wide plot.
+  PathBuilder builder;
+  builder.MoveTo({0, 300});
+  Point previous = {0, 300};
+  for (int i = 1; i <= 500; i++) {
+    Point next = {i * 4.0f, 300.0f + 200.0f * std::sin(i * 0.37f) *
+                                         std::cos(i * 0.05f)};
+    auto dx = (next.x - previous.x) / 3.0f;
+    builder.CubicCurveTo({previous.x + dx, previous.y},
+                         {next.x - dx, next.y}, next);
+    previous = next;
+  }
+  builder.LineTo({2000, 600}).LineTo({0, 600}).Close();
+  return builder.TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
@@ -2124,6 +2124,81 @@ TEST(GeometryTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(GeometryTest, FlattenQuadraticsMatchesScalarEvaluation) {
+  std::vector<QuadraticPathComponent> quads = {
+      {{0, 0}, {50, 100}, {100, 0}},
+      {{100, 0}, {100, 0}, {100, 0}},
+      {{100, 0}, {150, -300}, {400, 20}},
+      {{10, 10}, {11, 12}, {12, 10}},
+  };
+  for (auto scale : {1.0f, 3.5f, 20.0f}) {
+    std::vector<QuadraticFlatteningParams> params;
+    size_t point_count = 0u;
+    for (const auto& quad : quads) {
+      params.push_back(quad.ComputeFlatteningParams(scale));
+      point_count += params.back().line_count;
+    }
+    std::vector<Point> points(point_count);
+    ASSERT_EQ(FlattenQuadratics(quads.data(), params.data(), quads.size(),
+                                points.data()),
+              point_count);
+
+    size_t offset = 0u;
+    for (size_t q = 0; q < quads.size(); q++) {
+      const auto& quad = quads[q];
+      const auto& param = params[q];
+      for (size_t i = 1; i < param.line_count; i++) {
+        // Recompute the expected point with the scalar formulation.
+        constexpr Scalar d = 0.67;
+        auto integral = [d](Scalar x) {
+          return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
+        };
+        auto u = static_cast<double>(i) / param.line_count;
+        auto a = param.a0 + (param.a2 - param.a0) * u;
+        auto t = (integral(a) - param.u0) * param.uscale;
+        auto expected = quad.Solve(t);
+        auto actual = points[offset + i - 1];
+        ASSERT_NEAR(actual.x, expected.x, 1e-2);
+        ASSERT_NEAR(actual.y, expected.y, 1e-2);
+      }
+      // The end point is always emitted exactly.
+      ASSERT_EQ(points[offset + param.line_count - 1], quad.p2);
+      offset += param.line_count;
+    }
+  }
+}
+
+TEST(GeometryTest, PathCreatePolylineMatchesComponentPolylines) {
+  Path path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .QuadraticCurveTo({100, 300}, {200, 10})
+                  .CubicCurveTo({250, 100}, {300, -100}, {400, 40})
+                  .LineTo({400, 40})
+                  .Close()
+                  .TakePath();
+
+  auto polyline = path.CreatePolyline(2.0f);
+
+  std::vector<Point> expected = {{10, 10}};
+  for (auto point :
+       QuadraticPathComponent({10, 10}, {100, 300}, {200, 10})
+           .CreatePolyline(2.0f)) {
+    expected.push_back(point);
+  }
+  for (auto point :
+       CubicPathComponent({200, 10}, {250, 100}, {300, -100}, {400, 40})
+           .CreatePolyline(2.0f)) {
+    expected.push_back(point);
+  }
+  // Closing the contour adds a line back to the start.
+  expected.push_back({10, 10});
+
+  ASSERT_EQ(polyline.points.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_POINT_NEAR(polyline.points[i], expected[i]);
+  }
+}
+
 TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   Path path;
   path.AddContourComponent({10, 10});
@@ -2143,6 +2218,50 @@ TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   ASSERT_EQ(polyline.points[4].x, 50);
 }
 
+TEST(GeometryTest, PathBuilderResetStartsNewPath) {
+  PathBuilder builder;
+  builder.AddCircle({100, 100}, 50).SetConvexity(Convexity::kConvex);
+  auto circle = builder.CopyPath();
+  ASSERT_GT(circle.GetComponentCount(Path::ComponentType::kCubic), 0u);
+
+  auto path = builder.Reset()
+                  .MoveTo({10, 10})
+                  .QuadraticCurveTo({20, 0}, {30, 10})
+                  .LineTo({30, 30})
+                  .Close()
+                  .TakePath();
+  auto expected = PathBuilder{}
+                      .MoveTo({10, 10})
+                      .QuadraticCurveTo({20, 0}, {30, 10})
+                      .LineTo({30, 30})
+                      .Close()
+                      .TakePath();
+
+  ASSERT_FALSE(path.IsConvex());
+  ASSERT_EQ(path.GetComponentCount(), expected.GetComponentCount());
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kCubic), 0u);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kQuadratic), 1u);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kLinear), 2u);
+  ASSERT_EQ(path.GetComponentCount(Path::ComponentType::kContour), 2u);
+  ASSERT_EQ(path.GetBoundingBox(), expected.GetBoundingBox());
+
+  ContourComponent contour;
+  ASSERT_TRUE(path.GetContourComponentAtIndex(0, contour));
+  ASSERT_EQ(contour.destination, Point(10, 10));
+  ASSERT_TRUE(contour.is_closed);
+
+  auto polyline = path.CreatePolyline(1.0f);
+  auto expected_polyline = expected.CreatePolyline(1.0f);
+  ASSERT_EQ(polyline.points, expected_polyline.points);
+  ASSERT_EQ(polyline.contours.size(), expected_polyline.contours.size());
+
+  // Paths copied out of the builder are unaffected by further building.
+  builder.Reset();
+  ASSERT_EQ(circle.CreatePolyline(1.0f).points,
+            PathBuilder{}.AddCircle({100, 100}, 50).TakePath().CreatePolyline(
+                1.0f).points);
+}
+
 TEST(GeometryTest, PathBuilderSetsCorrectContourPropertiesForAddCommands) {
   // Closed shapes.
   {
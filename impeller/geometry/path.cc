@@ -7,10 +7,44 @@
 #include <optional>
 #include <variant>
 
+#include "flutter/fml/thread_local.h"
 #include "impeller/geometry/path_component.h"
 
 namespace impeller {
 
+namespace {
+
+// A run of the quadratics a single curve component is flattened from.
+struct CurveRun {
+  size_t first_curve = 0u;
+  size_t curve_count = 0u;
+  size_t point_count = 0u;
+};
+
+// The flattening state of |Path::CreatePolyline|, kept per thread so that
+// its buffers are reused by subsequent calls instead of being reallocated.
+struct PolylineScratch {
+  std::vector<QuadraticPathComponent> curves;
+  std::vector<QuadraticFlatteningParams> curve_params;
+  std::vector<CurveRun> curve_runs;
+};
+
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<PolylineScratch>
+    tls_polyline_scratch;
+
+PolylineScratch& GetPolylineScratch() {
+  if (tls_polyline_scratch.get() == nullptr) {
+    tls_polyline_scratch.reset(new PolylineScratch());
+  }
+  auto& scratch = *tls_polyline_scratch.get();
+  scratch.curves.clear();
+  scratch.curve_params.clear();
+  scratch.curve_runs.clear();
+  return scratch;
+}
+
+}  // namespace
+
 Path::Path() {
   AddContourComponent({});
 };
@@ -31,16 +65,7 @@ std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
 
 size_t Path::GetComponentCount(std::optional<ComponentType> type) const {
   if (type.has_value()) {
-    switch (type.value()) {
-      case ComponentType::kLinear:
-        return linears_.size();
-      case ComponentType::kQuadratic:
-        return quads_.size();
-      case ComponentType::kCubic:
-        return cubics_.size();
-      case ComponentType::kContour:
-        return contours_.size();
-    }
+    return component_counts_[static_cast<size_t>(type.value())];
   }
   return components_.size();
 }
@@ -61,38 +86,92 @@ void Path::SetConvexity(Convexity value) {
   convexity_ = value;
 }
 
+void Path::Reset() {
+  fill_ = FillType::kNonZero;
+  convexity_ = Convexity::kUnknown;
+  identity_ = std::nullopt;
+  components_.clear();
+  points_.clear();
+  component_counts_ = {};
+  AddContourComponent({});
+}
+
+void Path::SetIdentity(uint64_t identity) {
+  if (identity == 0u) {
+    identity_ = std::nullopt;
+    return;
+  }
+  identity_ = identity;
+}
+
+std::optional<uint64_t> Path::GetIdentity() const {
+  return identity_;
+}
+
+void Path::AddComponent(ComponentType type,
+                        std::initializer_list<Point> points) {
+  identity_ = std::nullopt;
+  components_.emplace_back(type, points_.size());
+  points_.insert(points_.end(), points);
+  component_counts_[static_cast<size_t>(type)]++;
+}
+
+LinearPathComponent Path::GetLinear(const ComponentIndexPair& component) const {
+  const auto* points = points_.data() + component.index;
+  return LinearPathComponent(points[0], points[1]);
+}
+
+QuadraticPathComponent Path::GetQuadratic(
+    const ComponentIndexPair& component) const {
+  const auto* points = points_.data() + component.index;
+  return QuadraticPathComponent(points[0], points[1], points[2]);
+}
+
+CubicPathComponent Path::GetCubic(const ComponentIndexPair& component) const {
+  const auto* points = points_.data() + component.index;
+  return CubicPathComponent(points[0], points[1], points[2], points[3]);
+}
+
+ContourComponent Path::GetContour(const ComponentIndexPair& component) const {
+  return ContourComponent(points_[component.index], component.is_closed);
+}
+
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  AddComponent(ComponentType::kLinear, {p1, p2});
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  AddComponent(ComponentType::kQuadratic, {p1, cp, p2});
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  AddComponent(ComponentType::kCubic, {p1, cp1, cp2, p2});
   return *this;
 }
 
 Path& Path::AddContourComponent(Point destination, bool is_closed) {
+  identity_ = std::nullopt;
   if (components_.size() > 0 &&
       components_.back().type == ComponentType::kContour) {
     // Never insert contiguous contours.
-    contours_.back() = ContourComponent(destination, is_closed);
+    points_[components_.back().index] = destination;
   } else {
-    contours_.emplace_back(ContourComponent(destination, is_closed));
-    components_.emplace_back(ComponentType::kContour, contours_.size() - 1);
+    AddComponent(ComponentType::kContour, {destination});
   }
+  components_.back().is_closed = is_closed;
   return *this;
 }
 
 void Path::SetContourClosed(bool is_closed) {
-  contours_.back().is_closed = is_closed;
+  identity_ = std::nullopt;
+  for (auto it = components_.rbegin(); it != components_.rend(); ++it) {
+    if (it->type == ComponentType::kContour) {
+      it->is_closed = is_closed;
+      return;
+    }
+  }
 }
 
 void Path::EnumerateComponents(
@@ -105,22 +184,22 @@ void Path::EnumerateComponents(
     switch (component.type) {
       case ComponentType::kLinear:
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(currentIndex, GetLinear(component));
         }
         break;
       case ComponentType::kQuadratic:
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(currentIndex, GetQuadratic(component));
         }
         break;
       case ComponentType::kCubic:
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(currentIndex, GetCubic(component));
         }
         break;
       case ComponentType::kContour:
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(currentIndex, GetContour(component));
         }
         break;
     }
@@ -138,7 +217,7 @@ bool Path::GetLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linear = linears_[components_[index].index];
+  linear = GetLinear(components_[index]);
   return true;
 }
 
@@ -153,7 +232,7 @@ bool Path::GetQuadraticComponentAtIndex(
     return false;
   }
 
-  quadratic = quads_[components_[index].index];
+  quadratic = GetQuadratic(components_[index]);
   return true;
 }
 
@@ -167,7 +246,7 @@ bool Path::GetCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubic = cubics_[components_[index].index];
+  cubic = GetCubic(components_[index]);
   return true;
 }
 
@@ -181,7 +260,7 @@ bool Path::GetContourComponentAtIndex(size_t index,
     return false;
   }
 
-  move = contours_[components_[index].index];
+  move = GetContour(components_[index]);
   return true;
 }
 
@@ -195,7 +274,10 @@ bool Path::UpdateLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linears_[components_[index].index] = linear;
+  identity_ = std::nullopt;
+  auto* points = points_.data() + components_[index].index;
+  points[0] = linear.p1;
+  points[1] = linear.p2;
   return true;
 }
 
@@ -210,7 +292,11 @@ bool Path::UpdateQuadraticComponentAtIndex(
     return false;
   }
 
-  quads_[components_[index].index] = quadratic;
+  identity_ = std::nullopt;
+  auto* points = points_.data() + components_[index].index;
+  points[0] = quadratic.p1;
+  points[1] = quadratic.cp;
+  points[2] = quadratic.p2;
   return true;
 }
 
@@ -224,7 +310,12 @@ bool Path::UpdateCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubics_[components_[index].index] = cubic;
+  identity_ = std::nullopt;
+  auto* points = points_.data() + components_[index].index;
+  points[0] = cubic.p1;
+  points[1] = cubic.cp1;
+  points[2] = cubic.cp2;
+  points[3] = cubic.p2;
   return true;
 }
 
@@ -238,43 +329,104 @@ bool Path::UpdateContourComponentAtIndex(size_t index,
     return false;
   }
 
-  contours_[components_[index].index] = move;
+  identity_ = std::nullopt;
+  points_[components_[index].index] = move.destination;
+  components_[index].is_closed = move.is_closed;
   return true;
 }
 
 Path::Polyline Path::CreatePolyline(Scalar scale) const {
   Polyline polyline;
 
+  // Compute the flattening parameters of every curve up front. This gives the
+  // exact number of points each curve generates so that the polyline is
+  // allocated once and the curves are flattened directly into it.
+  auto& scratch = GetPolylineScratch();
+  auto& curves = scratch.curves;
+  auto& curve_params = scratch.curve_params;
+  auto& curve_runs = scratch.curve_runs;
+  size_t point_count = 0u;
+  for (const auto& component : components_) {
+    CurveRun run{.first_curve = curves.size()};
+    switch (component.type) {
+      case ComponentType::kLinear:
+      case ComponentType::kContour:
+        point_count++;
+        continue;
+      case ComponentType::kQuadratic:
+        curves.push_back(GetQuadratic(component));
+        break;
+      case ComponentType::kCubic:
+        GetCubic(component).AppendQuadraticPathComponents(.1, curves);
+        break;
+    }
+    run.curve_count = curves.size() - run.first_curve;
+    for (size_t i = run.first_curve; i < curves.size(); i++) {
+      curve_params.push_back(curves[i].ComputeFlatteningParams(scale));
+      run.point_count += curve_params.back().line_count;
+    }
+    point_count += run.point_count;
+    curve_runs.push_back(run);
+  }
+  polyline.points.reserve(point_count);
+
   std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
+  auto collect_point = [&polyline, &previous_contour_point](Point point) {
+    if (previous_contour_point.has_value() &&
+        previous_contour_point.value() == point) {
+      // Skip over duplicate points in the same contour.
       return;
     }
+    previous_contour_point = point;
+    polyline.points.push_back(point);
+  };
 
-    for (const auto& point : collection) {
+  size_t next_curve_run = 0u;
+  auto collect_curve_points = [&polyline, &previous_contour_point, &curves,
+                               &curve_params, &curve_runs, &next_curve_run]() {
+    const auto& run = curve_runs[next_curve_run++];
+    auto& points = polyline.points;
+    const auto offset = points.size();
+    points.resize(offset + run.point_count);
+    FlattenQuadratics(curves.data() + run.first_curve,
+                      curve_params.data() + run.first_curve, run.curve_count,
+                      points.data() + offset);
+
+    // Skip over duplicate points in the same contour, compacting in place.
+    auto write = offset;
+    for (auto read = offset; read < points.size(); read++) {
+      const auto point = points[read];
       if (previous_contour_point.has_value() &&
           previous_contour_point.value() == point) {
-        // Skip over duplicate points in the same contour.
         continue;
       }
       previous_contour_point = point;
-      polyline.points.push_back(point);
+      points[write++] = point;
     }
+    points.resize(write);
   };
 
-  auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
+  // Components are unpacked from the point stream into these. The returned
+  // variant is only valid until the next call.
+  LinearPathComponent linear;
+  QuadraticPathComponent quad;
+  CubicPathComponent cubic;
+  auto get_path_component = [this, &linear, &quad, &cubic](
+                                size_t component_i) -> PathComponentVariant {
     if (component_i >= components_.size()) {
       return std::monostate{};
     }
     const auto& component = components_[component_i];
     switch (component.type) {
       case ComponentType::kLinear:
-        return &linears_[component.index];
+        linear = GetLinear(component);
+        return &linear;
       case ComponentType::kQuadratic:
-        return &quads_[component.index];
+        quad = GetQuadratic(component);
+        return &quad;
       case ComponentType::kCubic:
-        return &cubics_[component.index];
+        cubic = GetCubic(component);
+        return &cubic;
       case ComponentType::kContour:
         return std::monostate{};
     }
@@ -336,15 +488,12 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
     const auto& component = components_[component_i];
     switch (component.type) {
       case ComponentType::kLinear:
-        collect_points(linears_[component.index].CreatePolyline());
+        collect_point(points_[component.index + 1]);
         previous_path_component_index = component_i;
         break;
       case ComponentType::kQuadratic:
-        collect_points(quads_[component.index].CreatePolyline(scale));
-        previous_path_component_index = component_i;
-        break;
       case ComponentType::kCubic:
-        collect_points(cubics_[component.index].CreatePolyline(scale));
+        collect_curve_points();
         previous_path_component_index = component_i;
         break;
       case ComponentType::kContour:
@@ -356,12 +505,11 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
         end_contour();
 
         Vector2 start_direction = compute_contour_start_direction(component_i);
-        const auto& contour = contours_[component.index];
         polyline.contours.push_back({.start_index = polyline.points.size(),
-                                     .is_closed = contour.is_closed,
+                                     .is_closed = component.is_closed,
                                      .start_direction = start_direction});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        collect_point(points_[component.index]);
         break;
     }
     end_contour();
@@ -390,7 +538,7 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
+  if (components_.size() == GetComponentCount(ComponentType::kContour)) {
     return std::nullopt;
   }
 
@@ -410,20 +558,24 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
-    clamp(linear.p1);
-    clamp(linear.p2);
-  }
-
-  for (const auto& quad : quads_) {
-    for (const Point& point : quad.Extrema()) {
-      clamp(point);
-    }
-  }
-
-  for (const auto& cubic : cubics_) {
-    for (const Point& point : cubic.Extrema()) {
-      clamp(point);
+  for (const auto& component : components_) {
+    switch (component.type) {
+      case ComponentType::kLinear:
+        clamp(points_[component.index]);
+        clamp(points_[component.index + 1]);
+        break;
+      case ComponentType::kQuadratic:
+        for (const Point& point : GetQuadratic(component).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kCubic:
+        for (const Point& point : GetCubic(component).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kContour:
+        break;
     }
   }
 
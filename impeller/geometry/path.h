@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
+#include <initializer_list>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -101,6 +103,22 @@ class Path {
 
   bool IsConvex() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Associates a stable identity with the contents of this path.
+  ///
+  ///             Two paths with the same identity are guaranteed to describe
+  ///             the same geometry, so the identity may be used as a key for
+  ///             caching derived data (such as tessellations) across frames.
+  ///             Any mutation of the path components clears the identity.
+  ///
+  /// @param[in]  identity  A non-zero identity. Zero clears the identity.
+  ///
+  void SetIdentity(uint64_t identity);
+
+  /// @brief      The stable identity of this path or std::nullopt if the path
+  ///             contents cannot be identified (or have been mutated).
+  std::optional<uint64_t> GetIdentity() const;
+
   Path& AddLinearComponent(Point p1, Point p2);
 
   Path& AddQuadraticComponent(Point p1, Point cp, Point p2);
@@ -159,8 +177,16 @@ class Path {
 
   void SetConvexity(Convexity value);
 
+  /// Removes all components while retaining the storage of the verb and point
+  /// streams for reuse.
+  void Reset();
+
+  /// An entry in the verb stream.
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
+    /// Denotes whether the contour is closed. Only used by contours.
+    bool is_closed = false;
+    /// Index of the first point of this component in the point stream.
     size_t index = 0;
 
     ComponentIndexPair() {}
@@ -169,13 +195,29 @@ class Path {
         : type(a_type), index(a_index) {}
   };
 
+  static constexpr size_t kComponentTypeCount = 4u;
+
+  void AddComponent(ComponentType type, std::initializer_list<Point> points);
+
+  LinearPathComponent GetLinear(const ComponentIndexPair& component) const;
+
+  QuadraticPathComponent GetQuadratic(
+      const ComponentIndexPair& component) const;
+
+  CubicPathComponent GetCubic(const ComponentIndexPair& component) const;
+
+  ContourComponent GetContour(const ComponentIndexPair& component) const;
+
   FillType fill_ = FillType::kNonZero;
   Convexity convexity_ = Convexity::kUnknown;
+  std::optional<uint64_t> identity_;
+  /// The verb stream. Components are stored in the order they were added.
   std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
-  std::vector<ContourComponent> contours_;
+  /// The point stream. The points of all components are stored contiguously
+  /// in the order of the components.
+  std::vector<Point> points_;
+  /// The number of components of each type, indexed by |ComponentType|.
+  std::array<size_t, kComponentTypeCount> component_counts_ = {};
 };
 
 }  // namespace impeller
@@ -25,6 +25,14 @@ Path PathBuilder::TakePath(FillType fill) {
   return path;
 }
 
+PathBuilder& PathBuilder::Reset() {
+  subpath_start_ = {};
+  current_ = {};
+  convexity_ = Convexity::kUnknown;
+  prototype_.Reset();
+  return *this;
+}
+
 PathBuilder& PathBuilder::MoveTo(Point point, bool relative) {
   current_ = relative ? current_ + point : point;
   subpath_start_ = current_;
@@ -31,6 +31,18 @@ class PathBuilder {
 
   const Path& GetCurrentPath() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Discard the path being built so that a new path can be
+  ///             started.
+  ///
+  ///             The verb and point storage of the builder is retained, so a
+  ///             builder that is reset and reused for many paths stops
+  ///             allocating once it has grown to the size of the largest
+  ///             path. Paths taken from the builder are always copied into
+  ///             storage of exactly their size.
+  ///
+  PathBuilder& Reset();
+
   PathBuilder& SetConvexity(Convexity value);
 
   PathBuilder& MoveTo(Point point, bool relative = false);
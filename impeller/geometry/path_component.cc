@@ -6,6 +6,15 @@
 
 #include <cmath>
 
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMPELLER_PATH_COMPONENT_SIMD_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMPELLER_PATH_COMPONENT_SIMD_SSE
+#endif
+
 namespace impeller {
 
 /*
@@ -108,6 +117,14 @@ std::vector<Point> QuadraticPathComponent::CreatePolyline(Scalar scale) const {
 
 void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
                                                    Scalar scale_factor) const {
+  auto params = ComputeFlatteningParams(scale_factor);
+  auto offset = points.size();
+  points.resize(offset + params.line_count);
+  FlattenQuadratics(this, &params, 1u, points.data() + offset);
+}
+
+QuadraticFlatteningParams QuadraticPathComponent::ComputeFlatteningParams(
+    Scalar scale_factor) const {
   auto tolerance = kDefaultCurveTolerance / scale_factor;
   auto sqrt_tolerance = sqrt(tolerance);
 
@@ -135,17 +152,185 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
   }
   auto u0 = ApproximateParabolaIntegral(a0);
   auto u2 = ApproximateParabolaIntegral(a2);
-  auto uscale = 1 / (u2 - u0);
 
+  QuadraticFlatteningParams params;
+  params.a0 = a0;
+  params.a2 = a2;
+  params.u0 = u0;
+  params.uscale = 1 / (u2 - u0);
   auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
-  auto step = 1 / line_count;
-  for (size_t i = 1; i < line_count; i += 1) {
-    auto u = i * step;
-    auto a = a0 + (a2 - a0) * u;
-    auto t = (ApproximateParabolaIntegral(a) - u0) * uscale;
-    points.emplace_back(Solve(t));
+  params.line_count =
+      std::isfinite(line_count) ? static_cast<size_t>(line_count) : 1u;
+  return params;
+}
+
+namespace {
+
+// Evaluates four subdivision points of a quadratic at a time. Only the
+// flattening loop is vectorized; the per-curve parameters are computed once
+// in scalar code.
+#if defined(IMPELLER_PATH_COMPONENT_SIMD_NEON)
+
+using Float4 = float32x4_t;
+
+inline Float4 Splat(float v) {
+  return vdupq_n_f32(v);
+}
+
+inline Float4 Iota(float base) {
+  const float lanes[4] = {base, base + 1.0f, base + 2.0f, base + 3.0f};
+  return vld1q_f32(lanes);
+}
+
+inline Float4 Add(Float4 a, Float4 b) {
+  return vaddq_f32(a, b);
+}
+
+inline Float4 Sub(Float4 a, Float4 b) {
+  return vsubq_f32(a, b);
+}
+
+inline Float4 Mul(Float4 a, Float4 b) {
+  return vmulq_f32(a, b);
+}
+
+inline Float4 Div(Float4 a, Float4 b) {
+  return vdivq_f32(a, b);
+}
+
+inline Float4 Sqrt(Float4 a) {
+  return vsqrtq_f32(a);
+}
+
+inline void StorePoints(Float4 x, Float4 y, Point* points) {
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  vst2q_f32(reinterpret_cast<float*>(points), (float32x4x2_t{{x, y}}));
+}
+
+#elif defined(IMPELLER_PATH_COMPONENT_SIMD_SSE)
+
+using Float4 = __m128;
+
+inline Float4 Splat(float v) {
+  return _mm_set1_ps(v);
+}
+
+inline Float4 Iota(float base) {
+  return _mm_setr_ps(base, base + 1.0f, base + 2.0f, base + 3.0f);
+}
+
+inline Float4 Add(Float4 a, Float4 b) {
+  return _mm_add_ps(a, b);
+}
+
+inline Float4 Sub(Float4 a, Float4 b) {
+  return _mm_sub_ps(a, b);
+}
+
+inline Float4 Mul(Float4 a, Float4 b) {
+  return _mm_mul_ps(a, b);
+}
+
+inline Float4 Div(Float4 a, Float4 b) {
+  return _mm_div_ps(a, b);
+}
+
+inline Float4 Sqrt(Float4 a) {
+  return _mm_sqrt_ps(a);
+}
+
+inline void StorePoints(Float4 x, Float4 y, Point* points) {
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  auto* dst = reinterpret_cast<float*>(points);
+  _mm_storeu_ps(dst, _mm_unpacklo_ps(x, y));
+  _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(x, y));
+}
+
+#endif
+
+#if defined(IMPELLER_PATH_COMPONENT_SIMD_NEON) || \
+    defined(IMPELLER_PATH_COMPONENT_SIMD_SSE)
+
+inline Float4 ApproximateParabolaIntegral4(Float4 x) {
+  constexpr Scalar d = 0.67;
+  constexpr Scalar d4 = d * d * d * d;
+  auto inner = Add(Splat(d4), Mul(Splat(0.25f), Mul(x, x)));
+  return Div(x, Add(Splat(1.0f - d), Sqrt(Sqrt(inner))));
+}
+
+// Writes the points at indices [1, line_count) of the flattened curve and
+// returns the index of the first point that still needs to be computed.
+size_t FlattenQuadraticSIMD(const QuadraticPathComponent& quad,
+                            const QuadraticFlatteningParams& params,
+                            Point* points) {
+  const auto line_count = params.line_count;
+  if (line_count < 5u) {
+    return 1u;
+  }
+  const auto step = Splat(1.0f / line_count);
+  const auto a0 = Splat(params.a0);
+  const auto da = Splat(params.a2 - params.a0);
+  const auto u0 = Splat(params.u0);
+  const auto uscale = Splat(params.uscale);
+  const auto one = Splat(1.0f);
+  const auto two = Splat(2.0f);
+  const auto p1x = Splat(quad.p1.x);
+  const auto p1y = Splat(quad.p1.y);
+  const auto cpx = Splat(quad.cp.x);
+  const auto cpy = Splat(quad.cp.y);
+  const auto p2x = Splat(quad.p2.x);
+  const auto p2y = Splat(quad.p2.y);
+
+  size_t i = 1u;
+  for (; i + 4u <= line_count; i += 4u) {
+    auto u = Mul(Iota(static_cast<float>(i)), step);
+    auto a = Add(a0, Mul(da, u));
+    auto t = Mul(Sub(ApproximateParabolaIntegral4(a), u0), uscale);
+    auto mt = Sub(one, t);
+    auto w0 = Mul(mt, mt);
+    auto w1 = Mul(two, Mul(mt, t));
+    auto w2 = Mul(t, t);
+    auto x = Add(Add(Mul(w0, p1x), Mul(w1, cpx)), Mul(w2, p2x));
+    auto y = Add(Add(Mul(w0, p1y), Mul(w1, cpy)), Mul(w2, p2y));
+    StorePoints(x, y, points + i - 1u);
   }
-  points.emplace_back(p2);
+  return i;
+}
+
+#else
+
+size_t FlattenQuadraticSIMD(const QuadraticPathComponent& quad,
+                            const QuadraticFlatteningParams& params,
+                            Point* points) {
+  return 1u;
+}
+
+#endif
+
+}  // namespace
+
+size_t FlattenQuadratics(const QuadraticPathComponent* quads,
+                         const QuadraticFlatteningParams* params,
+                         size_t count,
+                         Point* points) {
+  size_t written = 0u;
+  for (size_t q = 0; q < count; q++) {
+    const auto& quad = quads[q];
+    const auto& param = params[q];
+    auto* out = points + written;
+
+    const double step = 1.0 / param.line_count;
+    for (size_t i = FlattenQuadraticSIMD(quad, param, out);
+         i < param.line_count; i++) {
+      auto u = i * step;
+      auto a = param.a0 + (param.a2 - param.a0) * u;
+      auto t = (ApproximateParabolaIntegral(a) - param.u0) * param.uscale;
+      out[i - 1u] = quad.Solve(t);
+    }
+    out[param.line_count - 1u] = quad.p2;
+    written += param.line_count;
+  }
+  return written;
 }
 
 std::vector<Point> QuadraticPathComponent::Extrema() const {
@@ -189,10 +374,15 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
   auto quads = ToQuadraticPathComponents(.1);
-  std::vector<Point> points;
+  std::vector<QuadraticFlatteningParams> params;
+  params.reserve(quads.size());
+  size_t point_count = 0u;
   for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
+    params.push_back(quad.ComputeFlatteningParams(scale));
+    point_count += params.back().line_count;
   }
+  std::vector<Point> points(point_count);
+  FlattenQuadratics(quads.data(), params.data(), quads.size(), points.data());
   return points;
 }
 
@@ -214,6 +404,13 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
 std::vector<QuadraticPathComponent>
 CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   std::vector<QuadraticPathComponent> quads;
+  AppendQuadraticPathComponents(accuracy, quads);
+  return quads;
+}
+
+void CubicPathComponent::AppendQuadraticPathComponents(
+    Scalar accuracy,
+    std::vector<QuadraticPathComponent>& quads) const {
   // The maximum error, as a vector from the cubic to the best approximating
   // quadratic, is proportional to the third derivative, which is constant
   // across the segment. Thus, the error scales down as the third power of
@@ -241,7 +438,6 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
     quads.emplace_back(
         QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
   }
-  return quads;
 }
 
 static inline bool NearEqual(Scalar a, Scalar b, Scalar epsilon) {
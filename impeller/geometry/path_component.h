@@ -47,6 +47,21 @@ struct LinearPathComponent {
   std::optional<Vector2> GetEndDirection() const;
 };
 
+// The parameters used to flatten a single quadratic curve into line segments.
+//
+// These are computed analytically up front (see
+// QuadraticPathComponent::ComputeFlatteningParams) so that the total number of
+// points generated for a batch of curves is known before any point is
+// evaluated.
+struct QuadraticFlatteningParams {
+  Scalar a0 = 0.0f;
+  Scalar a2 = 0.0f;
+  Scalar u0 = 0.0f;
+  Scalar uscale = 0.0f;
+  // The number of points the curve flattens to, including the end point.
+  size_t line_count = 1u;
+};
+
 struct QuadraticPathComponent {
   Point p1;
   Point cp;
@@ -76,6 +91,8 @@ struct QuadraticPathComponent {
   void FillPointsForPolyline(std::vector<Point>& points,
                              Scalar scale_factor) const;
 
+  QuadraticFlatteningParams ComputeFlatteningParams(Scalar scale_factor) const;
+
   std::vector<Point> Extrema() const;
 
   bool operator==(const QuadraticPathComponent& other) const {
@@ -119,6 +136,12 @@ struct CubicPathComponent {
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
       Scalar accuracy) const;
 
+  // Appends the approximating quadratics to |quads| instead of allocating a
+  // new vector.
+  void AppendQuadraticPathComponents(
+      Scalar accuracy,
+      std::vector<QuadraticPathComponent>& quads) const;
+
   CubicPathComponent Subsegment(Scalar t0, Scalar t1) const;
 
   bool operator==(const CubicPathComponent& other) const {
@@ -148,6 +171,27 @@ struct ContourComponent {
   }
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Flattens a batch of quadratic curves into points.
+///
+///             The subdivision points of each curve are evaluated several at a
+///             time using SSE2 or NEON when available, with a scalar fallback
+///             otherwise.
+///
+/// @param[in]  quads   The curves to flatten.
+/// @param[in]  params  The flattening parameters of each curve, as computed
+///                     by |QuadraticPathComponent::ComputeFlatteningParams|.
+/// @param[in]  count   The number of curves in |quads| and |params|.
+/// @param[out] points  The destination for the generated points. This must
+///                     have room for the sum of |line_count| over |params|.
+///
+/// @return     The number of points written to |points|.
+///
+size_t FlattenQuadratics(const QuadraticPathComponent* quads,
+                         const QuadraticFlatteningParams* params,
+                         size_t count,
+                         Point* points);
+
 using PathComponentVariant = std::variant<std::monostate,
                                           const LinearPathComponent*,
                                           const QuadraticPathComponent*,
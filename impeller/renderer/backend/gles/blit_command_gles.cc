@@ -30,9 +30,11 @@ static std::optional<GLuint> ConfigureFBO(
   }
 
   if (TextureGLES::Cast(*texture).IsWrapped()) {
-    // The texture is attached to the default FBO, so there's no need to
-    // create/configure one.
-    gl.BindFramebuffer(fbo_type, 0);
+    // The texture is attached to a framebuffer owned by the embedder, so
+    // there's no need to create/configure one. Returning zero keeps it from
+    // being deleted.
+    gl.BindFramebuffer(fbo_type,
+                       TextureGLES::Cast(*texture).GetFBO().value_or(0));
     return 0;
   }
 
@@ -102,16 +104,27 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
   gl.Disable(GL_DEPTH_TEST);
   gl.Disable(GL_STENCIL_TEST);
 
-  gl.BlitFramebuffer(source_region.origin.x,     // srcX0
-                     source_region.origin.y,     // srcY0
-                     source_region.size.width,   // srcX1
-                     source_region.size.height,  // srcY1
-                     destination_origin.x,       // dstX0
-                     destination_origin.y,       // dstY0
-                     source_region.size.width,   // dstX1
-                     source_region.size.height,  // dstY1
-                     GL_COLOR_BUFFER_BIT,        // mask
-                     GL_NEAREST                  // filter
+  // The destination origin is specified with an upper left origin. The
+  // framebuffers of onscreen surfaces have a lower left origin, which only
+  // makes a difference for copies that don't cover all of them, such as
+  // those of partial repaints.
+  const auto width = source_region.size.width;
+  const auto height = source_region.size.height;
+  auto dst_y = destination_origin.y;
+  if (TextureGLES::Cast(*destination).IsWrapped()) {
+    dst_y = destination->GetSize().height - destination_origin.y - height;
+  }
+
+  gl.BlitFramebuffer(source_region.origin.x,           // srcX0
+                     source_region.origin.y,           // srcY0
+                     source_region.origin.x + width,   // srcX1
+                     source_region.origin.y + height,  // srcY1
+                     destination_origin.x,             // dstX0
+                     dst_y,                            // dstY0
+                     destination_origin.x + width,     // dstX1
+                     dst_y + height,                   // dstY1
+                     GL_COLOR_BUFFER_BIT,              // mask
+                     GL_NEAREST                        // filter
   );
 
   return true;
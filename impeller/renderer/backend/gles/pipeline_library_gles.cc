@@ -8,6 +8,7 @@
 #include <string>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
@@ -201,6 +202,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  fml::FrameCounters::Add(fml::FrameCounters::kPipelineCompilations);
   auto weak_this = weak_from_this();
 
   auto result = reactor_->AddOperation(
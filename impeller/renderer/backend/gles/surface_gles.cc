@@ -6,8 +6,11 @@
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
+#include "impeller/base/validation.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 
@@ -16,13 +19,25 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
     SwapCallback swap_callback,
     GLuint fbo,
     PixelFormat color_format,
-    ISize fbo_size) {
+    ISize fbo_size,
+    std::optional<IRect> clip_rect) {
   TRACE_EVENT0("impeller", "SurfaceGLES::WrapOnScreenFBO");
 
   if (context == nullptr || !context->IsValid() || !swap_callback) {
     return nullptr;
   }
 
+  // A partial repaint renders the clip region offscreen and blits it into the
+  // framebuffer. Rendering directly to the framebuffer is cheaper if the clip
+  // covers all of it.
+  const auto fbo_rect = IRect::MakeSize(fbo_size);
+  if (clip_rect.has_value()) {
+    clip_rect = clip_rect->Intersection(fbo_rect);
+  }
+  const bool requires_blit =
+      clip_rect.has_value() && !(clip_rect.value() == fbo_rect) &&
+      context->GetCapabilities()->SupportsTextureToTextureBlits();
+
   const auto& gl_context = ContextGLES::Cast(*context);
 
   TextureDescriptor color0_tex;
@@ -34,8 +49,8 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   color0_tex.storage_mode = StorageMode::kDevicePrivate;
 
   ColorAttachment color0;
-  color0.texture = std::make_shared<TextureGLES>(
-      gl_context.GetReactor(), color0_tex, TextureGLES::IsWrapped::kWrapped);
+  color0.texture =
+      TextureGLES::WrapFBO(gl_context.GetReactor(), color0_tex, fbo);
   color0.clear_color = Color::DarkSlateGray();
   color0.load_action = LoadAction::kClear;
   color0.store_action = StoreAction::kStore;
@@ -55,24 +70,79 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   stencil0.load_action = LoadAction::kClear;
   stencil0.store_action = StoreAction::kDontCare;
 
-  RenderTarget render_target_desc;
+  if (!requires_blit) {
+    RenderTarget render_target_desc;
+
+    render_target_desc.SetColorAttachment(color0, 0u);
+    render_target_desc.SetStencilAttachment(stencil0);
+
+    return std::unique_ptr<SurfaceGLES>(
+        new SurfaceGLES(context, std::move(swap_callback), render_target_desc));
+  }
 
-  render_target_desc.SetColorAttachment(color0, 0u);
-  render_target_desc.SetStencilAttachment(stencil0);
+  // compositor_context.cc offsets the rendering by the clip origin. Shrinking
+  // the render target to the size of the clip has the same effect as clipping
+  // the rendering but also creates smaller intermediate passes.
+  RenderTarget::AttachmentConfig color_config =
+      RenderTarget::kDefaultColorAttachmentConfig;
+  color_config.clear_color = color0.clear_color;
+  auto render_target_desc =
+      RenderTarget::CreateOffscreen(*context,                   // context
+                                    clip_rect->size,            // size
+                                    "ImpellerOnscreenPartial",  // label
+                                    color_config  // color_attachment_config
+      );
+  if (!render_target_desc.IsValid()) {
+    VALIDATION_LOG << "Could not create the partial repaint render target.";
+    return nullptr;
+  }
 
-  return std::unique_ptr<SurfaceGLES>(
-      new SurfaceGLES(std::move(swap_callback), render_target_desc));
+  auto source_texture = render_target_desc.GetRenderTargetTexture();
+  return std::unique_ptr<SurfaceGLES>(new SurfaceGLES(
+      context, std::move(swap_callback), render_target_desc,
+      std::move(source_texture), std::move(color0.texture), clip_rect.value()));
 }
 
-SurfaceGLES::SurfaceGLES(SwapCallback swap_callback,
-                         const RenderTarget& target_desc)
-    : Surface(target_desc), swap_callback_(std::move(swap_callback)) {}
+SurfaceGLES::SurfaceGLES(std::weak_ptr<Context> context,
+                         SwapCallback swap_callback,
+                         const RenderTarget& target_desc,
+                         std::shared_ptr<Texture> source_texture,
+                         std::shared_ptr<Texture> destination_texture,
+                         std::optional<IRect> clip_rect)
+    : Surface(target_desc),
+      context_(std::move(context)),
+      swap_callback_(std::move(swap_callback)),
+      source_texture_(std::move(source_texture)),
+      destination_texture_(std::move(destination_texture)),
+      clip_rect_(clip_rect) {}
 
 // |Surface|
 SurfaceGLES::~SurfaceGLES() = default;
 
 // |Surface|
 bool SurfaceGLES::Present() const {
+  if (source_texture_ && destination_texture_ && clip_rect_.has_value()) {
+    auto context = context_.lock();
+    if (!context) {
+      return false;
+    }
+    auto blit_command_buffer = context->CreateCommandBuffer();
+    if (!blit_command_buffer) {
+      return false;
+    }
+    blit_command_buffer->SetLabel("Partial Repaint Blit");
+    auto blit_pass = blit_command_buffer->CreateBlitPass();
+    if (!blit_pass) {
+      return false;
+    }
+    blit_pass->AddCopy(source_texture_, destination_texture_, std::nullopt,
+                       clip_rect_->origin);
+    if (!blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+        !blit_command_buffer->SubmitCommands()) {
+      VALIDATION_LOG << "Could not blit the partial repaint to the surface.";
+      return false;
+    }
+  }
   return swap_callback_ ? swap_callback_() : false;
 }
 
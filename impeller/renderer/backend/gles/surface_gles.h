@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/gles/gles.h"
@@ -18,20 +19,51 @@ class SurfaceGLES final : public Surface {
  public:
   using SwapCallback = std::function<bool(void)>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wrap the given framebuffer to create a surface Impeller can
+  ///             render to.
+  ///
+  /// @param[in]  context        The context.
+  /// @param[in]  swap_callback  The callback invoked to present the surface.
+  /// @param[in]  fbo            The framebuffer to wrap.
+  /// @param[in]  color_format   The color format of the framebuffer.
+  /// @param[in]  fbo_size       The size of the framebuffer.
+  /// @param[in]  clip_rect      If set, only this region of the framebuffer
+  ///                            is rendered to. The region is rendered into
+  ///                            an offscreen target the size of the clip
+  ///                            that is copied into the framebuffer at the
+  ///                            clip origin on presentation. The contents of
+  ///                            the framebuffer outside the region are left
+  ///                            untouched. This requires texture to texture
+  ///                            blits and the entire framebuffer is rendered
+  ///                            to if they are not supported.
+  ///
+  /// @return     The wrapped surface or null.
+  ///
   static std::unique_ptr<Surface> WrapFBO(
       const std::shared_ptr<Context>& context,
       SwapCallback swap_callback,
       GLuint fbo,
       PixelFormat color_format,
-      ISize fbo_size);
+      ISize fbo_size,
+      std::optional<IRect> clip_rect = std::nullopt);
 
   // |Surface|
   ~SurfaceGLES() override;
 
  private:
+  std::weak_ptr<Context> context_;
   SwapCallback swap_callback_;
+  std::shared_ptr<Texture> source_texture_;
+  std::shared_ptr<Texture> destination_texture_;
+  std::optional<IRect> clip_rect_;
 
-  SurfaceGLES(SwapCallback swap_callback, const RenderTarget& target_desc);
+  SurfaceGLES(std::weak_ptr<Context> context,
+              SwapCallback swap_callback,
+              const RenderTarget& target_desc,
+              std::shared_ptr<Texture> source_texture = nullptr,
+              std::shared_ptr<Texture> destination_texture = nullptr,
+              std::optional<IRect> clip_rect = std::nullopt);
 
   // |Surface|
   bool Present() const override;
@@ -46,6 +46,15 @@ TextureGLES::TextureGLES(ReactorGLES::Ref reactor,
                          enum IsWrapped wrapped)
     : TextureGLES(std::move(reactor), desc, true) {}
 
+std::shared_ptr<TextureGLES> TextureGLES::WrapFBO(ReactorGLES::Ref reactor,
+                                                  TextureDescriptor desc,
+                                                  GLuint fbo) {
+  auto texture = std::make_shared<TextureGLES>(std::move(reactor), desc,
+                                               IsWrapped::kWrapped);
+  texture->wrapped_fbo_ = fbo;
+  return texture;
+}
+
 TextureGLES::TextureGLES(std::shared_ptr<ReactorGLES> reactor,
                          TextureDescriptor desc,
                          bool is_wrapped)
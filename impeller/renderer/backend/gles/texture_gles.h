@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/texture.h"
@@ -30,6 +32,15 @@ class TextureGLES final : public Texture,
               TextureDescriptor desc,
               IsWrapped wrapped);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a texture that stands for the color attachment of a
+  ///             framebuffer that is owned by the embedder, such as the
+  ///             onscreen framebuffer of a surface.
+  ///
+  static std::shared_ptr<TextureGLES> WrapFBO(ReactorGLES::Ref reactor,
+                                              TextureDescriptor desc,
+                                              GLuint fbo);
+
   // |Texture|
   ~TextureGLES() override;
 
@@ -52,6 +63,9 @@ class TextureGLES final : public Texture,
 
   bool IsWrapped() const { return is_wrapped_; }
 
+  /// @brief  The framebuffer of a texture created by |WrapFBO|.
+  std::optional<GLuint> GetFBO() const { return wrapped_fbo_; }
+
  private:
   friend class AllocatorMTL;
 
@@ -60,6 +74,7 @@ class TextureGLES final : public Texture,
   HandleGLES handle_;
   mutable bool contents_initialized_ = false;
   const bool is_wrapped_;
+  std::optional<GLuint> wrapped_fbo_;
   bool is_valid_ = false;
 
   TextureGLES(std::shared_ptr<ReactorGLES> reactor,
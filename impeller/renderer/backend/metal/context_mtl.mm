@@ -306,6 +306,11 @@ ContextMTL::GetWorkerTaskRunner() const {
   return worker_task_runner_;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ContextMTL::GetConcurrentWorkerTaskRunner() const {
+  return worker_task_runner_;
+}
+
 std::shared_ptr<const fml::SyncSwitch> ContextMTL::GetIsGpuDisabledSyncSwitch()
     const {
   return is_gpu_disabled_sync_switch_;
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/container.h"
+#include "flutter/fml/frame_counters.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/metal/compute_pipeline_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
@@ -106,6 +107,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  fml::FrameCounters::Add(fml::FrameCounters::kPipelineCompilations);
   auto weak_this = weak_from_this();
 
   auto completion_handler =
@@ -167,6 +169,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
       descriptor, promise->get_future()};
   compute_pipelines_[descriptor] = pipeline_future;
+  fml::FrameCounters::Add(fml::FrameCounters::kPipelineCompilations);
   auto weak_this = weak_from_this();
 
   auto completion_handler =
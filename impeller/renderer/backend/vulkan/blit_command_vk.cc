@@ -50,8 +50,8 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   dst_tran.new_layout = vk::ImageLayout::eTransferDstOptimal;
   dst_tran.src_access = {};
   dst_tran.src_stage = vk::PipelineStageFlagBits::eTopOfPipe;
-  dst_tran.dst_access = vk::AccessFlagBits::eShaderRead;
-  dst_tran.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  dst_tran.dst_access = vk::AccessFlagBits::eTransferWrite;
+  dst_tran.dst_stage = vk::PipelineStageFlagBits::eTransfer;
 
   if (!src.SetLayout(src_tran) || !dst.SetLayout(dst_tran)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
@@ -181,10 +181,10 @@ bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
   image_copy.setBufferImageHeight(0);
   image_copy.setImageSubresource(
       vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
-  image_copy.setImageOffset(
-      vk::Offset3D(destination_origin.x, destination_origin.y, 0));
-  image_copy.setImageExtent(vk::Extent3D(destination->GetSize().width,
-                                         destination->GetSize().height, 1));
+  image_copy.setImageOffset(vk::Offset3D(destination_region.origin.x,
+                                         destination_region.origin.y, 0));
+  image_copy.setImageExtent(vk::Extent3D(destination_region.size.width,
+                                         destination_region.size.height, 1));
 
   if (!dst.SetLayout(dst_tran)) {
     VALIDATION_LOG << "Could not encode layout transition.";
@@ -58,6 +58,7 @@ TEST(BlitCommandVkTest, BlitCopyBufferToTextureCommandVK) {
   cmd.destination = context->GetResourceAllocator()->CreateTexture({
       .size = ISize(100, 100),
   });
+  cmd.destination_region = IRect::MakeXYWH(10, 10, 20, 20);
   cmd.source = context->GetResourceAllocator()
                    ->CreateBuffer({
                        .size = 1,
@@ -16,8 +16,9 @@ class TrackedObjectsVK {
  public:
   explicit TrackedObjectsVK(
       const std::weak_ptr<const DeviceHolder>& device_holder,
-      const std::shared_ptr<CommandPoolVK>& pool)
-      : desc_pool_(device_holder) {
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler)
+      : desc_pool_(device_holder, std::move(descriptor_pool_recycler)) {
     if (!pool) {
       return;
     }
@@ -34,13 +35,7 @@ class TrackedObjectsVK {
     if (!buffer_) {
       return;
     }
-    auto pool = pool_.lock();
-    if (!pool) {
-      // The buffer can not be freed if its command pool has been destroyed.
-      buffer_.release();
-      return;
-    }
-    pool->CollectGraphicsCommandBuffer(std::move(buffer_));
+    pool_->CollectGraphicsCommandBuffer(std::move(buffer_));
   }
 
   bool IsValid() const { return is_valid_; }
@@ -86,7 +81,9 @@ class TrackedObjectsVK {
 
  private:
   DescriptorPoolVK desc_pool_;
-  std::weak_ptr<CommandPoolVK> pool_;
+  // The pool must outlive the buffers allocated from it even if its thread
+  // exits while they are in flight.
+  std::shared_ptr<CommandPoolVK> pool_;
   vk::UniqueCommandBuffer buffer_;
   std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::set<std::shared_ptr<const Buffer>> tracked_buffers_;
@@ -100,10 +97,13 @@ CommandEncoderVK::CommandEncoderVK(
     const std::weak_ptr<const DeviceHolder>& device_holder,
     const std::shared_ptr<QueueVK>& queue,
     const std::shared_ptr<CommandPoolVK>& pool,
-    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler)
     : fence_waiter_(std::move(fence_waiter)),
-      tracked_objects_(
-          std::make_shared<TrackedObjectsVK>(device_holder, pool)) {
+      tracked_objects_(std::make_shared<TrackedObjectsVK>(
+          device_holder,
+          pool,
+          std::move(descriptor_pool_recycler))) {
   if (!fence_waiter_ || !tracked_objects_->IsValid() || !queue) {
     return;
   }
@@ -254,6 +254,16 @@ std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
   return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(layout);
 }
 
+std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes) {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(layout,
+                                                                     writes);
+}
+
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
   if (!HasValidationLayers()) {
     return;
@@ -7,6 +7,7 @@
 #include <functional>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -31,10 +32,12 @@ class CommandEncoderVK {
   using SubmitCallback = std::function<void(bool)>;
 
   // Visible for testing.
-  CommandEncoderVK(const std::weak_ptr<const DeviceHolder>& device_holder,
-                   const std::shared_ptr<QueueVK>& queue,
-                   const std::shared_ptr<CommandPoolVK>& pool,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+  CommandEncoderVK(
+      const std::weak_ptr<const DeviceHolder>& device_holder,
+      const std::shared_ptr<QueueVK>& queue,
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::shared_ptr<FenceWaiterVK> fence_waiter,
+      std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler = {});
 
   ~CommandEncoderVK();
 
@@ -65,6 +68,11 @@ class CommandEncoderVK {
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
+  // See |DescriptorPoolVK::AllocateDescriptorSet|.
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes);
+
  private:
   friend class ContextVK;
 
@@ -4,23 +4,72 @@
 
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/thread_local.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 
 namespace impeller {
 
-using CommandPoolMap = std::map<uint64_t, std::shared_ptr<CommandPoolVK>>;
-FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<CommandPoolMap> tls_command_pool;
-
 static Mutex g_all_pools_mutex;
 static std::unordered_map<const ContextVK*,
                           std::vector<std::weak_ptr<CommandPoolVK>>>
     g_all_pools IPLR_GUARDED_BY(g_all_pools_mutex);
+// Pools of exited threads, keyed by the hash of their context.
+static std::unordered_map<uint64_t, std::vector<std::shared_ptr<CommandPoolVK>>>
+    g_orphaned_pools IPLR_GUARDED_BY(g_all_pools_mutex);
+
+// The pools of a single thread keyed by the hash of their context. When the
+// thread exits, its pools are made available to other threads.
+class ThreadLocalCommandPoolsVK {
+ public:
+  ThreadLocalCommandPoolsVK() = default;
+
+  ~ThreadLocalCommandPoolsVK() {
+    Lock pool_lock(g_all_pools_mutex);
+    for (auto& [hash, pool] : pools) {
+      if (!pool->IsValid()) {
+        continue;
+      }
+      auto& orphans = g_orphaned_pools[hash];
+      if (orphans.size() >= CommandPoolVK::kMaxOrphanedPools) {
+        continue;
+      }
+      pool->SetOwner({});
+      orphans.push_back(std::move(pool));
+    }
+  }
+
+  std::map<uint64_t, std::shared_ptr<CommandPoolVK>> pools;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadLocalCommandPoolsVK);
+};
+
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<ThreadLocalCommandPoolsVK>
+    tls_command_pool;
+
+static std::shared_ptr<CommandPoolVK> AdoptOrphanedPool(
+    const ContextVK* context) IPLR_REQUIRES(g_all_pools_mutex) {
+  auto found = g_orphaned_pools.find(context->GetHash());
+  if (found == g_orphaned_pools.end()) {
+    return nullptr;
+  }
+  auto& orphans = found->second;
+  while (!orphans.empty()) {
+    auto pool = std::move(orphans.back());
+    orphans.pop_back();
+    if (pool->IsValid()) {
+      return pool;
+    }
+  }
+  return nullptr;
+}
 
 std::shared_ptr<CommandPoolVK> CommandPoolVK::GetThreadLocal(
     const ContextVK* context) {
@@ -28,28 +77,48 @@ std::shared_ptr<CommandPoolVK> CommandPoolVK::GetThreadLocal(
     return nullptr;
   }
   if (tls_command_pool.get() == nullptr) {
-    tls_command_pool.reset(new CommandPoolMap());
+    tls_command_pool.reset(new ThreadLocalCommandPoolsVK());
   }
-  CommandPoolMap& pool_map = *tls_command_pool.get();
+  auto& pool_map = tls_command_pool.get()->pools;
   auto found = pool_map.find(context->GetHash());
   if (found != pool_map.end() && found->second->IsValid()) {
     return found->second;
   }
-  auto pool = std::shared_ptr<CommandPoolVK>(new CommandPoolVK(context));
+
+  std::shared_ptr<CommandPoolVK> pool;
+  {
+    Lock pool_lock(g_all_pools_mutex);
+    pool = AdoptOrphanedPool(context);
+  }
+  if (pool) {
+    pool->SetOwner(std::this_thread::get_id());
+    pool_map[context->GetHash()] = pool;
+    return pool;
+  }
+
+  pool = std::shared_ptr<CommandPoolVK>(new CommandPoolVK(context));
   if (!pool->IsValid()) {
     return nullptr;
   }
   pool_map[context->GetHash()] = pool;
   {
     Lock pool_lock(g_all_pools_mutex);
-    g_all_pools[context].push_back(pool);
+    auto& all_pools = g_all_pools[context];
+    // Drop the entries of pools that were collected along with their
+    // threads.
+    all_pools.erase(std::remove_if(all_pools.begin(), all_pools.end(),
+                                   [](const auto& weak_pool) {
+                                     return weak_pool.expired();
+                                   }),
+                    all_pools.end());
+    all_pools.push_back(pool);
   }
   return pool;
 }
 
 void CommandPoolVK::ClearAllPools(const ContextVK* context) {
   if (tls_command_pool.get()) {
-    tls_command_pool.get()->erase(context->GetHash());
+    tls_command_pool.get()->pools.erase(context->GetHash());
   }
   Lock pool_lock(g_all_pools_mutex);
   if (auto found = g_all_pools.find(context); found != g_all_pools.end()) {
@@ -65,6 +134,7 @@ void CommandPoolVK::ClearAllPools(const ContextVK* context) {
     }
     g_all_pools.erase(found);
   }
+  g_orphaned_pools.erase(context->GetHash());
 }
 
 CommandPoolVK::CommandPoolVK(const ContextVK* context)
@@ -72,7 +142,10 @@ CommandPoolVK::CommandPoolVK(const ContextVK* context)
   vk::CommandPoolCreateInfo pool_info;
 
   pool_info.queueFamilyIndex = context->GetGraphicsQueue()->GetIndex().family;
-  pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient;
+  // Recycled buffers are reset implicitly when they are begun again unless
+  // the whole pool could be reset before.
+  pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient |
+                    vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
   auto pool = context->GetDevice().createCommandPoolUnique(pool_info);
   if (pool.result != vk::Result::eSuccess) {
     return;
@@ -83,15 +156,26 @@ CommandPoolVK::CommandPoolVK(const ContextVK* context)
   is_valid_ = true;
 }
 
-CommandPoolVK::~CommandPoolVK() = default;
+CommandPoolVK::~CommandPoolVK() {
+  Lock lock(pool_mutex_);
+  if (!device_holder_.lock()) {
+    // The pool and its buffers can not be freed if the device is gone.
+    ReleaseBuffers();
+    graphics_pool_.release();
+  }
+}
 
 bool CommandPoolVK::IsValid() const {
   return is_valid_;
 }
 
 void CommandPoolVK::Reset() {
-  Lock lock(buffers_to_collect_mutex_);
-  GarbageCollectBuffersIfAble();
+  Lock lock(pool_mutex_);
+  // Destroying the pool frees all buffers allocated from it.
+  ReleaseBuffers();
+  if (!device_holder_.lock()) {
+    graphics_pool_.release();
+  }
   graphics_pool_.reset();
   is_valid_ = false;
 }
@@ -100,18 +184,28 @@ vk::CommandPool CommandPoolVK::GetGraphicsCommandPool() const {
   return graphics_pool_.get();
 }
 
+void CommandPoolVK::SetOwner(std::thread::id owner) {
+  Lock lock(pool_mutex_);
+  owner_id_ = owner;
+}
+
 vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
   std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
   if (!strong_device) {
     return {};
   }
-  if (std::this_thread::get_id() != owner_id_) {
+  Lock lock(pool_mutex_);
+  if (std::this_thread::get_id() != owner_id_ || !graphics_pool_) {
     return {};
   }
-  {
-    Lock lock(buffers_to_collect_mutex_);
-    GarbageCollectBuffersIfAble();
+  RecycleRetiredBuffers(strong_device->GetDevice());
+  if (!recycled_buffers_.empty()) {
+    auto buffer = std::move(recycled_buffers_.back());
+    recycled_buffers_.pop_back();
+    buffers_in_flight_++;
+    return buffer;
   }
+
   vk::CommandBufferAllocateInfo alloc_info;
   alloc_info.commandPool = graphics_pool_.get();
   alloc_info.commandBufferCount = 1u;
@@ -121,26 +215,61 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
   if (result != vk::Result::eSuccess) {
     return {};
   }
+  buffers_in_flight_++;
   return std::move(buffers[0]);
 }
 
 void CommandPoolVK::CollectGraphicsCommandBuffer(
     vk::UniqueCommandBuffer buffer) {
-  Lock lock(buffers_to_collect_mutex_);
+  Lock lock(pool_mutex_);
   if (!graphics_pool_) {
     // If the command pool has already been destroyed, then its command buffers
     // have been freed and are now invalid.
     buffer.release();
+    return;
+  }
+  if (buffers_in_flight_ > 0u) {
+    buffers_in_flight_--;
   }
-  buffers_to_collect_.insert(MakeSharedVK(std::move(buffer)));
-  GarbageCollectBuffersIfAble();
+  // Buffers may only be reset or freed on the thread that owns the pool.
+  retired_buffers_.emplace_back(std::move(buffer));
 }
 
-void CommandPoolVK::GarbageCollectBuffersIfAble() {
-  if (std::this_thread::get_id() != owner_id_) {
+size_t CommandPoolVK::GetRecycledBufferCount() const {
+  Lock lock(pool_mutex_);
+  return retired_buffers_.size() + recycled_buffers_.size();
+}
+
+void CommandPoolVK::RecycleRetiredBuffers(const vk::Device& device) {
+  if (retired_buffers_.empty()) {
     return;
   }
-  buffers_to_collect_.clear();
+  TRACE_EVENT0("impeller", "CommandPoolVK::RecycleRetiredBuffers");
+  if (buffers_in_flight_ == 0u) {
+    // None of the buffers are in use by the GPU. Resetting the pool is
+    // cheaper than resetting each buffer as it is begun again.
+    [[maybe_unused]] auto result = device.resetCommandPool(*graphics_pool_);
+  }
+  for (auto& buffer : retired_buffers_) {
+    if (recycled_buffers_.size() >= kMaxRecycledBuffers) {
+      // Frees the buffer.
+      buffer.reset();
+      continue;
+    }
+    recycled_buffers_.emplace_back(std::move(buffer));
+  }
+  retired_buffers_.clear();
+}
+
+void CommandPoolVK::ReleaseBuffers() {
+  for (auto& buffer : retired_buffers_) {
+    buffer.release();
+  }
+  for (auto& buffer : recycled_buffers_) {
+    buffer.release();
+  }
+  retired_buffers_.clear();
+  recycled_buffers_.clear();
 }
 
 }  // namespace impeller
@@ -5,21 +5,42 @@
 #pragma once
 
 #include <memory>
-#include <set>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
-#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
 class ContextVK;
-
+class ThreadLocalCommandPoolsVK;
+
+//------------------------------------------------------------------------------
+/// @brief      A command pool owned by a single thread along with the command
+///             buffers allocated from it.
+///
+///             Command buffers are handed back to the pool once the GPU is
+///             done with them, which may happen on any thread. They are reset
+///             and reused by later calls to |CreateGraphicsCommandBuffer|
+///             instead of being freed. Once none of the buffers of the pool
+///             are in flight, the entire pool is reset at once.
+///
+///             When the thread that owns a pool exits, the pool is kept
+///             around so that another thread using the same context can adopt
+///             it instead of creating a new one.
+///
 class CommandPoolVK {
  public:
+  /// The maximum number of idle command buffers kept for reuse.
+  static constexpr size_t kMaxRecycledBuffers = 16u;
+
+  /// The maximum number of pools of exited threads kept for adoption per
+  /// context.
+  static constexpr size_t kMaxOrphanedPools = 4u;
+
   static std::shared_ptr<CommandPoolVK> GetThreadLocal(
       const ContextVK* context);
 
@@ -35,20 +56,42 @@ class CommandPoolVK {
 
   vk::UniqueCommandBuffer CreateGraphicsCommandBuffer();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Return a command buffer allocated from this pool once the GPU
+  ///             is done with it. May be called on any thread.
+  ///
   void CollectGraphicsCommandBuffer(vk::UniqueCommandBuffer buffer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of idle command buffers that are ready for reuse
+  ///             or waiting to be reset.
+  ///
+  size_t GetRecycledBufferCount() const;
+
  private:
-  const std::thread::id owner_id_;
+  friend class ThreadLocalCommandPoolsVK;
+
   std::weak_ptr<const DeviceHolder> device_holder_;
   vk::UniqueCommandPool graphics_pool_;
-  Mutex buffers_to_collect_mutex_;
-  std::set<SharedHandleVK<vk::CommandBuffer>> buffers_to_collect_
-      IPLR_GUARDED_BY(buffers_to_collect_mutex_);
+  mutable Mutex pool_mutex_;
+  std::thread::id owner_id_ IPLR_GUARDED_BY(pool_mutex_);
+  // Buffers the GPU is done with that have not been reset yet.
+  std::vector<vk::UniqueCommandBuffer> retired_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
+  // Buffers that may be begun again.
+  std::vector<vk::UniqueCommandBuffer> recycled_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
+  size_t buffers_in_flight_ IPLR_GUARDED_BY(pool_mutex_) = 0u;
   bool is_valid_ = false;
 
   explicit CommandPoolVK(const ContextVK* context);
 
-  void GarbageCollectBuffersIfAble() IPLR_REQUIRES(buffers_to_collect_mutex_);
+  void RecycleRetiredBuffers(const vk::Device& device)
+      IPLR_REQUIRES(pool_mutex_);
+
+  void ReleaseBuffers() IPLR_REQUIRES(pool_mutex_);
+
+  void SetOwner(std::thread::id owner);
 
   FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolVK);
 };
@@ -21,6 +21,7 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
@@ -398,6 +399,8 @@ void ContextVK::Setup(Settings settings) {
   queues_ = std::move(queues);
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
+  descriptor_pool_recycler_ =
+      std::make_shared<DescriptorPoolRecyclerVK>(device_holder_);
   device_name_ = std::string(physical_device_properties.deviceName);
   is_valid_ = true;
 
@@ -456,7 +459,7 @@ const vk::Device& ContextVK::GetDevice() const {
   return device_holder_->device.get();
 }
 
-const std::shared_ptr<fml::ConcurrentTaskRunner>
+std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextVK::GetConcurrentWorkerTaskRunner() const {
   return worker_task_runner_;
 }
@@ -526,10 +529,11 @@ std::unique_ptr<CommandEncoderVK> ContextVK::CreateGraphicsCommandEncoder()
     return nullptr;
   }
   auto encoder = std::unique_ptr<CommandEncoderVK>(new CommandEncoderVK(
-      device_holder_,          //
-      queues_.graphics_queue,  //
-      tls_pool,                //
-      fence_waiter_            //
+      device_holder_,            //
+      queues_.graphics_queue,    //
+      tls_pool,                  //
+      fence_waiter_,             //
+      descriptor_pool_recycler_  //
       ));
   if (!encoder->IsValid()) {
     return nullptr;
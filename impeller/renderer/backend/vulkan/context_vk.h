@@ -29,6 +29,7 @@ bool HasValidationLayers();
 
 class CommandEncoderVK;
 class DebugReportVK;
+class DescriptorPoolRecyclerVK;
 class FenceWaiterVK;
 
 class ContextVK final : public Context,
@@ -117,8 +118,9 @@ class ContextVK final : public Context,
 
   const vk::Device& GetDevice() const;
 
-  const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
 
   [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
 
@@ -158,6 +160,7 @@ class ContextVK final : public Context,
   std::shared_ptr<SwapchainVK> swapchain_;
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   const uint64_t hash_;
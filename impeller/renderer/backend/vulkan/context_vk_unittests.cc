@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <thread>
+
 #include "flutter/testing/testing.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -26,6 +28,49 @@ TEST(ContextVKTest, DeletesCommandPools) {
   ASSERT_FALSE(weak_context.lock());
 }
 
+TEST(ContextVKTest, RecyclesCommandBuffers) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  std::shared_ptr<CommandPoolVK> pool =
+      CommandPoolVK::GetThreadLocal(context.get());
+  vk::UniqueCommandBuffer buffer = pool->CreateGraphicsCommandBuffer();
+  ASSERT_TRUE(buffer);
+  vk::CommandBuffer handle = buffer.get();
+  pool->CollectGraphicsCommandBuffer(std::move(buffer));
+  ASSERT_EQ(pool->GetRecycledBufferCount(), 1u);
+
+  vk::UniqueCommandBuffer reused = pool->CreateGraphicsCommandBuffer();
+  ASSERT_EQ(reused.get(), handle);
+  ASSERT_EQ(pool->GetRecycledBufferCount(), 0u);
+
+  // No buffers were in flight, so the pool was reset as a whole.
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  ASSERT_TRUE(std::find(functions->begin(), functions->end(),
+                        "vkResetCommandPool") != functions->end());
+  pool->CollectGraphicsCommandBuffer(std::move(reused));
+}
+
+TEST(ContextVKTest, AdoptsCommandPoolsOfExitedThreads) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  CommandPoolVK* first_pool = nullptr;
+  std::thread first_thread([&]() {
+    first_pool = CommandPoolVK::GetThreadLocal(context.get()).get();
+  });
+  first_thread.join();
+  ASSERT_NE(first_pool, nullptr);
+
+  CommandPoolVK* second_pool = nullptr;
+  std::thread second_thread([&]() {
+    auto pool = CommandPoolVK::GetThreadLocal(context.get());
+    second_pool = pool.get();
+    // The adopted pool is owned by this thread now.
+    auto buffer = pool->CreateGraphicsCommandBuffer();
+    ASSERT_TRUE(buffer);
+    pool->CollectGraphicsCommandBuffer(std::move(buffer));
+  });
+  second_thread.join();
+  ASSERT_EQ(second_pool, first_pool);
+}
+
 TEST(ContextVKTest, DeletePipelineAfterContext) {
   std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline;
   std::shared_ptr<std::vector<std::string>> functions;
@@ -4,19 +4,15 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 
 namespace impeller {
 
-DescriptorPoolVK::DescriptorPoolVK(
-    const std::weak_ptr<const DeviceHolder>& device_holder)
-    : device_holder_(device_holder) {
-  FML_DCHECK(device_holder.lock());
-}
-
-DescriptorPoolVK::~DescriptorPoolVK() = default;
-
 static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
                                            uint32_t pool_count) {
   TRACE_EVENT0("impeller", "CreateDescriptorPool");
@@ -39,6 +35,121 @@ static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
   return std::move(pool);
 }
 
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(
+    std::weak_ptr<const DeviceHolder> device_holder)
+    : device_holder_(std::move(device_holder)) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() {
+  if (device_holder_.lock()) {
+    return;
+  }
+  // The pools can not be destroyed if their device already was.
+  Lock lock(pools_mutex_);
+  for (auto& pool : recycled_pools_) {
+    pool.pool.release();
+  }
+}
+
+DescriptorPoolRecyclerVK::Pool DescriptorPoolRecyclerVK::Get(
+    uint32_t min_size) {
+  uint32_t size = 0u;
+  {
+    Lock lock(pools_mutex_);
+    auto found = std::find_if(
+        recycled_pools_.begin(), recycled_pools_.end(),
+        [min_size](const Pool& pool) { return pool.size >= min_size; });
+    if (found != recycled_pools_.end()) {
+      Pool pool = std::move(*found);
+      recycled_pools_.erase(found);
+      return pool;
+    }
+    size = std::max(min_size, preferred_pool_size_);
+  }
+
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return {};
+  }
+  auto pool = CreatePool(strong_device->GetDevice(), size);
+  if (!pool) {
+    return {};
+  }
+  return {.pool = std::move(pool), .size = size};
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(std::vector<Pool> pools,
+                                       size_t allocated_sets) {
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    // The pools can not be destroyed if their device already was.
+    for (auto& pool : pools) {
+      pool.pool.release();
+    }
+    return;
+  }
+
+  TRACE_EVENT0("impeller", "DescriptorPoolRecyclerVK::Reclaim");
+  Lock lock(pools_mutex_);
+  // Follow increases in demand immediately but decay slowly so that a single
+  // light frame doesn't shrink the pools.
+  const uint32_t demand = Allocation::NextPowerOfTwoSize(static_cast<uint32_t>(
+      std::clamp<size_t>(allocated_sets, kMinPoolSize, 1u << 16u)));
+  preferred_pool_size_ = std::max(
+      {demand, preferred_pool_size_ - preferred_pool_size_ / 8u, kMinPoolSize});
+
+  for (auto& pool : pools) {
+    if (!pool.pool || recycled_pools_.size() >= kMaxRecycledPools ||
+        pool.size < preferred_pool_size_ / 2u) {
+      // Pools that are much smaller than the demand are dropped so that
+      // command buffers don't have to go through many of them.
+      continue;
+    }
+    // Resetting the pool frees all sets allocated from it.
+    strong_device->GetDevice().resetDescriptorPool(*pool.pool);
+    recycled_pools_.emplace_back(std::move(pool));
+  }
+}
+
+size_t DescriptorPoolRecyclerVK::GetRecycledPoolCount() const {
+  Lock lock(pools_mutex_);
+  return recycled_pools_.size();
+}
+
+uint32_t DescriptorPoolRecyclerVK::GetPreferredPoolSize() const {
+  Lock lock(pools_mutex_);
+  return preferred_pool_size_;
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    const std::weak_ptr<const DeviceHolder>& device_holder,
+    std::shared_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_holder_(device_holder), recycler_(std::move(recycler)) {
+  FML_DCHECK(device_holder.lock());
+}
+
+DescriptorPoolVK::~DescriptorPoolVK() {
+  if (recycler_) {
+    recycler_->Reclaim(std::move(pools_), allocated_sets_);
+  }
+}
+
+template <class Handle>
+static uint64_t GetHandleBits(Handle handle) {
+  auto c_handle = static_cast<typename Handle::CType>(handle);
+  uint64_t bits = 0u;
+  std::memcpy(&bits, &c_handle, sizeof(c_handle));
+  return bits;
+}
+
+std::size_t DescriptorPoolVK::SetKey::Hash::operator()(
+    const SetKey& key) const {
+  std::size_t seed = fml::HashCombine(key.layout);
+  for (auto word : key.contents) {
+    fml::HashCombineSeed(seed, word);
+  }
+  return seed;
+}
+
 std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
     const vk::DescriptorSetLayout& layout) {
   auto pool = GetDescriptorPool();
@@ -62,28 +173,81 @@ std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
                    << vk::to_string(result);
     return std::nullopt;
   }
+  allocated_sets_++;
   return sets[0];
 }
 
+std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes) {
+  SetKey key;
+  key.layout = static_cast<VkDescriptorSetLayout>(layout);
+  key.contents.reserve(writes.size() * 6u);
+  for (const auto& write : writes) {
+    key.contents.push_back(write.dstBinding);
+    key.contents.push_back(static_cast<uint64_t>(write.descriptorType));
+    if (write.pBufferInfo) {
+      key.contents.push_back(GetHandleBits(write.pBufferInfo->buffer));
+      key.contents.push_back(write.pBufferInfo->offset);
+      key.contents.push_back(write.pBufferInfo->range);
+    }
+    if (write.pImageInfo) {
+      key.contents.push_back(GetHandleBits(write.pImageInfo->sampler));
+      key.contents.push_back(GetHandleBits(write.pImageInfo->imageView));
+      key.contents.push_back(
+          static_cast<uint64_t>(write.pImageInfo->imageLayout));
+    }
+  }
+
+  if (auto found = cached_sets_.find(key); found != cached_sets_.end()) {
+    return found->second;
+  }
+
+  auto set = AllocateDescriptorSet(layout);
+  if (!set.has_value()) {
+    return std::nullopt;
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return std::nullopt;
+  }
+  for (auto& write : writes) {
+    write.dstSet = set.value();
+  }
+  strong_device->GetDevice().updateDescriptorSets(writes, {});
+  cached_sets_[std::move(key)] = set.value();
+  return set;
+}
+
+size_t DescriptorPoolVK::GetAllocatedSetCount() const {
+  return allocated_sets_;
+}
+
 std::optional<vk::DescriptorPool> DescriptorPoolVK::GetDescriptorPool() {
   if (pools_.empty()) {
     return GrowPool() ? GetDescriptorPool() : std::nullopt;
   }
-  return *pools_.back();
+  return *pools_.back().pool;
 }
 
 bool DescriptorPoolVK::GrowPool() {
   const auto new_pool_size = Allocation::NextPowerOfTwoSize(pool_size_ + 1u);
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
-  if (!strong_device) {
-    return false;
+  DescriptorPoolRecyclerVK::Pool new_pool;
+  if (recycler_) {
+    new_pool = recycler_->Get(new_pool_size);
+  } else {
+    std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+    if (!strong_device) {
+      return false;
+    }
+    new_pool.pool = CreatePool(strong_device->GetDevice(), new_pool_size);
+    new_pool.size = new_pool_size;
   }
-  auto new_pool = CreatePool(strong_device->GetDevice(), new_pool_size);
-  if (!new_pool) {
+  if (!new_pool.pool) {
     return false;
   }
-  pool_size_ = new_pool_size;
-  pools_.push(std::move(new_pool));
+  pool_size_ = new_pool.size;
+  pools_.emplace_back(std::move(new_pool));
   return true;
 }
 
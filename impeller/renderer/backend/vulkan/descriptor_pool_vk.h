@@ -5,14 +5,80 @@
 #pragma once
 
 #include <optional>
-#include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Keeps descriptor pools that are no longer in use so that they
+///             can be reset and handed out again instead of being destroyed
+///             and recreated for every command buffer.
+///
+///             Pools are returned once the fence of the command buffer whose
+///             descriptors they hold has signaled. The size of new pools
+///             follows the number of descriptor sets recently needed by a
+///             single command buffer.
+///
+///             The recycler may be accessed from multiple threads.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  /// The maximum number of pools kept around for reuse.
+  static constexpr size_t kMaxRecycledPools = 32u;
+
+  /// The smallest pool size handed out.
+  static constexpr uint32_t kMinPoolSize = 32u;
+
+  struct Pool {
+    vk::UniqueDescriptorPool pool;
+    /// The number of descriptors of each type the pool was created with.
+    uint32_t size = 0u;
+  };
+
+  explicit DescriptorPoolRecyclerVK(
+      std::weak_ptr<const DeviceHolder> device_holder);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a pool for at least the given number of descriptors of
+  ///             each type. Recycled pools are preferred. New pools are at
+  ///             least as large as the recently observed demand.
+  ///
+  Pool Get(uint32_t min_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reset the given pools and keep them for reuse.
+  ///
+  ///             The descriptor sets allocated from the pools must not be in
+  ///             use anymore.
+  ///
+  /// @param[in]  pools           The pools to reclaim.
+  /// @param[in]  allocated_sets  The number of descriptor sets that were
+  ///                             allocated from the pools. Used to size new
+  ///                             pools.
+  ///
+  void Reclaim(std::vector<Pool> pools, size_t allocated_sets);
+
+  size_t GetRecycledPoolCount() const;
+
+  uint32_t GetPreferredPoolSize() const;
+
+ private:
+  std::weak_ptr<const DeviceHolder> device_holder_;
+  mutable Mutex pools_mutex_;
+  std::vector<Pool> recycled_pools_ IPLR_GUARDED_BY(pools_mutex_);
+  uint32_t preferred_pool_size_ IPLR_GUARDED_BY(pools_mutex_) = kMinPoolSize;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A short-lived dynamically-sized descriptor pool. Descriptors
 ///             from this pool don't need to be freed individually. Instead, the
@@ -23,22 +89,60 @@ namespace impeller {
 ///             threads.
 ///
 ///             Encoders create pools as necessary as they have the same
-///             threading and lifecycle restrictions.
+///             threading and lifecycle restrictions. If a recycler is given,
+///             the underlying Vulkan pools are obtained from and returned to
+///             it.
 ///
 class DescriptorPoolVK {
  public:
   explicit DescriptorPoolVK(
-      const std::weak_ptr<const DeviceHolder>& device_holder);
+      const std::weak_ptr<const DeviceHolder>& device_holder,
+      std::shared_ptr<DescriptorPoolRecyclerVK> recycler = nullptr);
 
   ~DescriptorPoolVK();
 
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given layout whose contents are
+  ///             described by the given writes.
+  ///
+  ///             If a set with the same layout and contents was previously
+  ///             obtained from this pool, that set is returned and no
+  ///             descriptors are updated. Otherwise, a new set is allocated,
+  ///             the destination set of the writes is updated to it, and the
+  ///             writes are applied.
+  ///
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes);
+
+  size_t GetAllocatedSetCount() const;
+
  private:
+  struct SetKey {
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    std::vector<uint64_t> contents;
+
+    struct Hash {
+      std::size_t operator()(const SetKey& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const SetKey& lhs, const SetKey& rhs) const {
+        return lhs.layout == rhs.layout && lhs.contents == rhs.contents;
+      }
+    };
+  };
+
   std::weak_ptr<const DeviceHolder> device_holder_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> recycler_;
   uint32_t pool_size_ = 31u;
-  std::queue<vk::UniqueDescriptorPool> pools_;
+  std::vector<DescriptorPoolRecyclerVK::Pool> pools_;
+  size_t allocated_sets_ = 0u;
+  std::unordered_map<SetKey, vk::DescriptorSet, SetKey::Hash, SetKey::Equal>
+      cached_sets_;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+static size_t CountCalls(const std::vector<std::string>& functions,
+                         const std::string& name) {
+  return std::count(functions.begin(), functions.end(), name);
+}
+
+TEST(DescriptorPoolVKTest, RecyclesPoolsOfCollectedEncoders) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  auto recycler =
+      std::make_shared<DescriptorPoolRecyclerVK>(context->GetDeviceHolder());
+  vk::DescriptorSetLayout layout;
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    ASSERT_TRUE(pool.AllocateDescriptorSet(layout).has_value());
+  }
+  ASSERT_EQ(recycler->GetRecycledPoolCount(), 1u);
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    ASSERT_TRUE(pool.AllocateDescriptorSet(layout).has_value());
+    ASSERT_EQ(recycler->GetRecycledPoolCount(), 0u);
+  }
+  ASSERT_EQ(recycler->GetRecycledPoolCount(), 1u);
+
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  ASSERT_EQ(CountCalls(*functions, "vkCreateDescriptorPool"), 1u);
+  ASSERT_EQ(CountCalls(*functions, "vkResetDescriptorPool"), 2u);
+}
+
+TEST(DescriptorPoolVKTest, PreferredPoolSizeFollowsDemand) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  DescriptorPoolRecyclerVK recycler(context->GetDeviceHolder());
+  ASSERT_EQ(recycler.GetPreferredPoolSize(),
+            DescriptorPoolRecyclerVK::kMinPoolSize);
+  recycler.Reclaim({}, 200u);
+  ASSERT_EQ(recycler.GetPreferredPoolSize(), 256u);
+  // Demand decays slowly.
+  recycler.Reclaim({}, 1u);
+  ASSERT_EQ(recycler.GetPreferredPoolSize(), 224u);
+  ASSERT_EQ(recycler.Get(1u).size, 224u);
+}
+
+TEST(DescriptorPoolVKTest, ReusesIdenticalDescriptorSets) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  DescriptorPoolVK pool(context->GetDeviceHolder());
+  vk::DescriptorSetLayout layout;
+
+  vk::DescriptorBufferInfo buffer_info;
+  buffer_info.offset = 0u;
+  buffer_info.range = 64u;
+  vk::WriteDescriptorSet write;
+  write.dstBinding = 0u;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &buffer_info;
+
+  std::vector<vk::WriteDescriptorSet> writes = {write};
+  auto first = pool.AllocateDescriptorSet(layout, writes);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_EQ(writes[0].dstSet, first.value());
+
+  std::vector<vk::WriteDescriptorSet> same_writes = {write};
+  auto second = pool.AllocateDescriptorSet(layout, same_writes);
+  ASSERT_EQ(second, first);
+  ASSERT_EQ(pool.GetAllocatedSetCount(), 1u);
+
+  buffer_info.offset = 256u;
+  std::vector<vk::WriteDescriptorSet> other_writes = {write};
+  auto third = pool.AllocateDescriptorSet(layout, other_writes);
+  ASSERT_TRUE(third.has_value());
+  ASSERT_NE(third, first);
+  ASSERT_EQ(pool.GetAllocatedSetCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
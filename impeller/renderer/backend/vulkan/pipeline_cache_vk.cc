@@ -6,28 +6,119 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
 #include <sstream>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 
 namespace impeller {
 
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
-static bool VerifyExistingCache(const fml::Mapping& mapping,
-                                const CapabilitiesVK& caps) {
-  return true;
+static_assert(std::is_trivially_copyable_v<PipelineCacheHeaderVK>);
+
+// FNV-1a. Only used to detect truncated or otherwise corrupt cache files.
+static uint64_t HashCacheData(const uint8_t* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK(
+    const vk::PhysicalDeviceProperties& props,
+    const fml::Mapping& data)
+    : api_version(props.apiVersion),
+      driver_version(props.driverVersion),
+      vendor_id(props.vendorID),
+      device_id(props.deviceID),
+      data_size(data.GetSize()),
+      data_hash(HashCacheData(data.GetMapping(), data.GetSize())) {
+  std::memcpy(pipeline_cache_uuid, props.pipelineCacheUUID.data(),
+              sizeof(pipeline_cache_uuid));
 }
 
-static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
-    std::shared_ptr<fml::Mapping> data) {
-  return data;
+bool PipelineCacheHeaderVK::IsCompatibleWith(
+    const PipelineCacheHeaderVK& o) const {
+  return magic == o.magic &&                    //
+         version == o.version &&                //
+         api_version == o.api_version &&        //
+         driver_version == o.driver_version &&  //
+         vendor_id == o.vendor_id &&            //
+         device_id == o.device_id &&            //
+         std::memcmp(pipeline_cache_uuid, o.pipeline_cache_uuid,
+                     sizeof(pipeline_cache_uuid)) == 0;
 }
 
-static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
+// The driver prefixes its data with a header of its own. Check that it
+// matches the device as well in case the driver doesn't.
+static bool VerifyDriverCacheHeader(const vk::PhysicalDeviceProperties& props,
+                                    const uint8_t* data,
+                                    size_t size) {
+  VkPipelineCacheHeaderVersionOne header = {};
+  if (size < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+         header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendorID == props.vendorID &&
+         header.deviceID == props.deviceID &&
+         std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID.data(),
+                     VK_UUID_SIZE) == 0;
+}
+
+std::shared_ptr<fml::Mapping> PipelineCacheVK::DecorateCacheWithMetadata(
+    const vk::PhysicalDeviceProperties& props,
+    const fml::Mapping& data) {
+  const PipelineCacheHeaderVK header(props, data);
+  auto decorated =
+      std::make_shared<std::vector<uint8_t>>(sizeof(header) + data.GetSize());
+  std::memcpy(decorated->data(), &header, sizeof(header));
+  if (data.GetSize() > 0u) {
+    std::memcpy(decorated->data() + sizeof(header), data.GetMapping(),
+                data.GetSize());
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      decorated->data(), decorated->size(), [decorated](auto, auto) {});
+}
+
+std::unique_ptr<fml::Mapping> PipelineCacheVK::RemoveMetadataFromCache(
+    const vk::PhysicalDeviceProperties& props,
     std::unique_ptr<fml::Mapping> data) {
-  return data;
+  if (!data || data->GetMapping() == nullptr ||
+      data->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  PipelineCacheHeaderVK header;
+  std::memcpy(&header, data->GetMapping(), sizeof(header));
+
+  const uint8_t* payload = data->GetMapping() + sizeof(header);
+  const size_t payload_size = data->GetSize() - sizeof(header);
+  const PipelineCacheHeaderVK expected(
+      props, fml::NonOwnedMapping(payload, payload_size));
+  if (!header.IsCompatibleWith(expected)) {
+    FML_LOG(INFO) << "Pipeline cache was created by a different device or "
+                     "driver.";
+    return nullptr;
+  }
+  if (header.data_size != expected.data_size ||
+      header.data_hash != expected.data_hash ||
+      !VerifyDriverCacheHeader(props, payload, payload_size)) {
+    FML_LOG(ERROR) << "Pipeline cache was corrupt.";
+    return nullptr;
+  }
+
+  std::shared_ptr<fml::Mapping> shared_data = std::move(data);
+  return std::make_unique<fml::NonOwnedMapping>(
+      payload, payload_size, [shared_data](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> OpenCacheFile(
@@ -42,14 +133,8 @@ static std::unique_ptr<fml::Mapping> OpenCacheFile(
   if (!mapping) {
     return nullptr;
   }
-  if (!VerifyExistingCache(*mapping, caps)) {
-    return nullptr;
-  }
-  mapping = RemoveMetadataFromCache(std::move(mapping));
-  if (!mapping) {
-    return nullptr;
-  }
-  return mapping;
+  return PipelineCacheVK::RemoveMetadataFromCache(
+      caps.GetPhysicalDeviceProperties(), std::move(mapping));
 }
 
 PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
@@ -66,6 +151,12 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
 
   auto existing_cache_data =
       OpenCacheFile(cache_directory_, kPipelineCacheFileName, vk_caps);
+  if (!existing_cache_data) {
+    // Either there is no cache or it may not be used. Make sure an unusable
+    // cache isn't opened again by the next run if this one exits before
+    // persisting a new one.
+    DiscardCacheFile();
+  }
 
   vk::PipelineCacheCreateInfo cache_info;
 
@@ -85,12 +176,14 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
 
   if (result == vk::Result::eSuccess) {
     cache_ = std::move(existing_cache);
+    loaded_from_disk_ = !!existing_cache_data;
   } else {
     // Even though we perform consistency checks because we don't trust the
     // driver, the driver may have additional information that may cause it to
     // reject the cache too.
     FML_LOG(INFO) << "Existing pipeline cache was invalid: "
                   << vk::to_string(result) << ". Starting with a fresh cache.";
+    DiscardCacheFile();
     cache_info.pInitialData = nullptr;
     cache_info.initialDataSize = 0u;
     auto [result2, new_cache] =
@@ -119,6 +212,20 @@ bool PipelineCacheVK::IsValid() const {
   return is_valid_;
 }
 
+bool PipelineCacheVK::WasLoadedFromDisk() const {
+  return loaded_from_disk_;
+}
+
+void PipelineCacheVK::DiscardCacheFile() const {
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  Lock lock(persist_mutex_);
+  if (fml::FileExists(cache_directory_, kPipelineCacheFileName)) {
+    fml::UnlinkFile(cache_directory_, kPipelineCacheFileName);
+  }
+}
+
 vk::UniquePipeline PipelineCacheVK::CreatePipeline(
     const vk::GraphicsPipelineCreateInfo& info) {
   std::shared_ptr<DeviceHolder> strong_device = device_holder_.lock();
@@ -132,6 +239,8 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create graphics pipeline: "
                    << vk::to_string(result);
+  } else {
+    has_unpersisted_pipelines_ = true;
   }
   return std::move(pipeline);
 }
@@ -149,6 +258,8 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create compute pipeline: "
                    << vk::to_string(result);
+  } else {
+    has_unpersisted_pipelines_ = true;
   }
   return std::move(pipeline);
 }
@@ -179,12 +290,23 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   if (!cache_directory_.is_valid()) {
     return;
   }
+  // The flag is cleared before the data is copied so that pipelines created
+  // in the meantime are persisted by the next call. It is set again unless
+  // the data was written.
+  if (!has_unpersisted_pipelines_.exchange(false)) {
+    return;
+  }
+  fml::ScopedCleanupClosure retry_next_time(
+      [this]() { has_unpersisted_pipelines_ = true; });
+  TRACE_EVENT0("impeller", "PipelineCacheVK::PersistCacheToDisk");
+  Lock lock(persist_mutex_);
   auto data = CopyPipelineCacheData();
   if (!data) {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
+  data = DecorateCacheWithMetadata(
+      CapabilitiesVK::Cast(*caps_).GetPhysicalDeviceProperties(), *data);
   if (!data) {
     VALIDATION_LOG
         << "Could not decorate pipeline cache with additional metadata.";
@@ -194,6 +316,7 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not persist pipeline cache to disk.";
     return;
   }
+  retry_next_time.Release();
 }
 
 }  // namespace impeller
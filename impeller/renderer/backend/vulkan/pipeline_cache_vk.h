@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
@@ -13,6 +16,45 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      The header that is prepended to the pipeline cache data of the
+///             driver when it is persisted to disk.
+///
+///             Pipeline cache data is only usable with the exact driver and
+///             device that produced it. Drivers are expected to reject
+///             incompatible data but are known not to always do so. The
+///             header allows discarding stale or corrupt caches before they
+///             are handed to the driver.
+///
+struct PipelineCacheHeaderVK {
+  /// "IPLR" in little endian.
+  static constexpr uint32_t kMagic = 0x524c5049u;
+  /// The version of this header. Caches with other versions are discarded.
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t api_version = 0u;
+  uint32_t driver_version = 0u;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE] = {};
+  uint64_t data_size = 0u;
+  uint64_t data_hash = 0u;
+
+  PipelineCacheHeaderVK();
+
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        const fml::Mapping& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a cache with this header was created by the same
+  ///             version of the header, device, and driver as a cache with
+  ///             the other header.
+  ///
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& other) const;
+};
+
 class PipelineCacheVK {
  public:
   // The [device] is passed in directly so that it can be used in the
@@ -31,16 +73,52 @@ class PipelineCacheVK {
 
   vk::UniquePipeline CreatePipeline(const vk::ComputePipelineCreateInfo& info);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Write the cache to disk if pipelines were created since it
+  ///             was last persisted.
+  ///
+  ///             This copies the cache data out of the driver and may take a
+  ///             while. It should be called on a worker thread.
+  ///
   void PersistCacheToDisk() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the cache was initialized with data persisted by a
+  ///             previous run.
+  ///
+  bool WasLoadedFromDisk() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prepend the header for the given device to cache data.
+  ///
+  static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
+      const vk::PhysicalDeviceProperties& props,
+      const fml::Mapping& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Validate cache data persisted to disk and strip its header.
+  ///
+  /// @return     The cache data to hand to the driver or nullptr if the data
+  ///             is corrupt or was created for a different device or driver.
+  ///
+  static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
+      const vk::PhysicalDeviceProperties& props,
+      std::unique_ptr<fml::Mapping> data);
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
   const fml::UniqueFD cache_directory_;
   mutable Mutex cache_mutex_;
   vk::UniquePipelineCache cache_ IPLR_GUARDED_BY(cache_mutex_);
+  // Serializes writes to the cache file.
+  mutable Mutex persist_mutex_;
+  mutable std::atomic_bool has_unpersisted_pipelines_ = false;
+  bool loaded_from_disk_ = false;
   bool is_valid_ = false;
 
+  void DiscardCacheFile() const;
+
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineCacheVK);
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+static vk::PhysicalDeviceProperties CreateProperties() {
+  vk::PhysicalDeviceProperties props;
+  props.apiVersion = VK_API_VERSION_1_1;
+  props.driverVersion = 42u;
+  props.vendorID = 0x13b5u;
+  props.deviceID = 0x92020010u;
+  for (size_t i = 0; i < VK_UUID_SIZE; i++) {
+    props.pipelineCacheUUID[i] = static_cast<uint8_t>(i);
+  }
+  return props;
+}
+
+// Pipeline cache data as a driver would return it.
+static std::vector<uint8_t> CreateDriverCacheData(
+    const vk::PhysicalDeviceProperties& props) {
+  VkPipelineCacheHeaderVersionOne header = {};
+  header.headerSize = sizeof(header);
+  header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+  header.vendorID = props.vendorID;
+  header.deviceID = props.deviceID;
+  std::memcpy(header.pipelineCacheUUID, props.pipelineCacheUUID.data(),
+              VK_UUID_SIZE);
+  std::vector<uint8_t> data(sizeof(header) + 64u, 0xab);
+  std::memcpy(data.data(), &header, sizeof(header));
+  return data;
+}
+
+static std::unique_ptr<fml::Mapping> CopyMapping(const fml::Mapping& mapping) {
+  return std::make_unique<fml::DataMapping>(std::vector<uint8_t>(
+      mapping.GetMapping(), mapping.GetMapping() + mapping.GetSize()));
+}
+
+TEST(PipelineCacheVKTest, MetadataRoundTrips) {
+  auto props = CreateProperties();
+  auto data = CreateDriverCacheData(props);
+  auto decorated = PipelineCacheVK::DecorateCacheWithMetadata(
+      props, fml::NonOwnedMapping(data.data(), data.size()));
+  ASSERT_TRUE(decorated);
+  ASSERT_EQ(decorated->GetSize(), data.size() + sizeof(PipelineCacheHeaderVK));
+
+  auto stripped =
+      PipelineCacheVK::RemoveMetadataFromCache(props, CopyMapping(*decorated));
+  ASSERT_TRUE(stripped);
+  ASSERT_EQ(stripped->GetSize(), data.size());
+  ASSERT_EQ(
+      std::memcmp(stripped->GetMapping(), data.data(), stripped->GetSize()),
+      0);
+}
+
+TEST(PipelineCacheVKTest, RejectsCacheOfOtherDriver) {
+  auto props = CreateProperties();
+  auto data = CreateDriverCacheData(props);
+  auto decorated = PipelineCacheVK::DecorateCacheWithMetadata(
+      props, fml::NonOwnedMapping(data.data(), data.size()));
+
+  auto updated_driver = props;
+  updated_driver.driverVersion++;
+  ASSERT_FALSE(PipelineCacheVK::RemoveMetadataFromCache(
+      updated_driver, CopyMapping(*decorated)));
+
+  auto other_device = props;
+  other_device.pipelineCacheUUID[0] ^= 0xffu;
+  ASSERT_FALSE(PipelineCacheVK::RemoveMetadataFromCache(
+      other_device, CopyMapping(*decorated)));
+}
+
+TEST(PipelineCacheVKTest, RejectsCorruptCache) {
+  auto props = CreateProperties();
+  auto data = CreateDriverCacheData(props);
+  auto decorated = PipelineCacheVK::DecorateCacheWithMetadata(
+      props, fml::NonOwnedMapping(data.data(), data.size()));
+  std::vector<uint8_t> bytes(decorated->GetMapping(),
+                             decorated->GetMapping() + decorated->GetSize());
+
+  auto flipped = bytes;
+  flipped.back() ^= 0x01u;
+  ASSERT_FALSE(PipelineCacheVK::RemoveMetadataFromCache(
+      props, std::make_unique<fml::DataMapping>(flipped)));
+
+  auto truncated = bytes;
+  truncated.resize(truncated.size() - 1u);
+  ASSERT_FALSE(PipelineCacheVK::RemoveMetadataFromCache(
+      props, std::make_unique<fml::DataMapping>(truncated)));
+
+  std::vector<uint8_t> too_short(sizeof(PipelineCacheHeaderVK) - 1u, 0u);
+  ASSERT_FALSE(PipelineCacheVK::RemoveMetadataFromCache(
+      props, std::make_unique<fml::DataMapping>(too_short)));
+}
+
+TEST(PipelineCacheVKTest, PrecreatesPipelines) {
+  std::shared_ptr<ContextVK> context = CreateMockVulkanContext();
+  PipelineDescriptor pipeline_desc;
+  pipeline_desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  auto futures =
+      context->GetPipelineLibrary()->PrecreatePipelines({pipeline_desc});
+  ASSERT_EQ(futures.size(), 1u);
+  ASSERT_TRUE(futures[0].Get());
+  // The precreated pipeline is returned for later requests.
+  ASSERT_EQ(context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get(),
+            futures[0].Get());
+}
+
+}  // namespace testing
+}  // namespace impeller
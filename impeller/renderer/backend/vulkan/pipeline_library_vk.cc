@@ -7,6 +7,7 @@
 #include <optional>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
 #include "impeller/base/validation.h"
@@ -468,6 +469,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  fml::FrameCounters::Add(fml::FrameCounters::kPipelineCompilations);
 
   auto weak_this = weak_from_this();
 
@@ -514,6 +516,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
   auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
       descriptor, promise->get_future()};
   compute_pipelines_[descriptor] = pipeline_future;
+  fml::FrameCounters::Add(fml::FrameCounters::kPipelineCompilations);
 
   auto weak_this = weak_from_this();
 
@@ -551,12 +554,26 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+// The cache is first persisted once the application has rendered a few
+// frames and then periodically in case more pipelines were created since. The
+// cache is only written if there are new pipelines.
+static constexpr size_t kFramesBeforeFirstPersist = 50u;
+static constexpr size_t kFramesBetweenPersists = 1000u;
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
-  if (++frames_acquired_ == 50u) {
+  const auto frames = ++frames_acquired_;
+  if (frames == kFramesBeforeFirstPersist ||
+      (frames > kFramesBeforeFirstPersist &&
+       (frames - kFramesBeforeFirstPersist) % kFramesBetweenPersists == 0u)) {
     PersistPipelineCacheToDisk();
   }
 }
 
+// |PipelineLibrary|
+bool PipelineLibraryVK::IsPipelineCacheWarm() const {
+  return pso_cache_->WasLoadedFromDisk();
+}
+
 void PipelineLibraryVK::PersistPipelineCacheToDisk() {
   worker_task_runner_->PostTask(
       [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_)]() {
@@ -32,6 +32,9 @@ class PipelineLibraryVK final
 
   void DidAcquireSurfaceFrame();
 
+  // |PipelineLibrary|
+  bool IsPipelineCacheWarm() const override;
+
  private:
   friend ContextVK;
 
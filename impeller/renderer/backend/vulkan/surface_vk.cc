@@ -6,6 +6,8 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/surface.h"
 
 namespace impeller {
@@ -64,16 +66,102 @@ std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
   render_target_desc.SetColorAttachment(color0, 0u);
 
   // The constructor is private. So make_unique may not be used.
-  return std::unique_ptr<SurfaceVK>(
-      new SurfaceVK(render_target_desc, std::move(swap_callback)));
+  return std::unique_ptr<SurfaceVK>(new SurfaceVK(
+      render_target_desc,       // target
+      context,                  // context
+      swapchain_image,          // swapchain_image
+      std::move(resolve_tex),   // swapchain_texture
+      std::move(swap_callback)  // swap_callback
+      ));
 }
 
-SurfaceVK::SurfaceVK(const RenderTarget& target, SwapCallback swap_callback)
-    : Surface(target), swap_callback_(std::move(swap_callback)) {}
+SurfaceVK::SurfaceVK(const RenderTarget& target,
+                     std::weak_ptr<Context> context,
+                     std::shared_ptr<SwapchainImageVK> swapchain_image,
+                     std::shared_ptr<Texture> swapchain_texture,
+                     SwapCallback swap_callback,
+                     std::shared_ptr<Texture> source_texture,
+                     std::optional<IRect> clip_rect)
+    : Surface(target),
+      context_(std::move(context)),
+      swapchain_image_(std::move(swapchain_image)),
+      swapchain_texture_(std::move(swapchain_texture)),
+      swap_callback_(std::move(swap_callback)),
+      source_texture_(std::move(source_texture)),
+      clip_rect_(clip_rect) {}
 
 SurfaceVK::~SurfaceVK() = default;
 
+std::unique_ptr<SurfaceVK> SurfaceVK::CreateSurfaceForClipRect(
+    IRect clip_rect) const {
+  auto context = context_.lock();
+  if (!context || !swapchain_texture_ || !swapchain_image_ ||
+      !swapchain_image_->IsCopyDestination()) {
+    return nullptr;
+  }
+
+  auto clip = clip_rect.Intersection(IRect::MakeSize(GetSize()));
+  if (!clip.has_value() || clip->size.IsEmpty()) {
+    return nullptr;
+  }
+
+  // compositor_context.cc offsets the rendering by the clip origin. Shrinking
+  // the render target to the size of the clip has the same effect as clipping
+  // the rendering but also creates smaller intermediate passes.
+  RenderTarget::AttachmentConfigMSAA color_config =
+      RenderTarget::kDefaultColorAttachmentConfigMSAA;
+  color_config.clear_color = Color::DarkSlateGray();
+  auto render_target_desc = RenderTarget::CreateOffscreenMSAA(
+      *context,                   // context
+      clip->size,                 // size
+      "ImpellerOnscreenPartial",  // label
+      color_config,               // color_attachment_config
+      std::nullopt                // stencil_attachment_config
+  );
+  if (!render_target_desc.IsValid()) {
+    VALIDATION_LOG << "Could not create the partial repaint render target.";
+    return nullptr;
+  }
+
+  auto source_texture = render_target_desc.GetRenderTargetTexture();
+  return std::unique_ptr<SurfaceVK>(new SurfaceVK(
+      render_target_desc,         // target
+      context,                    // context
+      swapchain_image_,           // swapchain_image
+      swapchain_texture_,         // swapchain_texture
+      swap_callback_,             // swap_callback
+      std::move(source_texture),  // source_texture
+      clip.value()                // clip_rect
+      ));
+}
+
+const std::shared_ptr<SwapchainImageVK>& SurfaceVK::GetSwapchainImage() const {
+  return swapchain_image_;
+}
+
 bool SurfaceVK::Present() const {
+  if (source_texture_ && clip_rect_.has_value()) {
+    auto context = context_.lock();
+    if (!context) {
+      return false;
+    }
+    auto blit_command_buffer = context->CreateCommandBuffer();
+    if (!blit_command_buffer) {
+      return false;
+    }
+    blit_command_buffer->SetLabel("Partial Repaint Blit");
+    auto blit_pass = blit_command_buffer->CreateBlitPass();
+    if (!blit_pass) {
+      return false;
+    }
+    blit_pass->AddCopy(source_texture_, swapchain_texture_, std::nullopt,
+                       clip_rect_->origin);
+    if (!blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+        !blit_command_buffer->SubmitCommands()) {
+      VALIDATION_LOG << "Could not blit the partial repaint to the surface.";
+      return false;
+    }
+  }
   return swap_callback_ ? swap_callback_() : false;
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -25,10 +26,43 @@ class SurfaceVK final : public Surface {
   // |Surface|
   ~SurfaceVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a surface that presents the same swapchain image as
+  ///             this one but only renders the given region of it.
+  ///
+  ///             The region is rendered into an offscreen target the size of
+  ///             the clip that is copied into the swapchain image at the clip
+  ///             origin on presentation. The contents of the swapchain image
+  ///             outside the region are left untouched.
+  ///
+  ///             Only one of this surface and the returned surface may be
+  ///             presented.
+  ///
+  /// @param[in]  clip_rect  The region of the swapchain image to render to.
+  ///
+  /// @return     The surface or null if the region is empty, textures may not
+  ///             be copied into the swapchain image or the offscreen target
+  ///             could not be created.
+  ///
+  std::unique_ptr<SurfaceVK> CreateSurfaceForClipRect(IRect clip_rect) const;
+
+  const std::shared_ptr<SwapchainImageVK>& GetSwapchainImage() const;
+
  private:
+  std::weak_ptr<Context> context_;
+  std::shared_ptr<SwapchainImageVK> swapchain_image_;
+  std::shared_ptr<Texture> swapchain_texture_;
   SwapCallback swap_callback_;
+  std::shared_ptr<Texture> source_texture_;
+  std::optional<IRect> clip_rect_;
 
-  SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
+  SurfaceVK(const RenderTarget& target,
+            std::weak_ptr<Context> context,
+            std::shared_ptr<SwapchainImageVK> swapchain_image,
+            std::shared_ptr<Texture> swapchain_texture,
+            SwapCallback swap_callback,
+            std::shared_ptr<Texture> source_texture = nullptr,
+            std::optional<IRect> clip_rect = std::nullopt);
 
   // |Surface|
   bool Present() const override;
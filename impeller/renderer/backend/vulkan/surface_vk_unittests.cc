@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/surface_vk.h"
+#include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<SwapchainImageVK> CreateSwapchainImage(
+    const std::shared_ptr<ContextVK>& context,
+    const std::shared_ptr<Texture>& backing,
+    bool is_copy_destination) {
+  TextureDescriptor desc;
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = backing->GetTextureDescriptor().format;
+  desc.size = backing->GetSize();
+  return std::make_shared<SwapchainImageVK>(
+      desc, context->GetDevice(), TextureVK::Cast(*backing).GetImage(),
+      is_copy_destination);
+}
+
+}  // namespace
+
+TEST(SurfaceVKTest, ClipRectSurfaceRendersOnlyTheClip) {
+  auto context = CreateMockVulkanContext();
+  // The swapchain sets the offscreen format to its own.
+  context->SetOffscreenFormat(PixelFormat::kB8G8R8A8UNormInt);
+  auto backing = context->GetResourceAllocator()->CreateTexture({
+      .format = PixelFormat::kB8G8R8A8UNormInt,
+      .size = ISize(100, 100),
+  });
+  ASSERT_TRUE(backing);
+  auto swapchain_image = CreateSwapchainImage(context, backing, true);
+  ASSERT_TRUE(swapchain_image->IsValid());
+
+  auto surface = SurfaceVK::WrapSwapchainImage(context, swapchain_image,
+                                               []() { return true; });
+  ASSERT_TRUE(surface);
+  EXPECT_EQ(surface->GetSize(), ISize(100, 100));
+  EXPECT_EQ(surface->GetSwapchainImage(), swapchain_image);
+
+  auto clipped = surface->CreateSurfaceForClipRect(
+      IRect::MakeXYWH(10, 20, 30, 40));
+  ASSERT_TRUE(clipped);
+  EXPECT_EQ(clipped->GetSize(), ISize(30, 40));
+  EXPECT_EQ(clipped->GetSwapchainImage(), swapchain_image);
+
+  // The clip is limited to the swapchain image.
+  clipped = surface->CreateSurfaceForClipRect(IRect::MakeXYWH(80, 90, 50, 50));
+  ASSERT_TRUE(clipped);
+  EXPECT_EQ(clipped->GetSize(), ISize(20, 10));
+
+  EXPECT_FALSE(
+      surface->CreateSurfaceForClipRect(IRect::MakeXYWH(10, 10, 0, 0)));
+}
+
+TEST(SurfaceVKTest, ClipRectSurfaceRequiresCopyableSwapchainImage) {
+  auto context = CreateMockVulkanContext();
+  // The swapchain sets the offscreen format to its own.
+  context->SetOffscreenFormat(PixelFormat::kB8G8R8A8UNormInt);
+  auto backing = context->GetResourceAllocator()->CreateTexture({
+      .format = PixelFormat::kB8G8R8A8UNormInt,
+      .size = ISize(100, 100),
+  });
+  ASSERT_TRUE(backing);
+  auto swapchain_image = CreateSwapchainImage(context, backing, false);
+  ASSERT_TRUE(swapchain_image->IsValid());
+
+  auto surface = SurfaceVK::WrapSwapchainImage(context, swapchain_image,
+                                               []() { return true; });
+  ASSERT_TRUE(surface);
+  EXPECT_FALSE(
+      surface->CreateSurfaceForClipRect(IRect::MakeXYWH(10, 20, 30, 40)));
+}
+
+}  // namespace testing
+}  // namespace impeller
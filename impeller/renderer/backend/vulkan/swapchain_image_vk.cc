@@ -8,8 +8,11 @@ namespace impeller {
 
 SwapchainImageVK::SwapchainImageVK(TextureDescriptor desc,
                                    const vk::Device& device,
-                                   vk::Image image)
-    : TextureSourceVK(desc), image_(image) {
+                                   vk::Image image,
+                                   bool is_copy_destination)
+    : TextureSourceVK(desc),
+      image_(image),
+      is_copy_destination_(is_copy_destination) {
   vk::ImageViewCreateInfo view_info;
   view_info.image = image_;
   view_info.viewType = vk::ImageViewType::e2D;
@@ -43,6 +46,10 @@ ISize SwapchainImageVK::GetSize() const {
   return desc_.size;
 }
 
+bool SwapchainImageVK::IsCopyDestination() const {
+  return is_copy_destination_;
+}
+
 // |TextureSourceVK|
 vk::Image SwapchainImageVK::GetImage() const {
   return image_;
@@ -16,7 +16,8 @@ class SwapchainImageVK final : public TextureSourceVK {
  public:
   SwapchainImageVK(TextureDescriptor desc,
                    const vk::Device& device,
-                   vk::Image image);
+                   vk::Image image,
+                   bool is_copy_destination = false);
 
   // |TextureSourceVK|
   ~SwapchainImageVK() override;
@@ -27,6 +28,12 @@ class SwapchainImageVK final : public TextureSourceVK {
 
   ISize GetSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether textures may be copied into the image. This is
+  ///             necessary for partial repaints.
+  ///
+  bool IsCopyDestination() const;
+
   // |TextureSourceVK|
   vk::Image GetImage() const override;
 
@@ -36,6 +43,7 @@ class SwapchainImageVK final : public TextureSourceVK {
  private:
   vk::Image image_ = VK_NULL_HANDLE;
   vk::UniqueImageView image_view_ = {};
+  const bool is_copy_destination_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SwapchainImageVK);
@@ -197,6 +197,12 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   );
   swapchain_info.imageArrayLayers = 1u;
   swapchain_info.imageUsage = vk::ImageUsageFlagBits::eColorAttachment;
+  // Partial repaints are copied into the swapchain images.
+  const bool supports_copies = static_cast<bool>(
+      caps.supportedUsageFlags & vk::ImageUsageFlagBits::eTransferDst);
+  if (supports_copies) {
+    swapchain_info.imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+  }
   swapchain_info.preTransform = caps.currentTransform;
   swapchain_info.compositeAlpha = composite.value();
   // If we set the clipped value to true, Vulkan expects we will never read back
@@ -236,7 +242,8 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
     auto swapchain_image =
         std::make_shared<SwapchainImageVK>(texture_desc,  // texture descriptor
                                            vk_context.GetDevice(),  // device
-                                           image                    // image
+                                           image,                   // image
+                                           supports_copies  // copy destination
         );
     if (!swapchain_image->IsValid()) {
       VALIDATION_LOG << "Could not create swapchain image.";
@@ -395,8 +402,10 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     LayoutTransition transition;
     transition.new_layout = vk::ImageLayout::ePresentSrcKHR;
     transition.cmd_buffer = vk_final_cmd_buffer;
-    transition.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
-    transition.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    transition.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
+                            vk::AccessFlagBits::eTransferWrite;
+    transition.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+                           vk::PipelineStageFlagBits::eTransfer;
     transition.dst_access = {};
     transition.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
 
@@ -170,6 +170,14 @@ VkResult vkAllocateCommandBuffers(
   return VK_SUCCESS;
 }
 
+VkResult vkResetCommandPool(VkDevice device,
+                            VkCommandPool commandPool,
+                            VkCommandPoolResetFlags flags) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkResetCommandPool");
+  return VK_SUCCESS;
+}
+
 VkResult vkBeginCommandBuffer(VkCommandBuffer commandBuffer,
                               const VkCommandBufferBeginInfo* pBeginInfo) {
   return VK_SUCCESS;
@@ -312,6 +320,54 @@ void vkDestroyPipelineCache(VkDevice device,
   mock_device->called_functions_->push_back("vkDestroyPipelineCache");
 }
 
+VkResult vkCreateDescriptorPool(VkDevice device,
+                                const VkDescriptorPoolCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator,
+                                VkDescriptorPool* pDescriptorPool) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkCreateDescriptorPool");
+  *pDescriptorPool = reinterpret_cast<VkDescriptorPool>(0xd000d000);
+  return VK_SUCCESS;
+}
+
+VkResult vkResetDescriptorPool(VkDevice device,
+                               VkDescriptorPool descriptorPool,
+                               VkDescriptorPoolResetFlags flags) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkResetDescriptorPool");
+  return VK_SUCCESS;
+}
+
+void vkDestroyDescriptorPool(VkDevice device,
+                             VkDescriptorPool descriptorPool,
+                             const VkAllocationCallbacks* pAllocator) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkDestroyDescriptorPool");
+}
+
+VkResult vkAllocateDescriptorSets(
+    VkDevice device,
+    const VkDescriptorSetAllocateInfo* pAllocateInfo,
+    VkDescriptorSet* pDescriptorSets) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkAllocateDescriptorSets");
+  static uint64_t next_descriptor_set = 0xe0000000u;
+  for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+    pDescriptorSets[i] =
+        reinterpret_cast<VkDescriptorSet>(++next_descriptor_set);
+  }
+  return VK_SUCCESS;
+}
+
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkUpdateDescriptorSets");
+}
+
 void vkCmdBindPipeline(VkCommandBuffer commandBuffer,
                        VkPipelineBindPoint pipelineBindPoint,
                        VkPipeline pipeline) {
@@ -374,6 +430,8 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateCommandPool;
   } else if (strcmp("vkAllocateCommandBuffers", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateCommandBuffers;
+  } else if (strcmp("vkResetCommandPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkResetCommandPool;
   } else if (strcmp("vkBeginCommandBuffer", pName) == 0) {
     return (PFN_vkVoidFunction)vkBeginCommandBuffer;
   } else if (strcmp("vkCreateImage", pName) == 0) {
@@ -416,6 +474,16 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkDestroyShaderModule;
   } else if (strcmp("vkDestroyPipelineCache", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyPipelineCache;
+  } else if (strcmp("vkCreateDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateDescriptorPool;
+  } else if (strcmp("vkResetDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkResetDescriptorPool;
+  } else if (strcmp("vkDestroyDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroyDescriptorPool;
+  } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
   } else if (strcmp("vkCmdBindPipeline", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdBindPipeline;
   } else if (strcmp("vkCmdSetStencilReference", pName) == 0) {
@@ -136,8 +136,41 @@ bool BlitPass::AddCopy(BufferView source,
     return false;
   }
 
+  auto destination_region = IRect(destination_origin,
+                                  destination->GetTextureDescriptor().size);
   return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
-                                      destination_origin, std::move(label));
+                                      destination_region, std::move(label));
+}
+
+bool BlitPass::AddCopy(BufferView source,
+                       std::shared_ptr<Texture> destination,
+                       IRect destination_region,
+                       std::string label) {
+  if (!destination) {
+    VALIDATION_LOG << "Attempted to add a texture blit with no destination.";
+    return false;
+  }
+
+  if (destination_region.IsEmpty() ||
+      !IRect::MakeSize(destination->GetTextureDescriptor().size)
+           .Contains(destination_region)) {
+    VALIDATION_LOG
+        << "Attempted to add a texture blit with out of bounds access.";
+    return false;
+  }
+
+  auto bytes_per_pixel =
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  auto bytes_per_region = destination_region.size.Area() * bytes_per_pixel;
+
+  if (source.range.length != bytes_per_region) {
+    VALIDATION_LOG
+        << "Attempted to add a texture blit with out of bounds access.";
+    return false;
+  }
+
+  return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
+                                      destination_region, std::move(label));
 }
 
 bool BlitPass::GenerateMipmap(std::shared_ptr<Texture> texture,
@@ -104,6 +104,28 @@ class BlitPass {
                IPoint destination_origin = {},
                std::string label = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a command to copy the contents of the buffer to a
+  ///             region of the texture.
+  ///             No work is encoded into the command buffer at this time.
+  ///
+  /// @param[in]  source              The buffer view to read for copying. The
+  ///                                 rows of the region must be tightly
+  ///                                 packed.
+  /// @param[in]  destination         The texture to partially overwrite using
+  ///                                 the source contents.
+  /// @param[in]  destination_region  The region of the destination texture to
+  ///                                 overwrite.
+  /// @param[in]  label               The optional debug label to give the
+  ///                                 command.
+  ///
+  /// @return     If the command was valid for subsequent commitment.
+  ///
+  bool AddCopy(BufferView source,
+               std::shared_ptr<Texture> destination,
+               IRect destination_region,
+               std::string label = "");
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command to generate all mip levels for a texture.
   ///             No work is encoded into the command buffer at this time.
@@ -150,7 +172,7 @@ class BlitPass {
   virtual bool OnCopyBufferToTextureCommand(
       BufferView source,
       std::shared_ptr<Texture> destination,
-      IPoint destination_origin,
+      IRect destination_region,
       std::string label) = 0;
 
   virtual bool OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
@@ -14,4 +14,9 @@ bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+Context::GetConcurrentWorkerTaskRunner() const {
+  return nullptr;
+}
+
 }  // namespace impeller
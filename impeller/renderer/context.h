@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
@@ -42,6 +43,17 @@ class Context {
 
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The task runner of a pool of worker threads that may be used
+  ///             to offload CPU work (such as tessellation) from the thread
+  ///             that is encoding commands.
+  ///
+  /// @return     The worker task runner or nullptr if the context was not
+  ///             given one.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
  protected:
   Context();
 
@@ -118,6 +118,12 @@ class RenderPipelineT {
     return pipeline_future_.descriptor;
   }
 
+  /// @brief  The future of the pipeline. Unlike |WaitAndGet|, waiting on a
+  ///         copy of the future is safe from several threads at once.
+  PipelineFuture<PipelineDescriptor> GetPipelineFuture() const {
+    return pipeline_future_;
+  }
+
  private:
   PipelineFuture<PipelineDescriptor> pipeline_future_;
   std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline_;
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/pipeline_library.h"
 
+#include "flutter/fml/trace_event.h"
+
 namespace impeller {
 
 PipelineLibrary::PipelineLibrary() = default;
@@ -32,4 +34,20 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibrary::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+std::vector<PipelineFuture<PipelineDescriptor>>
+PipelineLibrary::PrecreatePipelines(
+    const std::vector<PipelineDescriptor>& descriptors) {
+  TRACE_EVENT0("impeller", "PipelineLibrary::PrecreatePipelines");
+  std::vector<PipelineFuture<PipelineDescriptor>> futures;
+  futures.reserve(descriptors.size());
+  for (const auto& descriptor : descriptors) {
+    futures.push_back(GetPipeline(descriptor));
+  }
+  return futures;
+}
+
+bool PipelineLibrary::IsPipelineCacheWarm() const {
+  return false;
+}
+
 }  // namespace impeller
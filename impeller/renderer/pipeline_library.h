@@ -5,6 +5,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "compute_pipeline_descriptor.h"
 #include "flutter/fml/macros.h"
@@ -47,6 +48,25 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start creating pipelines for the given descriptors ahead of
+  ///             their first use.
+  ///
+  ///             This is meant to be called during engine startup with the
+  ///             pipelines the first frames are known to need.
+  ///
+  /// @return     The futures of the pipelines, in the order of the
+  ///             descriptors.
+  ///
+  std::vector<PipelineFuture<PipelineDescriptor>> PrecreatePipelines(
+      const std::vector<PipelineDescriptor>& descriptors);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether pipelines are created from driver binaries persisted
+  ///             by a previous run, instead of compiling their shaders.
+  ///
+  virtual bool IsPipelineCacheWarm() const;
+
  protected:
   PipelineLibrary();
 
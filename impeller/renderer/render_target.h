@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +18,40 @@ namespace impeller {
 
 class Context;
 
+//------------------------------------------------------------------------------
+/// @brief      Creates the textures that back offscreen render targets.
+///
+///             The default implementation forwards every request to the
+///             resource allocator. Subclasses may recycle textures across
+///             frames, in which case each frame is bracketed by calls to
+///             |Start| and |End|.
+///
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator();
+
+  virtual std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the beginning of a frame.
+  ///
+  virtual void Start();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. All textures created since the
+  ///             matching call to |Start| may still be in use by the GPU.
+  ///
+  virtual void End();
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget final {
  public:
   struct AttachmentConfig {
@@ -61,6 +96,15 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   static RenderTarget CreateOffscreenMSAA(
       const Context& context,
       ISize size,
@@ -70,6 +114,16 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultColorAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   RenderTarget();
 
   ~RenderTarget();
@@ -83,6 +137,14 @@ class RenderTarget final {
                               AttachmentConfig stencil_attachment_config =
                                   kDefaultStencilAttachmentConfig);
 
+  void SetupStencilAttachment(const Context& context,
+                              RenderTargetAllocator& allocator,
+                              ISize size,
+                              bool msaa,
+                              const std::string& label = "Offscreen",
+                              AttachmentConfig stencil_attachment_config =
+                                  kDefaultStencilAttachmentConfig);
+
   SampleCount GetSampleCount() const;
 
   bool HasColorAttachment(size_t index) const;
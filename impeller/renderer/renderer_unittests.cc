@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/device_buffer_descriptor.h"
@@ -692,6 +693,70 @@ TEST_P(RendererTest, CanBlitTextureToBuffer) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(RendererTest, CanBlitBufferToTextureRegion) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  if (!context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    GTEST_SKIP_("Buffer to texture blits are not supported.");
+  }
+  auto allocator = context->GetResourceAllocator();
+
+  TextureDescriptor texture_desc;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = {16, 16};
+  texture_desc.mip_count = 1u;
+  auto texture = allocator->CreateTexture(texture_desc);
+  ASSERT_TRUE(texture);
+  const std::vector<uint8_t> initial_contents(
+      texture_desc.GetByteSizeOfBaseMipLevel(), 0x11);
+  ASSERT_TRUE(
+      texture->SetContents(initial_contents.data(), initial_contents.size()));
+
+  const auto region = IRect::MakeXYWH(4, 6, 8, 3);
+  const std::vector<uint8_t> region_contents(region.size.Area() * 4, 0xee);
+  auto region_buffer = allocator->CreateBufferWithCopy(region_contents.data(),
+                                                       region_contents.size());
+  ASSERT_TRUE(region_buffer);
+
+  DeviceBufferDescriptor readback_desc;
+  readback_desc.storage_mode = StorageMode::kHostVisible;
+  readback_desc.size = texture_desc.GetByteSizeOfBaseMipLevel();
+  auto readback_buffer = allocator->CreateBuffer(readback_desc);
+  ASSERT_TRUE(readback_buffer);
+
+  auto submit_and_wait = [&context](auto record) {
+    auto buffer = context->CreateCommandBuffer();
+    ASSERT_TRUE(buffer);
+    auto pass = buffer->CreateBlitPass();
+    ASSERT_TRUE(pass);
+    record(*pass);
+    ASSERT_TRUE(pass->EncodeCommands(context->GetResourceAllocator()));
+    fml::AutoResetWaitableEvent latch;
+    ASSERT_TRUE(buffer->SubmitCommands(
+        [&latch](CommandBuffer::Status status) { latch.Signal(); }));
+    latch.Wait();
+  };
+
+  submit_and_wait([&](BlitPass& pass) {
+    ASSERT_TRUE(pass.AddCopy(region_buffer->AsBufferView(), texture, region));
+  });
+  submit_and_wait([&](BlitPass& pass) {
+    ASSERT_TRUE(pass.AddCopy(texture, readback_buffer));
+  });
+
+  // Only the texels in the region are overwritten.
+  const uint8_t* texels = readback_buffer->AsBufferView().contents;
+  for (int64_t y = 0; y < texture_desc.size.height; y++) {
+    for (int64_t x = 0; x < texture_desc.size.width; x++) {
+      const uint8_t expected = region.Contains(IPoint(x, y)) ? 0xee : 0x11;
+      const uint8_t* texel = texels + (y * texture_desc.size.width + x) * 4;
+      for (size_t channel = 0; channel < 4; channel++) {
+        ASSERT_EQ(texel[channel], expected) << "at " << x << ", " << y;
+      }
+    }
+  }
+}
+
 TEST_P(RendererTest, CanGenerateMipmaps) {
   auto context = GetContext();
   ASSERT_TRUE(context);
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/tessellator/batch_tessellator.h"
+
+#include "flutter/fml/parallel_for.h"
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<Tessellator> tls_tessellator;
+
+Tessellator& GetThreadLocalTessellator() {
+  if (tls_tessellator.get() == nullptr) {
+    tls_tessellator.reset(new Tessellator());
+  }
+  return *tls_tessellator.get();
+}
+
+}  // namespace
+
+TessellationOutput BatchTessellator::TessellateJob(const TessellationJob& job) {
+  TessellationOutput output;
+  if (job.path == nullptr) {
+    output.result = Tessellator::Result::kInputError;
+    return output;
+  }
+  output.result = GetThreadLocalTessellator().Tessellate(
+      job.fill_type, job.path->CreatePolyline(job.scale),
+      [&output](const float* vertices, size_t vertices_size,
+                const uint16_t* indices, size_t indices_size) {
+        output.vertices.assign(vertices, vertices + vertices_size);
+        output.indices.assign(indices, indices + indices_size);
+        return true;
+      });
+  return output;
+}
+
+std::vector<TessellationOutput> BatchTessellator::Tessellate(
+    const std::vector<TessellationJob>& jobs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", "BatchTessellator::Tessellate");
+  std::vector<TessellationOutput> outputs(jobs.size());
+  fml::ParallelFor(
+      jobs.size(),
+      [&](size_t index) { outputs[index] = TessellateJob(jobs[index]); },
+      worker_task_runner, "BatchTessellator::WorkerTask");
+  return outputs;
+}
+
+}  // namespace impeller
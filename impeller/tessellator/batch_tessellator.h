@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/path.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+/// A single path to be tessellated as part of a batch.
+struct TessellationJob {
+  /// The path to tessellate. It must outlive the call to
+  /// |BatchTessellator::Tessellate|.
+  const Path* path = nullptr;
+  FillType fill_type = FillType::kNonZero;
+  /// The scale factor passed to |Path::CreatePolyline|.
+  Scalar scale = 1.0f;
+};
+
+/// The triangles generated for a single |TessellationJob|.
+struct TessellationOutput {
+  Tessellator::Result result = Tessellator::Result::kInputError;
+  /// Vertex positions as (x, y) pairs.
+  std::vector<float> vertices;
+  std::vector<uint16_t> indices;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Tessellates batches of independent paths concurrently.
+///
+///             Jobs are distributed among the calling thread and the workers
+///             of a concurrent message loop. Each thread uses its own
+///             thread-local |Tessellator| since the underlying libtess2
+///             tessellator is not thread safe.
+///
+class BatchTessellator {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Tessellate all jobs and wait for them to complete.
+  ///
+  ///             The calling thread participates in the work, so this does
+  ///             not deadlock when called from a worker thread or when all
+  ///             workers are busy. If no worker task runner is given, all
+  ///             jobs are tessellated on the calling thread.
+  ///
+  /// @param[in]  jobs                The paths to tessellate.
+  /// @param[in]  worker_task_runner  The task runner of the worker pool.
+  ///
+  /// @return     One output per job, in the order of the jobs.
+  ///
+  static std::vector<TessellationOutput> Tessellate(
+      const std::vector<TessellationJob>& jobs,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Tessellate a single job on the calling thread using the
+  ///             thread-local tessellator.
+  ///
+  static TessellationOutput TessellateJob(const TessellationJob& job);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(BatchTessellator);
+};
+
+}  // namespace impeller
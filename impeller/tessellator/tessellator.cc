@@ -4,6 +4,9 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -31,8 +34,24 @@ static TESSalloc alloc = {
     0                                    /* =extraVertices */
 };
 
+// The largest contour handed to the ear clipping triangulator. Ear clipping
+// is quadratic in the number of reflex vertices, so very large contours are
+// left to libtess2.
+static constexpr size_t kMaxSimplePolygonPoints = 1024u;
+
+struct Tessellator::SimplePolygonScratch {
+  std::vector<Point> points;
+  std::vector<uint16_t> edge_order;
+  std::vector<uint16_t> prev;
+  std::vector<uint16_t> next;
+  std::vector<uint16_t> reflex;
+  std::vector<uint8_t> removed;
+  std::vector<uint16_t> indices;
+};
+
 Tessellator::Tessellator()
-    : c_tessellator_(::tessNewTess(&alloc), &DestroyTessellator) {}
+    : c_tessellator_(::tessNewTess(&alloc), &DestroyTessellator),
+      scratch_(std::make_unique<SimplePolygonScratch>()) {}
 
 Tessellator::~Tessellator() = default;
 
@@ -55,7 +74,7 @@ static int ToTessWindingRule(FillType fill_type) {
 Tessellator::Result Tessellator::Tessellate(
     FillType fill_type,
     const Path::Polyline& polyline,
-    const BuilderCallback& callback) const {
+    const BuilderCallback& callback) {
   if (!callback) {
     return Result::kInputError;
   }
@@ -64,6 +83,32 @@ Tessellator::Result Tessellator::Tessellate(
     return Result::kInputError;
   }
 
+  if (fill_type == FillType::kNonZero || fill_type == FillType::kOdd) {
+    // Both fill rules fill the entire interior of a simple polygon,
+    // regardless of its winding direction.
+    size_t contour_count = 0u;
+    size_t contour_start = 0u;
+    size_t contour_end = 0u;
+    for (size_t contour_i = 0; contour_i < polyline.contours.size();
+         contour_i++) {
+      auto [start, end] = polyline.GetContourPointBounds(contour_i);
+      if (start == end) {
+        continue;
+      }
+      contour_count++;
+      contour_start = start;
+      contour_end = end;
+    }
+    if (contour_count == 1u) {
+      auto result = TessellateSimplePolygon(
+          polyline.points.data() + contour_start, contour_end - contour_start,
+          callback);
+      if (result.has_value()) {
+        return result.value();
+      }
+    }
+  }
+
   auto tessellator = c_tessellator_.get();
   if (!tessellator) {
     return Result::kTessellationError;
@@ -122,6 +167,270 @@ Tessellator::Result Tessellator::Tessellate(
   return Result::kSuccess;
 }
 
+//------------------------------------------------------------------------------
+/// Simple polygon triangulation.
+///
+
+static Scalar Orientation(const Point& a, const Point& b, const Point& c) {
+  return (b - a).Cross(c - a);
+}
+
+// Whether `p`, known to be collinear with `a` and `b`, lies on the segment
+// between them.
+static bool IsOnSegment(const Point& a, const Point& b, const Point& p) {
+  return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+         std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+// Whether the segments intersect, including when they merely touch.
+static bool SegmentsIntersect(const Point& a0,
+                              const Point& a1,
+                              const Point& b0,
+                              const Point& b1) {
+  auto d0 = Orientation(b0, b1, a0);
+  auto d1 = Orientation(b0, b1, a1);
+  auto d2 = Orientation(a0, a1, b0);
+  auto d3 = Orientation(a0, a1, b1);
+  if (((d0 > 0 && d1 < 0) || (d0 < 0 && d1 > 0)) &&
+      ((d2 > 0 && d3 < 0) || (d2 < 0 && d3 > 0))) {
+    return true;
+  }
+  return (d0 == 0 && IsOnSegment(b0, b1, a0)) ||
+         (d1 == 0 && IsOnSegment(b0, b1, a1)) ||
+         (d2 == 0 && IsOnSegment(a0, a1, b0)) ||
+         (d3 == 0 && IsOnSegment(a0, a1, b1));
+}
+
+// Whether the closed polygon formed by `points` has no self-intersections.
+// Edges are swept in order of their minimum x coordinate so that only edges
+// with overlapping x extents are tested against each other.
+static bool IsSimplePolygon(const std::vector<Point>& points,
+                            std::vector<uint16_t>& edge_order) {
+  const size_t count = points.size();
+  auto edge_start = [&](size_t i) { return points[i]; };
+  auto edge_end = [&](size_t i) { return points[i + 1 == count ? 0 : i + 1]; };
+
+  for (size_t i = 0; i < count; i++) {
+    // Adjacent edges may only share their common vertex. They overlap if the
+    // contour doubles back on itself.
+    auto prev = edge_start(i == 0 ? count - 1 : i - 1);
+    auto in = edge_start(i) - prev;
+    auto out = edge_end(i) - edge_start(i);
+    if (in.Cross(out) == 0 && in.Dot(out) < 0) {
+      return false;
+    }
+  }
+
+  edge_order.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    edge_order[i] = static_cast<uint16_t>(i);
+  }
+  auto min_x = [&](size_t i) {
+    return std::min(edge_start(i).x, edge_end(i).x);
+  };
+  auto max_x = [&](size_t i) {
+    return std::max(edge_start(i).x, edge_end(i).x);
+  };
+  std::sort(edge_order.begin(), edge_order.end(),
+            [&](uint16_t a, uint16_t b) { return min_x(a) < min_x(b); });
+
+  for (size_t i = 0; i < count; i++) {
+    const size_t a = edge_order[i];
+    const auto a0 = edge_start(a);
+    const auto a1 = edge_end(a);
+    const auto a_max_x = max_x(a);
+    const auto a_min_y = std::min(a0.y, a1.y);
+    const auto a_max_y = std::max(a0.y, a1.y);
+    for (size_t j = i + 1; j < count && min_x(edge_order[j]) <= a_max_x; j++) {
+      const size_t b = edge_order[j];
+      const size_t distance = a > b ? a - b : b - a;
+      if (distance == 1 || distance == count - 1) {
+        continue;
+      }
+      const auto b0 = edge_start(b);
+      const auto b1 = edge_end(b);
+      if (std::max(b0.y, b1.y) < a_min_y || std::min(b0.y, b1.y) > a_max_y) {
+        continue;
+      }
+      if (SegmentsIntersect(a0, a1, b0, b1)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::optional<Tessellator::Result> Tessellator::TessellateSimplePolygon(
+    const Point* contour_points,
+    size_t contour_point_count,
+    const BuilderCallback& callback) {
+  if (contour_point_count > kMaxSimplePolygonPoints) {
+    return std::nullopt;
+  }
+  auto& scratch = *scratch_;
+
+  //----------------------------------------------------------------------------
+  /// Drop repeated points, including the point that closes the contour.
+  ///
+  auto& points = scratch.points;
+  points.clear();
+  for (size_t i = 0; i < contour_point_count; i++) {
+    if (points.empty() || points.back() != contour_points[i]) {
+      points.push_back(contour_points[i]);
+    }
+  }
+  while (points.size() > 1 && points.back() == points.front()) {
+    points.pop_back();
+  }
+  const size_t count = points.size();
+  if (count < 3) {
+    return std::nullopt;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Classify the contour.
+  ///
+  Scalar area = 0;
+  for (size_t i = 0; i < count; i++) {
+    area += points[i].Cross(points[i + 1 == count ? 0 : i + 1]);
+  }
+  if (!std::isfinite(area) || area == 0) {
+    return std::nullopt;
+  }
+  if (!IsSimplePolygon(points, scratch.edge_order)) {
+    return std::nullopt;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Clip ears.
+  ///
+  // Flip the sign of all orientation tests for clockwise contours so that
+  // convex vertices always have a positive orientation.
+  const Scalar sign = area > 0 ? 1.0f : -1.0f;
+  auto& prev = scratch.prev;
+  auto& next = scratch.next;
+  auto& removed = scratch.removed;
+  auto& reflex = scratch.reflex;
+  auto& indices = scratch.indices;
+  prev.resize(count);
+  next.resize(count);
+  removed.assign(count, 0u);
+  reflex.clear();
+  indices.clear();
+  for (size_t i = 0; i < count; i++) {
+    prev[i] = static_cast<uint16_t>(i == 0 ? count - 1 : i - 1);
+    next[i] = static_cast<uint16_t>(i + 1 == count ? 0 : i + 1);
+    if (sign * Orientation(points[prev[i]], points[i], points[next[i]]) <= 0) {
+      reflex.push_back(static_cast<uint16_t>(i));
+    }
+  }
+
+  // Only non-convex vertices can lie within a candidate ear, and clipping
+  // ears never turns a convex vertex into a non-convex one. Vertices that
+  // have become convex since are still tested, which is merely conservative.
+  auto is_ear = [&](uint16_t a, uint16_t b, uint16_t c) {
+    for (auto r : reflex) {
+      if (removed[r] || r == a || r == b || r == c) {
+        continue;
+      }
+      const auto& p = points[r];
+      if (sign * Orientation(points[a], points[b], p) >= 0 &&
+          sign * Orientation(points[b], points[c], p) >= 0 &&
+          sign * Orientation(points[c], points[a], p) >= 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto unlink = [&](uint16_t i) {
+    next[prev[i]] = next[i];
+    prev[next[i]] = prev[i];
+    removed[i] = 1u;
+  };
+
+  size_t remaining = count;
+  size_t stalled = 0u;
+  uint16_t current = 0u;
+  while (remaining > 3) {
+    const uint16_t a = prev[current];
+    const uint16_t c = next[current];
+    const auto orientation =
+        sign * Orientation(points[a], points[current], points[c]);
+    if (orientation == 0) {
+      // Collinear vertices contribute no area.
+      unlink(current);
+    } else if (orientation > 0 && is_ear(a, current, c)) {
+      indices.push_back(a);
+      indices.push_back(current);
+      indices.push_back(c);
+      unlink(current);
+    } else {
+      current = c;
+      if (++stalled > remaining) {
+        // Only reachable due to floating point error. Let libtess2 handle it.
+        return std::nullopt;
+      }
+      continue;
+    }
+    remaining--;
+    stalled = 0u;
+    current = a;
+  }
+  indices.push_back(prev[current]);
+  indices.push_back(current);
+  indices.push_back(next[current]);
+
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  if (!callback(reinterpret_cast<const float*>(points.data()), count * 2,
+                indices.data(), indices.size())) {
+    return Result::kInputError;
+  }
+  return Result::kSuccess;
+}
+
+void Tessellator::AddPreparedTessellation(const void* owner,
+                                          const Path* path,
+                                          FillType fill_type,
+                                          Scalar scale,
+                                          PreparedTessellation tessellation) {
+  prepared_.emplace(path, PreparedEntry{
+                              .owner = owner,
+                              .fill_type = fill_type,
+                              .scale = scale,
+                              .tessellation = std::move(tessellation),
+                          });
+}
+
+std::optional<Tessellator::PreparedTessellation>
+Tessellator::TakePreparedTessellation(const Path* path,
+                                      FillType fill_type,
+                                      Scalar scale) {
+  auto [begin, end] = prepared_.equal_range(path);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second.fill_type == fill_type && it->second.scale == scale) {
+      auto tessellation = std::move(it->second.tessellation);
+      prepared_.erase(it);
+      return tessellation;
+    }
+  }
+  return std::nullopt;
+}
+
+void Tessellator::DiscardPreparedTessellations(const void* owner) {
+  for (auto it = prepared_.begin(); it != prepared_.end();) {
+    if (it->second.owner == owner) {
+      it = prepared_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t Tessellator::GetPreparedTessellationCount() const {
+  return prepared_.size();
+}
+
 void DestroyTessellator(TESStesselator* tessellator) {
   if (tessellator != nullptr) {
     ::tessDeleteTess(tessellator);
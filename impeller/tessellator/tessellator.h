@@ -6,6 +6,8 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -30,6 +32,9 @@ enum class WindingOrder {
 /// @brief      A utility that generates triangles of the specified fill type
 ///             given a polyline. This happens on the CPU.
 ///
+///             A tessellator reuses buffers across calls and is not thread
+///             safe. Each thread that tessellates must own one.
+///
 /// @bug        This should just be called a triangulator.
 ///
 class Tessellator {
@@ -53,6 +58,11 @@ class Tessellator {
   /// @brief      Generates filled triangles from the polyline. A callback is
   ///             invoked once for the entire tessellation.
   ///
+  ///             Polylines consisting of a single simple (that is, not
+  ///             self-intersecting) contour filled with the even-odd or
+  ///             non-zero rule are triangulated by ear clipping. All other
+  ///             polylines are handed to libtess2.
+  ///
   /// @param[in]  fill_type The fill rule to use when filling.
   /// @param[in]  polyline  The polyline
   /// @param[in]  callback  The callback, return false to indicate failure.
@@ -61,10 +71,77 @@ class Tessellator {
   ///
   Tessellator::Result Tessellate(FillType fill_type,
                                  const Path::Polyline& polyline,
-                                 const BuilderCallback& callback) const;
+                                 const BuilderCallback& callback);
+
+  /// The triangles of a path tessellated ahead of time.
+  struct PreparedTessellation {
+    /// Vertex positions as (x, y) pairs.
+    std::vector<float> vertices;
+    std::vector<uint16_t> indices;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Keep the triangles of a path tessellated ahead of time (for
+  ///             example on worker threads) until the owner of this
+  ///             tessellator draws the path.
+  ///
+  /// @param[in]  owner        Identifies the prepared tessellations to drop
+  ///                          in `DiscardPreparedTessellations`.
+  /// @param[in]  path         The tessellated path.
+  /// @param[in]  fill_type    The fill type the path was tessellated with.
+  /// @param[in]  scale        The scale the path was tessellated at.
+  /// @param[in]  tessellation The triangles.
+  ///
+  void AddPreparedTessellation(const void* owner,
+                               const Path* path,
+                               FillType fill_type,
+                               Scalar scale,
+                               PreparedTessellation tessellation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove and return the triangles prepared for the given path,
+  ///             fill type and scale, if any.
+  ///
+  std::optional<PreparedTessellation> TakePreparedTessellation(
+      const Path* path,
+      FillType fill_type,
+      Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop the prepared tessellations added by the given owner that
+  ///             were not taken, such as those of paths that were culled.
+  ///
+  void DiscardPreparedTessellations(const void* owner);
+
+  size_t GetPreparedTessellationCount() const;
 
  private:
+  struct SimplePolygonScratch;
+
+  struct PreparedEntry {
+    const void* owner = nullptr;
+    FillType fill_type = FillType::kNonZero;
+    Scalar scale = 1.0f;
+    PreparedTessellation tessellation;
+  };
+
   CTessellator c_tessellator_;
+  /// Buffers reused across calls by the simple polygon triangulator.
+  std::unique_ptr<SimplePolygonScratch> scratch_;
+  std::unordered_multimap<const Path*, PreparedEntry> prepared_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Triangulates the points of a single contour if they form a
+  ///             simple polygon.
+  ///
+  /// @return     std::nullopt if the contour is not a simple polygon (or the
+  ///             triangulation fails) and must be tessellated by libtess2.
+  ///             Otherwise, the result of the tessellation.
+  ///
+  std::optional<Result> TessellateSimplePolygon(
+      const Point* points,
+      size_t point_count,
+      const BuilderCallback& callback);
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
 };
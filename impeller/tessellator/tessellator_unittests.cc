@@ -2,9 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/batch_tessellator.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -84,5 +88,153 @@ TEST(TessellatorTest, TessellatorBuilderReturnsCorrectResultStatus) {
   }
 }
 
+TEST(TessellatorTest, SimplePolygonsAreTriangulatedCompletely) {
+  // Triangle area summed over all generated triangles.
+  auto triangulated_area = [](FillType fill_type, const Path& path) {
+    Tessellator t;
+    Scalar area = 0;
+    auto result = t.Tessellate(
+        fill_type, path.CreatePolyline(1.0f),
+        [&area](const float* vertices, size_t vertices_size,
+                const uint16_t* indices, size_t indices_size) {
+          for (size_t i = 0; i + 2 < indices_size; i += 3) {
+            auto p0 = Point(vertices[indices[i] * 2],
+                            vertices[indices[i] * 2 + 1]);
+            auto p1 = Point(vertices[indices[i + 1] * 2],
+                            vertices[indices[i + 1] * 2 + 1]);
+            auto p2 = Point(vertices[indices[i + 2] * 2],
+                            vertices[indices[i + 2] * 2 + 1]);
+            area += std::abs((p1 - p0).Cross(p2 - p0)) / 2;
+          }
+          return true;
+        });
+    EXPECT_EQ(result, Tessellator::Result::kSuccess);
+    return area;
+  };
+
+  // Concave, clockwise, with a collinear vertex.
+  auto l_shape = PathBuilder{}
+                     .MoveTo({0, 0})
+                     .LineTo({0, 20})
+                     .LineTo({20, 20})
+                     .LineTo({20, 10})
+                     .LineTo({15, 10})
+                     .LineTo({10, 10})
+                     .LineTo({10, 0})
+                     .Close()
+                     .TakePath();
+  ASSERT_FLOAT_EQ(triangulated_area(FillType::kNonZero, l_shape), 300);
+  ASSERT_FLOAT_EQ(triangulated_area(FillType::kOdd, l_shape), 300);
+
+  PathBuilder star;
+  for (int i = 0; i < 10; i++) {
+    auto radius = i % 2 == 0 ? 100.0f : 40.0f;
+    auto angle = kPi * i / 5;
+    auto point = Point(std::cos(angle), std::sin(angle)) * radius;
+    if (i == 0) {
+      star.MoveTo(point);
+    } else {
+      star.LineTo(point);
+    }
+  }
+  // 10 triangles of two sides 100 and 40 and an angle of pi / 5 between them.
+  ASSERT_NEAR(triangulated_area(FillType::kNonZero, star.Close().TakePath()),
+              10 * 0.5 * 100 * 40 * std::sin(kPi / 5), 0.1);
+
+  // Self-intersecting contours are still tessellated correctly.
+  auto bowtie = PathBuilder{}
+                    .MoveTo({0, 0})
+                    .LineTo({10, 10})
+                    .LineTo({10, 0})
+                    .LineTo({0, 10})
+                    .Close()
+                    .TakePath();
+  ASSERT_NEAR(triangulated_area(FillType::kNonZero, bowtie), 50, 1e-3);
+}
+
+TEST(TessellatorTest, BatchTessellatorMatchesSerialTessellation) {
+  std::vector<Path> paths;
+  for (int i = 0; i < 32; i++) {
+    auto offset = i * 10.0f;
+    paths.push_back(PathBuilder{}
+                        .MoveTo({offset, 0})
+                        .LineTo({offset + 100, 100})
+                        .LineTo({offset + 100, 0})
+                        .LineTo({offset, 100})
+                        .Close()
+                        .AddCircle({offset + 50, 50}, 20 + i)
+                        .TakePath());
+  }
+  std::vector<TessellationJob> jobs;
+  for (const auto& path : paths) {
+    jobs.push_back({.path = &path, .fill_type = FillType::kOdd, .scale = 2.0});
+  }
+  jobs.push_back({.path = nullptr});
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto outputs = BatchTessellator::Tessellate(jobs, loop->GetTaskRunner());
+  ASSERT_EQ(outputs.size(), jobs.size());
+
+  Tessellator serial;
+  for (size_t i = 0; i < paths.size(); i++) {
+    std::vector<float> vertices;
+    std::vector<uint16_t> indices;
+    auto result = serial.Tessellate(
+        FillType::kOdd, paths[i].CreatePolyline(2.0),
+        [&](const float* v, size_t v_size, const uint16_t* idx,
+            size_t idx_size) {
+          vertices.assign(v, v + v_size);
+          indices.assign(idx, idx + idx_size);
+          return true;
+        });
+    ASSERT_EQ(result, Tessellator::Result::kSuccess);
+    ASSERT_EQ(outputs[i].result, Tessellator::Result::kSuccess);
+    ASSERT_EQ(outputs[i].vertices, vertices);
+    ASSERT_EQ(outputs[i].indices, indices);
+  }
+  ASSERT_EQ(outputs.back().result, Tessellator::Result::kInputError);
+
+  // Without a worker pool, all jobs are tessellated on the calling thread.
+  auto serial_outputs = BatchTessellator::Tessellate(jobs, nullptr);
+  ASSERT_EQ(serial_outputs.size(), jobs.size());
+  ASSERT_EQ(serial_outputs[0].indices, outputs[0].indices);
+}
+
+TEST(TessellatorTest, PreparedTessellationsAreTakenOnceAndDiscardedByOwner) {
+  Tessellator tessellator;
+  Path path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath();
+  Path other_path =
+      PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 20, 20)).TakePath();
+  int owner = 0;
+  int other_owner = 0;
+
+  tessellator.AddPreparedTessellation(&owner, &path, FillType::kOdd, 2.0,
+                                      {.vertices = {0, 0, 10, 0, 10, 10},
+                                       .indices = {0, 1, 2}});
+  tessellator.AddPreparedTessellation(&other_owner, &other_path,
+                                      FillType::kOdd, 2.0, {});
+  ASSERT_EQ(tessellator.GetPreparedTessellationCount(), 2u);
+
+  // Only an exact match of path, fill type and scale is returned.
+  ASSERT_FALSE(
+      tessellator.TakePreparedTessellation(&path, FillType::kNonZero, 2.0)
+          .has_value());
+  ASSERT_FALSE(tessellator.TakePreparedTessellation(&path, FillType::kOdd, 1.0)
+                   .has_value());
+  auto prepared =
+      tessellator.TakePreparedTessellation(&path, FillType::kOdd, 2.0);
+  ASSERT_TRUE(prepared.has_value());
+  ASSERT_EQ(prepared->indices, std::vector<uint16_t>({0, 1, 2}));
+  ASSERT_FALSE(tessellator.TakePreparedTessellation(&path, FillType::kOdd, 2.0)
+                   .has_value());
+
+  tessellator.AddPreparedTessellation(&owner, &path, FillType::kOdd, 2.0, {});
+  tessellator.DiscardPreparedTessellations(&owner);
+  ASSERT_EQ(tessellator.GetPreparedTessellationCount(), 1u);
+  ASSERT_TRUE(
+      tessellator.TakePreparedTessellation(&other_path, FillType::kOdd, 2.0)
+          .has_value());
+}
+
 }  // namespace testing
 }  // namespace impeller
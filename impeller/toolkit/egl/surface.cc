@@ -4,11 +4,36 @@
 
 #include "impeller/toolkit/egl/surface.h"
 
+#include <EGL/eglext.h>
+
+#include <cstring>
+
 namespace impeller {
 namespace egl {
 
+static bool HasExtension(EGLDisplay display, const char* name) {
+  const char* extensions = ::eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions == nullptr) {
+    return false;
+  }
+  const auto name_length = std::strlen(name);
+  for (const char* found = std::strstr(extensions, name); found != nullptr;
+       found = std::strstr(found + name_length, name)) {
+    // Make sure this is not just the prefix of another extension.
+    const char next = found[name_length];
+    if ((found == extensions || found[-1] == ' ') &&
+        (next == ' ' || next == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Surface::Surface(EGLDisplay display, EGLSurface surface)
-    : display_(display), surface_(surface) {}
+    : display_(display),
+      surface_(surface),
+      supports_buffer_age_(surface != EGL_NO_SURFACE &&
+                           HasExtension(display, "EGL_EXT_buffer_age")) {}
 
 Surface::~Surface() {
   if (surface_ != EGL_NO_SURFACE) {
@@ -34,5 +59,22 @@ bool Surface::Present() const {
   return result;
 }
 
+bool Surface::SupportsBufferAge() const {
+  return supports_buffer_age_;
+}
+
+EGLint Surface::GetBufferAge() const {
+  if (!supports_buffer_age_) {
+    return 0;
+  }
+  EGLint age = 0;
+  if (::eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age) !=
+      EGL_TRUE) {
+    IMPELLER_LOG_EGL_ERROR;
+    return 0;
+  }
+  return age;
+}
+
 }  // namespace egl
 }  // namespace impeller
@@ -22,9 +22,23 @@ class Surface {
 
   bool Present() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the age of the back buffer can be queried via
+  ///             `EGL_EXT_buffer_age`.
+  ///
+  bool SupportsBufferAge() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames ago the contents of the back buffer were
+  ///             presented. Zero if the contents are undefined or the age is
+  ///             unknown.
+  ///
+  EGLint GetBufferAge() const;
+
  private:
   EGLDisplay display_ = EGL_NO_DISPLAY;
   EGLSurface surface_ = EGL_NO_SURFACE;
+  bool supports_buffer_age_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
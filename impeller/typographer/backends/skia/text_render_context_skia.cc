@@ -4,14 +4,23 @@
 
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <utility>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/parallel_for.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/context.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkFont.h"
@@ -47,7 +56,7 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairs(
   FontGlyphPair::Set set;
   while (const TextFrame* frame = frame_iterator()) {
     for (const TextRun& run : frame->GetRuns()) {
-      const Font& font = run.GetFont();
+      const Font font = GlyphAtlas::GetAtlasFont(type, run.GetFont());
       for (const TextRun::GlyphPosition& glyph_position :
            run.GetGlyphPositions()) {
         set.insert({font, glyph_position.glyph});
@@ -57,11 +66,67 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairs(
   return set;
 }
 
-static size_t PairsFitInAtlasOfSize(
-    const FontGlyphPair::Set& pairs,
+namespace {
+
+// Atlases grow by adding pages until they reach either of these limits. Past
+// that, the atlas is rebuilt from the glyphs of the current frame only.
+constexpr size_t kMaxAtlasPages = 4u;
+constexpr int64_t kMaxAtlasArea = 4096 * 4096;
+
+// The smallest page added when an atlas overflows. Small pages would fill up
+// (and force a rebuild) almost immediately.
+constexpr int64_t kMinOverflowPageSize = 512;
+
+// Glyphs that have not been used for this many atlas updates may be evicted
+// to make room for new glyphs. Glyphs used by the current update are never
+// evicted.
+constexpr uint64_t kGlyphEvictionAge = 2u;
+
+// The location of a glyph that was placed in the atlas this frame.
+struct GlyphPlacement {
+  std::reference_wrapper<const FontGlyphPair> pair;
+  size_t page;
+  Rect bounds;
+};
+
+// Packs a glyph along with the margin its atlas type reserves around it. The
+// returned bounds exclude the margin.
+std::optional<Rect> PackGlyph(RectanglePacker& rect_packer,
+                              const FontGlyphPair& pair,
+                              GlyphAtlas::Type type) {
+  const auto glyph_size =
+      ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
+  const auto margin = GlyphAtlas::GetGlyphMargin(type);
+  IPoint16 location_in_atlas;
+  if (!rect_packer.addRect(glyph_size.width + 2 * margin + kPadding,   //
+                           glyph_size.height + 2 * margin + kPadding,  //
+                           &location_in_atlas                          //
+                           )) {
+    return std::nullopt;
+  }
+  return Rect::MakeXYWH(location_in_atlas.x() + margin,  //
+                        location_in_atlas.y() + margin,  //
+                        glyph_size.width,                //
+                        glyph_size.height                //
+  );
+}
+
+// The region of a page occupied by a glyph including its margin.
+IRect GetGlyphRegion(const Rect& bounds, GlyphAtlas::Type type) {
+  const auto margin = GlyphAtlas::GetGlyphMargin(type);
+  // Glyph bounds are integral since the packer works in whole pixels.
+  return IRect::MakeXYWH(static_cast<int64_t>(bounds.origin.x) - margin,
+                         static_cast<int64_t>(bounds.origin.y) - margin,
+                         static_cast<int64_t>(bounds.size.width) + 2 * margin,
+                         static_cast<int64_t>(bounds.size.height) + 2 * margin);
+}
+
+size_t PairsFitInAtlasOfSize(
+    const FontGlyphPairRefVector& pairs,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    const std::shared_ptr<RectanglePacker>& rect_packer,
+    GlyphAtlas::Type type) {
   if (atlas_size.IsEmpty()) {
     return false;
   }
@@ -69,91 +134,121 @@ static size_t PairsFitInAtlasOfSize(
   glyph_positions.clear();
   glyph_positions.reserve(pairs.size());
 
-  size_t i = 0;
-  for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
-    const auto& pair = *it;
-
-    const auto glyph_size =
-        ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
-    IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
+  for (size_t i = 0; i < pairs.size(); i++) {
+    auto position = PackGlyph(*rect_packer, pairs[i], type);
+    if (!position.has_value()) {
       return pairs.size() - i;
     }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
+    glyph_positions.emplace_back(position.value());
   }
 
   return 0;
 }
 
-static bool CanAppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
+//------------------------------------------------------------------------------
+/// @brief      Place as many of the extra pairs as possible into the free
+///             space of the existing pages of the atlas.
+///
+/// @return     The pairs that did not fit into any of the existing pages.
+///
+FontGlyphPairRefVector AppendToExistingPages(
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
     const FontGlyphPairRefVector& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    GlyphAtlas::Type type,
+    std::vector<GlyphPlacement>& placements) {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return false;
-  }
-
-  // We assume that all existing glyphs will fit. After all, they fit before.
-  // The glyph_positions only contains the values for the additional glyphs
-  // from extra_pairs.
-  FML_DCHECK(glyph_positions.size() == 0);
-  glyph_positions.reserve(extra_pairs.size());
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
-    const FontGlyphPair& pair = extra_pairs[i];
-
-    const auto glyph_size =
-        ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
-    IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
+  FontGlyphPairRefVector overflow;
+  const size_t page_count = atlas_context->GetPageCount();
+  for (const FontGlyphPair& pair : extra_pairs) {
+    bool placed = false;
+    for (size_t page = 0; page < page_count; page++) {
+      auto rect_packer = atlas_context->GetRectPacker(page);
+      if (!rect_packer || atlas_context->GetAtlasSize(page).IsEmpty()) {
+        continue;
+      }
+      auto position = PackGlyph(*rect_packer, pair, type);
+      if (position.has_value()) {
+        placements.push_back({pair, page, position.value()});
+        placed = true;
+        break;
+      }
+    }
+    if (!placed) {
+      overflow.push_back(pair);
     }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
   }
+  return overflow;
+}
 
-  return true;
+// Evicts glyphs that have not been used recently from the atlas and releases
+// their space in the page packers. The evicted regions are cleared in the page
+// bitmaps and recorded in |erased_regions| (indexed by page) so that they are
+// uploaded along with any glyphs drawn into them.
+size_t EvictStaleGlyphs(const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+                        GlyphAtlas& atlas,
+                        uint64_t frame,
+                        std::vector<std::optional<IRect>>& erased_regions) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (frame <= kGlyphEvictionAge) {
+    return 0u;
+  }
+  erased_regions.resize(atlas_context->GetPageCount());
+  return atlas.EvictGlyphsUnusedSince(
+      frame - kGlyphEvictionAge, [&](const GlyphAtlas::Location& location) {
+        auto rect_packer = atlas_context->GetRectPacker(location.page);
+        auto bitmap = atlas_context->GetBitmap(location.page);
+        if (!rect_packer || !bitmap) {
+          return;
+        }
+        auto region = GetGlyphRegion(location.bounds, atlas.GetType());
+        region.size.width += kPadding;
+        region.size.height += kPadding;
+        rect_packer->removeRect(
+            IPoint16{static_cast<int16_t>(region.origin.x),
+                     static_cast<int16_t>(region.origin.y)},
+            region.size.width, region.size.height);
+        // The padding of glyphs at the edge of the page may extend past it.
+        auto page_region = region.Intersection(
+            IRect::MakeSize(atlas_context->GetAtlasSize(location.page)));
+        if (!page_region.has_value()) {
+          return;
+        }
+        bitmap->erase(SK_ColorTRANSPARENT,
+                      SkIRect::MakeXYWH(page_region->origin.x,
+                                        page_region->origin.y,
+                                        page_region->size.width,
+                                        page_region->size.height));
+        auto& erased = erased_regions[location.page];
+        erased = erased.has_value() ? erased->Union(page_region.value())
+                                    : page_region.value();
+      });
 }
 
-namespace {
 ISize OptimumAtlasSizeForFontGlyphPairs(
-    const FontGlyphPair::Set& pairs,
+    const FontGlyphPairRefVector& pairs,
     std::vector<Rect>& glyph_positions,
-    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
-    GlyphAtlas::Type type) {
+    std::shared_ptr<RectanglePacker>& rect_packer,
+    GlyphAtlas::Type type,
+    ISize min_size = {}) {
   static constexpr auto kMinAtlasSize = 8u;
   static constexpr auto kMinAlphaBitmapSize = 1024u;
   static constexpr auto kMaxAtlasSize = 4096u;
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  ISize current_size = type == GlyphAtlas::Type::kAlphaBitmap
+  ISize current_size = type != GlyphAtlas::Type::kColorBitmap
                            ? ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize)
                            : ISize(kMinAtlasSize, kMinAtlasSize);
+  current_size = ISize(std::max(current_size.width, min_size.width),
+                       std::max(current_size.height, min_size.height));
   size_t total_pairs = pairs.size() + 1;
   do {
-    auto rect_packer = std::shared_ptr<RectanglePacker>(
+    rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        pairs, current_size, glyph_positions, rect_packer, type);
     if (remaining_pairs == 0) {
-      atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
     } else if (remaining_pairs < std::ceil(total_pairs / 2)) {
       current_size = ISize::MakeWH(
@@ -167,14 +262,14 @@ ISize OptimumAtlasSizeForFontGlyphPairs(
     }
   } while (current_size.width <= kMaxAtlasSize &&
            current_size.height <= kMaxAtlasSize);
+  rect_packer = nullptr;
   return ISize{0, 0};
 }
-}  // namespace
 
-static void DrawGlyph(SkCanvas* canvas,
-                      const FontGlyphPair& font_glyph,
-                      const Rect& location,
-                      bool has_color) {
+void DrawGlyph(SkCanvas* canvas,
+               const FontGlyphPair& font_glyph,
+               const Rect& location,
+               bool has_color) {
   const auto& metrics = font_glyph.font.GetMetrics();
   const auto position = SkPoint::Make(location.origin.x / metrics.scale,
                                       location.origin.y / metrics.scale);
@@ -204,41 +299,148 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const FontGlyphPairRefVector& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
+// Renders the coverage of a glyph into a scratch bitmap and writes the signed
+// distance field derived from it into the glyph's region of the page,
+// including the margin around the glyph.
+bool DrawSignedDistanceFieldGlyph(const SkPixmap& pixmap,
+                                  const GlyphPlacement& placement) {
+  const auto region =
+      GetGlyphRegion(placement.bounds, GlyphAtlas::Type::kSignedDistanceField);
+  if (region.origin.x < 0 || region.origin.y < 0 ||
+      region.GetRight() > pixmap.width() ||
+      region.GetBottom() > pixmap.height()) {
+    return false;
+  }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
+  SkBitmap coverage;
+  if (!coverage.tryAllocPixels(
+          SkImageInfo::MakeA8(region.size.width, region.size.height))) {
+    return false;
+  }
+  {
+    SkCanvas canvas(coverage);
+    const auto margin =
+        static_cast<Scalar>(GlyphAtlas::kSignedDistanceFieldSpread);
+    DrawGlyph(&canvas, placement.pair,
+              Rect::MakeXYWH(margin, margin, placement.bounds.size.width,
+                             placement.bounds.size.height),
+              false);
+  }
+
+  ComputeSignedDistanceField(
+      static_cast<const uint8_t*>(coverage.getPixels()), coverage.rowBytes(),
+      region.size, GlyphAtlas::kSignedDistanceFieldSpread,
+      static_cast<uint8_t*>(
+          pixmap.writable_addr(region.origin.x, region.origin.y)),
+      pixmap.rowBytes());
+  return true;
+}
+
+// Glyphs are handed to worker threads in chunks of this many glyphs. Pages
+// with fewer new glyphs than this are rasterized on the calling thread.
+constexpr size_t kGlyphsPerRasterTask = 16u;
+
+// Rasterizes the given chunk of glyphs into the pixmap. Each chunk draws
+// through its own surface wrapping the shared pixels, and every glyph is
+// clipped to its own rect, so that chunks can be rasterized concurrently
+// without touching the same pixels.
+bool DrawGlyphChunkIntoPixmap(GlyphAtlas::Type type,
+                              const SkPixmap& pixmap,
+                              const std::vector<const GlyphPlacement*>& glyphs,
+                              size_t chunk) {
+  const size_t end =
+      std::min(glyphs.size(), (chunk + 1u) * kGlyphsPerRasterTask);
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    bool drawn = true;
+    for (size_t i = chunk * kGlyphsPerRasterTask; i < end; i++) {
+      drawn &= DrawSignedDistanceFieldGlyph(pixmap, *glyphs[i]);
+    }
+    return drawn;
+  }
+  auto surface = SkSurfaces::WrapPixels(pixmap);
   if (!surface) {
     return false;
   }
   auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return false;
+  for (size_t i = chunk * kGlyphsPerRasterTask; i < end; i++) {
+    const auto& placement = *glyphs[i];
+    const auto& bounds = placement.bounds;
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->clipRect(SkRect::MakeXYWH(bounds.origin.x, bounds.origin.y,
+                                      bounds.size.width, bounds.size.height));
+    DrawGlyph(canvas, placement.pair, bounds,
+              type == GlyphAtlas::Type::kColorBitmap);
+    canvas->restore();
   }
+  return true;
+}
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+//------------------------------------------------------------------------------
+/// @brief      Draw the glyphs placed on the given page into its bitmap.
+///
+///             If a worker task runner is available and there are enough
+///             glyphs, the glyphs are rasterized in parallel by the workers
+///             and the calling thread.
+///
+/// @return     The region of the bitmap that was drawn to or std::nullopt if
+///             the bitmap could not be drawn to. The region is empty if no
+///             glyphs were placed on the page.
+///
+std::optional<IRect> DrawGlyphsIntoBitmap(
+    GlyphAtlas::Type type,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    size_t page,
+    const std::vector<GlyphPlacement>& placements,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
 
-  for (const FontGlyphPair& pair : new_pairs) {
-    auto pos = atlas.FindFontGlyphBounds(pair);
-    if (!pos.has_value()) {
+  std::vector<const GlyphPlacement*> glyphs;
+  std::optional<IRect> dirty_region;
+  for (const auto& placement : placements) {
+    if (placement.page != page) {
       continue;
     }
-    DrawGlyph(canvas, pair, pos.value(), has_color);
+    glyphs.push_back(&placement);
+    auto glyph_region = GetGlyphRegion(placement.bounds, type);
+    dirty_region = dirty_region.has_value()
+                       ? dirty_region->Union(glyph_region)
+                       : glyph_region;
   }
-  return true;
+  if (!dirty_region.has_value()) {
+    return IRect();
+  }
+
+  const size_t chunk_count =
+      (glyphs.size() + kGlyphsPerRasterTask - 1u) / kGlyphsPerRasterTask;
+  const auto& pixmap = bitmap->pixmap();
+  std::atomic_bool failed = false;
+  fml::ParallelFor(
+      chunk_count,
+      [&](size_t chunk) {
+        if (!DrawGlyphChunkIntoPixmap(type, pixmap, glyphs, chunk)) {
+          failed = true;
+        }
+      },
+      worker_task_runner, "GlyphAtlas::RasterizeGlyphs");
+  if (failed) {
+    return std::nullopt;
+  }
+
+  auto bitmap_bounds = IRect::MakeXYWH(0, 0, bitmap->width(), bitmap->height());
+  return dirty_region->Intersection(bitmap_bounds).value_or(IRect());
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+std::shared_ptr<SkBitmap> CreateAtlasBitmap(GlyphAtlas::Type type,
+                                            const ISize& atlas_size) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
 
-  switch (atlas.GetType()) {
+  switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
       break;
     case GlyphAtlas::Type::kColorBitmap:
@@ -250,29 +452,11 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
   if (!bitmap->tryAllocPixels(image_info)) {
     return nullptr;
   }
-
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return nullptr;
-  }
-
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const FontGlyphPair& font_glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, font_glyph, location, has_color);
-    return true;
-  });
-
   return bitmap;
 }
 
-static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
-                                    const std::shared_ptr<Texture>& texture) {
+bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
+                             const std::shared_ptr<Texture>& texture) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   FML_DCHECK(bitmap != nullptr);
@@ -287,7 +471,80 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
   return texture->SetContents(mapping);
 }
 
-static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
+//------------------------------------------------------------------------------
+/// @brief      Upload a region of the bitmap into the same region of the
+///             texture using a blit pass.
+///
+bool UpdateGlyphTextureAtlasRegion(const Context& context,
+                                   const std::shared_ptr<SkBitmap>& bitmap,
+                                   const std::shared_ptr<Texture>& texture,
+                                   const IRect& region) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
+
+  const auto& pixmap = bitmap->pixmap();
+  const size_t bytes_per_pixel = pixmap.info().bytesPerPixel();
+  const size_t region_row_bytes = region.size.width * bytes_per_pixel;
+
+  // The rows of the region have to be tightly packed for the blit.
+  std::vector<uint8_t> region_bytes(region_row_bytes * region.size.height);
+  for (int64_t row = 0; row < region.size.height; row++) {
+    ::memcpy(region_bytes.data() + row * region_row_bytes,
+             pixmap.addr(region.origin.x, region.origin.y + row),
+             region_row_bytes);
+  }
+
+  auto allocator = context.GetResourceAllocator();
+  auto buffer =
+      allocator->CreateBufferWithCopy(region_bytes.data(), region_bytes.size());
+  if (!buffer) {
+    return false;
+  }
+
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("GlyphAtlas Update");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("GlyphAtlas Update");
+  if (!blit_pass->AddCopy(buffer->AsBufferView(), texture, region,
+                          "GlyphAtlas Dirty Region")) {
+    return false;
+  }
+  if (!blit_pass->EncodeCommands(allocator)) {
+    return false;
+  }
+  return command_buffer->SubmitCommands();
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Upload the dirty region of a page of the atlas. Only the dirty
+///             region is transferred if the backend supports buffer to
+///             texture blits.
+///
+bool UploadDirtyRegion(const Context& context,
+                       const std::shared_ptr<SkBitmap>& bitmap,
+                       const std::shared_ptr<Texture>& texture,
+                       const IRect& dirty_region) {
+  if (dirty_region.IsEmpty()) {
+    return true;
+  }
+  if (!texture) {
+    return false;
+  }
+  if (dirty_region.size != texture->GetSize() &&
+      context.GetCapabilities()->SupportsBufferToTextureBlits()) {
+    return UpdateGlyphTextureAtlasRegion(context, bitmap, texture,
+                                         dirty_region);
+  }
+  return UpdateGlyphTextureAtlas(bitmap, texture);
+}
+
+std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     const std::shared_ptr<Allocator>& allocator,
     std::shared_ptr<SkBitmap> bitmap,
     const ISize& atlas_size,
@@ -328,6 +585,52 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   return texture;
 }
 
+PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Pack the pairs that overflowed the existing pages into a new
+///             page.
+///
+/// @return     The size of the new page or an empty size if the atlas may not
+///             grow any further.
+///
+ISize PackOverflowPage(const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+                       const FontGlyphPairRefVector& overflow,
+                       GlyphAtlas::Type type,
+                       std::vector<Rect>& glyph_positions,
+                       std::shared_ptr<RectanglePacker>& rect_packer) {
+  const size_t page_count = atlas_context->GetPageCount();
+  if (page_count >= kMaxAtlasPages) {
+    return {};
+  }
+  int64_t atlas_area = 0;
+  for (size_t page = 0; page < page_count; page++) {
+    atlas_area += atlas_context->GetAtlasSize(page).Area();
+  }
+
+  const auto& first_page_size = atlas_context->GetAtlasSize(0u);
+  const auto min_size =
+      ISize(std::max(first_page_size.width, kMinOverflowPageSize),
+            std::max(first_page_size.height, kMinOverflowPageSize));
+  auto page_size = OptimumAtlasSizeForFontGlyphPairs(
+      overflow, glyph_positions, rect_packer, type, min_size);
+  if (page_size.IsEmpty() || atlas_area + page_size.Area() > kMaxAtlasArea) {
+    return {};
+  }
+  return page_size;
+}
+
+}  // namespace
+
 std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     GlyphAtlas::Type type,
     std::shared_ptr<GlyphAtlasContext> atlas_context,
@@ -337,6 +640,8 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     return nullptr;
   }
   std::shared_ptr<GlyphAtlas> last_atlas = atlas_context->GetGlyphAtlas();
+  const uint64_t frame = atlas_context->AdvanceFrame();
+  auto worker_task_runner = GetContext()->GetConcurrentWorkerTaskRunner();
 
   // ---------------------------------------------------------------------------
   // Step 1: Collect unique font-glyph pairs in the frame.
@@ -350,11 +655,12 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the atlas type and font glyph pairs are compatible
-  //         with the current atlas and reuse if possible.
+  //         with the current atlas and reuse if possible. Glyphs already in
+  //         the atlas are marked as used so that they are not evicted.
   // ---------------------------------------------------------------------------
   FontGlyphPairRefVector new_glyphs;
   for (const FontGlyphPair& pair : font_glyph_pairs) {
-    if (!last_atlas->FindFontGlyphBounds(pair).has_value()) {
+    if (!last_atlas->MarkFontGlyphUsed(pair, frame)) {
       new_glyphs.push_back(pair);
     }
   }
@@ -364,51 +670,118 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 3: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         existing pages of the atlas, or to a new page, without recreating
+  //         the atlas. This requires that the type is identical. If the
+  //         existing pages are full, glyphs that have not been used recently
+  //         are evicted first to make room.
   // ---------------------------------------------------------------------------
-  std::vector<Rect> glyph_positions;
-  if (last_atlas->GetType() == type &&
-      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
-    // The old bitmap will be reused and only the additional glyphs will be
-    // added.
-
-    // ---------------------------------------------------------------------------
-    // Step 4: Record the positions in the glyph atlas of the newly added
-    // glyphs.
-    // ---------------------------------------------------------------------------
-    for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
-      last_atlas->AddTypefaceGlyphPosition(new_glyphs[i], glyph_positions[i]);
+  if (last_atlas->GetType() == type && last_atlas->IsValid()) {
+    std::vector<GlyphPlacement> placements;
+    placements.reserve(new_glyphs.size());
+    auto overflow =
+        AppendToExistingPages(atlas_context, new_glyphs, type, placements);
+
+    std::vector<std::optional<IRect>> erased_regions;
+    if (!overflow.empty() &&
+        EvictStaleGlyphs(atlas_context, *last_atlas, frame, erased_regions) >
+            0u) {
+      overflow =
+          AppendToExistingPages(atlas_context, overflow, type, placements);
     }
 
-    // ---------------------------------------------------------------------------
-    // Step 5: Draw new font-glyph pairs into the existing bitmap.
-    // ---------------------------------------------------------------------------
-    auto bitmap = atlas_context->GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
-      return nullptr;
+    std::vector<Rect> overflow_positions;
+    std::shared_ptr<RectanglePacker> overflow_packer;
+    ISize overflow_page_size;
+    if (!overflow.empty()) {
+      overflow_page_size = PackOverflowPage(
+          atlas_context, overflow, type, overflow_positions, overflow_packer);
     }
 
-    // ---------------------------------------------------------------------------
-    // Step 6: Update the existing texture with the updated bitmap.
-    // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
-      return nullptr;
+    if (overflow.empty() || !overflow_page_size.IsEmpty()) {
+      // The existing pages will be reused and only the additional glyphs will
+      // be added.
+      FML_DCHECK(overflow_positions.size() == overflow.size());
+      const size_t page_count = atlas_context->GetPageCount();
+      for (size_t i = 0; i < overflow.size(); i++) {
+        placements.push_back({overflow[i], page_count, overflow_positions[i]});
+      }
+
+      // -----------------------------------------------------------------------
+      // Step 4: Record the positions in the glyph atlas of the newly added
+      // glyphs.
+      // -----------------------------------------------------------------------
+      for (const auto& placement : placements) {
+        last_atlas->AddTypefaceGlyphPosition(placement.pair, placement.bounds,
+                                             placement.page, frame);
+      }
+
+      // -----------------------------------------------------------------------
+      // Step 5: Draw new font-glyph pairs into the bitmaps of the existing
+      // pages and upload only the regions that changed.
+      // -----------------------------------------------------------------------
+      for (size_t page = 0; page < page_count; page++) {
+        auto bitmap = atlas_context->GetBitmap(page);
+        if (!bitmap) {
+          return nullptr;
+        }
+        auto dirty_region =
+            DrawGlyphsIntoBitmap(type, bitmap, page, placements,
+                                 worker_task_runner);
+        if (dirty_region.has_value() && page < erased_regions.size() &&
+            erased_regions[page].has_value()) {
+          const auto& erased = erased_regions[page].value();
+          dirty_region = dirty_region->IsEmpty()
+                             ? erased
+                             : dirty_region->Union(erased);
+        }
+        if (!dirty_region.has_value() ||
+            !UploadDirtyRegion(*GetContext(), bitmap,
+                               last_atlas->GetTexture(page),
+                               dirty_region.value())) {
+          return nullptr;
+        }
+      }
+
+      // -----------------------------------------------------------------------
+      // Step 6: Draw and upload the overflow page, if any.
+      // -----------------------------------------------------------------------
+      if (!overflow.empty()) {
+        auto bitmap = CreateAtlasBitmap(type, overflow_page_size);
+        if (!bitmap ||
+            !DrawGlyphsIntoBitmap(type, bitmap, page_count, placements,
+                                  worker_task_runner)
+                 .has_value()) {
+          return nullptr;
+        }
+        auto texture = UploadGlyphTextureAtlas(
+            GetContext()->GetResourceAllocator(), bitmap, overflow_page_size,
+            GetAtlasPixelFormat(type));
+        if (!texture) {
+          return nullptr;
+        }
+        last_atlas->AddPage(std::move(texture));
+        atlas_context->AddPage(overflow_page_size, std::move(bitmap),
+                               std::move(overflow_packer));
+      }
+      return last_atlas;
     }
-    return last_atlas;
   }
   // A new glyph atlas must be created.
 
   // ---------------------------------------------------------------------------
   // Step 4: Get the optimum size of the texture atlas.
   // ---------------------------------------------------------------------------
+  FontGlyphPairRefVector pairs(font_glyph_pairs.begin(),
+                               font_glyph_pairs.end());
+  std::vector<Rect> glyph_positions;
+  std::shared_ptr<RectanglePacker> rect_packer;
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
-  auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
-      font_glyph_pairs, glyph_positions, atlas_context, type);
+  auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(pairs, glyph_positions,
+                                                      rect_packer, type);
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
+  atlas_context->UpdateRectPacker(rect_packer);
+  atlas_context->UpdateBitmap(nullptr);
   if (atlas_size.IsEmpty()) {
     return nullptr;
   }
@@ -418,26 +791,27 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // sanity check of counts. This could also be just an assertion as only a
   // construction issue would cause such a failure.
   // ---------------------------------------------------------------------------
-  if (glyph_positions.size() != font_glyph_pairs.size()) {
+  if (glyph_positions.size() != pairs.size()) {
     return nullptr;
   }
 
   // ---------------------------------------------------------------------------
   // Step 6: Record the positions in the glyph atlas.
   // ---------------------------------------------------------------------------
-  {
-    size_t i = 0;
-    for (auto it = font_glyph_pairs.begin(); it != font_glyph_pairs.end();
-         ++i, ++it) {
-      glyph_atlas->AddTypefaceGlyphPosition(*it, glyph_positions[i]);
-    }
+  std::vector<GlyphPlacement> placements;
+  placements.reserve(pairs.size());
+  for (size_t i = 0; i < pairs.size(); i++) {
+    glyph_atlas->AddTypefaceGlyphPosition(pairs[i], glyph_positions[i], 0u,
+                                          frame);
+    placements.push_back({pairs[i], 0u, glyph_positions[i]});
   }
 
   // ---------------------------------------------------------------------------
   // Step 7: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
-  if (!bitmap) {
+  auto bitmap = CreateAtlasBitmap(type, atlas_size);
+  if (!bitmap ||
+      !DrawGlyphsIntoBitmap(type, bitmap, 0u, placements, worker_task_runner)) {
     return nullptr;
   }
   atlas_context->UpdateBitmap(bitmap);
@@ -445,17 +819,9 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 8: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
   auto texture = UploadGlyphTextureAtlas(GetContext()->GetResourceAllocator(),
-                                         bitmap, atlas_size, format);
+                                         bitmap, atlas_size,
+                                         GetAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
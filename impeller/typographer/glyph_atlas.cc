@@ -4,13 +4,14 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
     : atlas_(std::make_shared<GlyphAtlas>(GlyphAtlas::Type::kAlphaBitmap)),
-      atlas_size_(ISize(0, 0)) {}
+      pages_(1u, Page{.size = ISize(0, 0)}) {}
 
 GlyphAtlasContext::~GlyphAtlasContext() {}
 
@@ -18,56 +19,140 @@ std::shared_ptr<GlyphAtlas> GlyphAtlasContext::GetGlyphAtlas() const {
   return atlas_;
 }
 
-const ISize& GlyphAtlasContext::GetAtlasSize() const {
-  return atlas_size_;
+size_t GlyphAtlasContext::GetPageCount() const {
+  return pages_.size();
 }
 
-std::shared_ptr<SkBitmap> GlyphAtlasContext::GetBitmap() const {
-  return bitmap_;
+const ISize& GlyphAtlasContext::GetAtlasSize(size_t page) const {
+  FML_DCHECK(page < pages_.size());
+  return pages_[page].size;
 }
 
-std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetRectPacker() const {
-  return rect_packer_;
+std::shared_ptr<SkBitmap> GlyphAtlasContext::GetBitmap(size_t page) const {
+  return page < pages_.size() ? pages_[page].bitmap : nullptr;
+}
+
+std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetRectPacker(
+    size_t page) const {
+  return page < pages_.size() ? pages_[page].rect_packer : nullptr;
+}
+
+uint64_t GlyphAtlasContext::AdvanceFrame() {
+  return ++frame_;
 }
 
 void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
                                          ISize size) {
   atlas_ = std::move(atlas);
-  atlas_size_ = size;
+  pages_.resize(1u);
+  pages_[0].size = size;
 }
 
 void GlyphAtlasContext::UpdateBitmap(std::shared_ptr<SkBitmap> bitmap) {
-  bitmap_ = std::move(bitmap);
+  pages_[0].bitmap = std::move(bitmap);
 }
 
 void GlyphAtlasContext::UpdateRectPacker(
     std::shared_ptr<RectanglePacker> rect_packer) {
-  rect_packer_ = std::move(rect_packer);
+  pages_[0].rect_packer = std::move(rect_packer);
+}
+
+size_t GlyphAtlasContext::AddPage(
+    ISize size,
+    std::shared_ptr<SkBitmap> bitmap,
+    std::shared_ptr<RectanglePacker> rect_packer) {
+  pages_.push_back(Page{
+      .size = size,
+      .bitmap = std::move(bitmap),
+      .rect_packer = std::move(rect_packer),
+  });
+  return pages_.size() - 1u;
 }
 
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
+Font GlyphAtlas::GetAtlasFont(Type type, const Font& font) {
+  if (type != Type::kSignedDistanceField) {
+    return font;
+  }
+  auto metrics = font.GetMetrics();
+  metrics.scale = kSignedDistanceFieldReferenceSize /
+                  std::max(metrics.point_size, kEhCloseEnough);
+  return Font(font.GetTypeface(), metrics);
+}
+
+int GlyphAtlas::GetGlyphMargin(Type type) {
+  return type == Type::kSignedDistanceField ? kSignedDistanceFieldSpread : 0;
+}
+
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return !textures_.empty() &&
+         std::all_of(textures_.begin(), textures_.end(),
+                     [](const auto& texture) { return !!texture; });
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
   return type_;
 }
 
-const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+std::shared_ptr<Texture> GlyphAtlas::GetTexture(size_t page) const {
+  return page < textures_.size() ? textures_[page] : nullptr;
 }
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+  if (textures_.empty()) {
+    textures_.push_back(std::move(texture));
+  } else {
+    textures_[0] = std::move(texture);
+  }
+}
+
+size_t GlyphAtlas::AddPage(std::shared_ptr<Texture> texture) {
+  textures_.push_back(std::move(texture));
+  return textures_.size() - 1u;
+}
+
+size_t GlyphAtlas::GetPageCount() const {
+  return textures_.size();
 }
 
 void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
-                                          Rect rect) {
-  positions_[pair] = rect;
+                                          Rect rect,
+                                          size_t page,
+                                          uint64_t last_used_frame) {
+  positions_[pair] = Entry{
+      .location = Location{.page = page, .bounds = rect},
+      .last_used_frame = last_used_frame,
+  };
+}
+
+bool GlyphAtlas::MarkFontGlyphUsed(const FontGlyphPair& pair, uint64_t frame) {
+  auto found = positions_.find(pair);
+  if (found == positions_.end()) {
+    return false;
+  }
+  found->second.last_used_frame = frame;
+  return true;
+}
+
+size_t GlyphAtlas::EvictGlyphsUnusedSince(
+    uint64_t frame,
+    const std::function<void(const Location& location)>& evicted) {
+  size_t count = 0u;
+  for (auto it = positions_.begin(); it != positions_.end();) {
+    if (it->second.last_used_frame >= frame) {
+      ++it;
+      continue;
+    }
+    if (evicted) {
+      evicted(it->second.location);
+    }
+    it = positions_.erase(it);
+    count++;
+  }
+  return count;
 }
 
 std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
@@ -76,7 +161,16 @@ std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.location.bounds;
+}
+
+std::optional<GlyphAtlas::Location> GlyphAtlas::FindFontGlyphLocation(
+    const FontGlyphPair& pair) const {
+  const auto& found = positions_.find(pair);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
+  return found->second.location;
 }
 
 size_t GlyphAtlas::GetGlyphCount() const {
@@ -93,7 +187,7 @@ size_t GlyphAtlas::IterateGlyphs(
   size_t count = 0u;
   for (const auto& position : positions_) {
     count++;
-    if (!iterator(position.first, position.second)) {
+    if (!iterator(position.first, position.second.location.bounds)) {
       return count;
     }
   }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -25,6 +26,10 @@ namespace impeller {
 ///             different fonts along with the ability to query the location of
 ///             specific font glyphs within the texture.
 ///
+///             An atlas may be spread over multiple pages of the same type
+///             where each page is backed by a separate texture. Glyphs never
+///             straddle pages.
+///
 class GlyphAtlas {
  public:
   //----------------------------------------------------------------------------
@@ -41,6 +46,33 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented as signed distance fields in an 8-bit alpha
+    /// channel. Glyphs are rendered once at a reference size and may be drawn
+    /// at any scale.
+    ///
+    kSignedDistanceField,
+  };
+
+  //----------------------------------------------------------------------------
+  /// The size of an em in pixels that glyphs are rendered at in signed
+  /// distance field atlases.
+  static constexpr Scalar kSignedDistanceFieldReferenceSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The distance in pixels around the outline of a glyph that is encoded in
+  /// a signed distance field atlas. This must match the spread assumed by the
+  /// glyph_atlas_sdf.frag shader.
+  static constexpr int kSignedDistanceFieldSpread = 8;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The location of a glyph within the atlas.
+  struct Location {
+    /// The index of the page the glyph was rendered into.
+    size_t page = 0u;
+    /// The bounds of the glyph within the texture of the page.
+    Rect bounds;
   };
 
   //----------------------------------------------------------------------------
@@ -52,6 +84,23 @@ class GlyphAtlas {
 
   ~GlyphAtlas();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the font the glyphs of the given font are rendered with
+  ///             in an atlas of the given type.
+  ///
+  ///             Bitmap atlases render glyphs at the scale they are drawn at.
+  ///             Signed distance field atlases render glyphs at the reference
+  ///             size regardless of that scale, so that text drawn at
+  ///             different scales shares the same glyphs.
+  ///
+  static Font GetAtlasFont(Type type, const Font& font);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the margin in pixels that is reserved around the bounds
+  ///             of every glyph in an atlas of the given type.
+  ///
+  static int GetGlyphMargin(Type type);
+
   bool IsValid() const;
 
   //----------------------------------------------------------------------------
@@ -60,27 +109,69 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for the first page of the glyph atlas.
   ///
   /// @param[in]  texture  The texture
   ///
   void SetTexture(std::shared_ptr<Texture> texture);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Add a page to the glyph atlas.
+  ///
+  /// @param[in]  texture  The texture of the new page.
   ///
-  /// @return     The texture.
+  /// @return     The index of the new page.
   ///
-  const std::shared_ptr<Texture>& GetTexture() const;
+  size_t AddPage(std::shared_ptr<Texture> texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages in the glyph atlas.
+  ///
+  size_t GetPageCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture of a page of the glyph atlas.
+  ///
+  /// @param[in]  page  The index of the page.
+  ///
+  /// @return     The texture or nullptr if there is no such page.
+  ///
+  std::shared_ptr<Texture> GetTexture(size_t page = 0u) const;
 
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
   ///             atlas.
   ///
-  /// @param[in]  pair  The font-glyph pair
-  /// @param[in]  rect  The rectangle
+  /// @param[in]  pair             The font-glyph pair
+  /// @param[in]  rect             The rectangle
+  /// @param[in]  page             The page containing the rectangle.
+  /// @param[in]  last_used_frame  The frame the glyph was last used in.
   ///
-  void AddTypefaceGlyphPosition(const FontGlyphPair& pair, Rect rect);
+  void AddTypefaceGlyphPosition(const FontGlyphPair& pair,
+                                Rect rect,
+                                size_t page = 0u,
+                                uint64_t last_used_frame = 0u);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that a font-glyph pair is used by the given frame.
+  ///
+  /// @return     If the font-glyph pair is in the atlas.
+  ///
+  bool MarkFontGlyphUsed(const FontGlyphPair& pair, uint64_t frame);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove all glyphs that were last used before the given frame
+  ///             from the atlas.
+  ///
+  /// @param[in]  frame    The oldest frame whose glyphs are kept.
+  /// @param[in]  evicted  Called with the location of every removed glyph so
+  ///                      that the space it occupied can be reused.
+  ///
+  /// @return     The number of glyphs removed.
+  ///
+  size_t EvictGlyphsUnusedSince(
+      uint64_t frame,
+      const std::function<void(const Location& location)>& evicted);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -112,12 +203,29 @@ class GlyphAtlas {
   ///
   std::optional<Rect> FindFontGlyphBounds(const FontGlyphPair& pair) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the page and location of a specific font-glyph pair in
+  ///             the atlas.
+  ///
+  /// @param[in]  pair  The font-glyph pair
+  ///
+  /// @return     The location of the font-glyph pair in the atlas.
+  ///             `std::nullopt` of the pair in not in the atlas.
+  ///
+  std::optional<Location> FindFontGlyphLocation(
+      const FontGlyphPair& pair) const;
+
  private:
+  struct Entry {
+    Location location;
+    uint64_t last_used_frame = 0u;
+  };
+
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  std::vector<std::shared_ptr<Texture>> textures_;
 
   std::unordered_map<FontGlyphPair,
-                     Rect,
+                     Entry,
                      FontGlyphPair::Hash,
                      FontGlyphPair::Equal>
       positions_;
@@ -139,30 +247,58 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> GetGlyphAtlas() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the size of the current glyph atlas.
-  const ISize& GetAtlasSize() const;
+  /// @brief      Retrieve the number of pages of the current glyph atlas.
+  size_t GetPageCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the size of a page of the current glyph atlas.
+  const ISize& GetAtlasSize(size_t page = 0u) const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) SkBitmap instance.
-  std::shared_ptr<SkBitmap> GetBitmap() const;
+  /// @brief      Retrieve the previous (if any) SkBitmap instance of a page.
+  std::shared_ptr<SkBitmap> GetBitmap(size_t page = 0u) const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) rect packer.
-  std::shared_ptr<RectanglePacker> GetRectPacker() const;
+  /// @brief      Retrieve the previous (if any) rect packer of a page.
+  std::shared_ptr<RectanglePacker> GetRectPacker(size_t page = 0u) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Advance to the next frame for the purposes of tracking when
+  ///             glyphs were last used.
+  ///
+  /// @return     The index of the new frame.
+  ///
+  uint64_t AdvanceFrame();
 
   //----------------------------------------------------------------------------
-  /// @brief      Update the context with a newly constructed glyph atlas.
+  /// @brief      Update the context with a newly constructed glyph atlas. All
+  ///             pages but the first one are dropped.
   void UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas, ISize size);
 
   void UpdateBitmap(std::shared_ptr<SkBitmap> bitmap);
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a page that was added to the current glyph atlas.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage(ISize size,
+                 std::shared_ptr<SkBitmap> bitmap,
+                 std::shared_ptr<RectanglePacker> rect_packer);
+
  private:
+  struct Page {
+    ISize size;
+    std::shared_ptr<SkBitmap> bitmap;
+    std::shared_ptr<RectanglePacker> rect_packer;
+  };
+
   std::shared_ptr<GlyphAtlas> atlas_;
-  ISize atlas_size_;
-  std::shared_ptr<SkBitmap> bitmap_;
-  std::shared_ptr<RectanglePacker> rect_packer_;
+  // There is always at least one (possibly empty) page.
+  std::vector<Page> pages_;
+  uint64_t frame_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContext);
 };
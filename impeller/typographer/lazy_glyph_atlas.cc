@@ -18,17 +18,37 @@ LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
 void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame) {
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    alpha_frames_.emplace_back(frame);
-  } else {
-    color_frames_.emplace_back(frame);
+  switch (frame.GetAtlasType()) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      alpha_frames_.emplace_back(frame);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      color_frames_.emplace_back(frame);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      sdf_frames_.emplace_back(frame);
+      break;
   }
 }
 
+const std::vector<TextFrame>& LazyGlyphAtlas::GetFrames(
+    GlyphAtlas::Type type) const {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_frames_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_frames_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_frames_;
+  }
+  FML_UNREACHABLE();
+}
+
 std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     GlyphAtlas::Type type,
     std::shared_ptr<GlyphAtlasContext> atlas_context,
     std::shared_ptr<Context> context) const {
+  Lock lock(atlas_mutex_);
   {
     auto atlas_it = atlas_map_.find(type);
     if (atlas_it != atlas_map_.end()) {
@@ -41,8 +61,7 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
   size_t i = 0;
-  auto frames =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_frames_ : color_frames_;
+  const auto& frames = GetFrames(type);
   TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
     if (i >= frames.size()) {
       return nullptr;
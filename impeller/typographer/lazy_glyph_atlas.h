@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/context.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_frame.h"
@@ -21,6 +22,13 @@ class LazyGlyphAtlas {
 
   void AddTextFrame(const TextFrame& frame);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the atlas of the given type for all text frames added so
+  ///             far, creating it on first use.
+  ///
+  ///             This may be called from multiple threads, for instance by
+  ///             subpasses that are recorded concurrently.
+  ///
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       GlyphAtlas::Type type,
       std::shared_ptr<GlyphAtlasContext> atlas_context,
@@ -29,8 +37,12 @@ class LazyGlyphAtlas {
  private:
   std::vector<TextFrame> alpha_frames_;
   std::vector<TextFrame> color_frames_;
+  std::vector<TextFrame> sdf_frames_;
+
+  const std::vector<TextFrame>& GetFrames(GlyphAtlas::Type type) const;
+  mutable Mutex atlas_mutex_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
-      atlas_map_;
+      atlas_map_ IPLR_GUARDED_BY(atlas_mutex_);
 
   FML_DISALLOW_COPY_AND_ASSIGN(LazyGlyphAtlas);
 };
@@ -5,6 +5,7 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace impeller {
@@ -13,6 +14,11 @@ namespace impeller {
 // Based, in part, on Jukka Jylanki's work at http://clb.demon.fi
 // and ported from Skia's implementation
 // https://github.com/google/skia/blob/b5de4b8ae95c877a9ecfad5eab0765bc22550301/src/gpu/RectanizerSkyline.cpp
+//
+// Space below the skyline that is released by removing rectangles is tracked
+// in a list of free rectangles. New rectangles are placed in the best fitting
+// free rectangle first, splitting the remainder guillotine style, and only
+// then on top of the skyline.
 class SkylineRectanglePacker final : public RectanglePacker {
  public:
   SkylineRectanglePacker(int w, int h) : RectanglePacker(w, h) {
@@ -25,10 +31,13 @@ class SkylineRectanglePacker final : public RectanglePacker {
     area_so_far_ = 0;
     skyline_.clear();
     skyline_.push_back(SkylineSegment{0, 0, this->width()});
+    free_rects_.clear();
   }
 
   bool addRect(int w, int h, IPoint16* loc) final;
 
+  void removeRect(IPoint16 loc, int width, int height) final;
+
   float percentFull() const final {
     return area_so_far_ / ((float)this->width() * this->height());
   }
@@ -40,8 +49,17 @@ class SkylineRectanglePacker final : public RectanglePacker {
     int width_;
   };
 
+  struct FreeRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+  };
+
   std::vector<SkylineSegment> skyline_;
 
+  std::vector<FreeRect> free_rects_;
+
   int32_t area_so_far_;
 
   // Can a width x height rectangle fit in the free space represented by
@@ -52,6 +70,11 @@ class SkylineRectanglePacker final : public RectanglePacker {
   // Update the skyline structure to include a width x height rect located
   // at x,y.
   void addSkylineLevel(int skylineIndex, int x, int y, int width, int height);
+  // Place a width x height rectangle into the best fitting free rectangle.
+  bool addToFreeRect(int width, int height, IPoint16* loc);
+  // Add a free rectangle, merging it with free rectangles that share a full
+  // edge with it.
+  void addFreeRect(FreeRect rect);
 };
 
 bool SkylineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
@@ -60,6 +83,11 @@ bool SkylineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
     return false;
   }
 
+  if (this->addToFreeRect(width, height, loc)) {
+    area_so_far_ += width * height;
+    return true;
+  }
+
   // find position for new rectangle
   int bestWidth = this->width() + 1;
   int bestX = 0;
@@ -166,6 +194,95 @@ void SkylineRectanglePacker::addSkylineLevel(int skylineIndex,
   }
 }
 
+void SkylineRectanglePacker::removeRect(IPoint16 loc, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  area_so_far_ -= width * height;
+  FML_DCHECK(area_so_far_ >= 0);
+  if (area_so_far_ <= 0) {
+    this->reset();
+    return;
+  }
+  this->addFreeRect(FreeRect{loc.x(), loc.y(), width, height});
+}
+
+bool SkylineRectanglePacker::addToFreeRect(int width, int height,
+                                           IPoint16* loc) {
+  // Best short side fit.
+  int bestIndex = -1;
+  int bestShortSide = std::numeric_limits<int>::max();
+  for (int i = 0; i < (int)free_rects_.size(); ++i) {
+    const auto& rect = free_rects_[i];
+    if (width > rect.width_ || height > rect.height_) {
+      continue;
+    }
+    int shortSide = std::min(rect.width_ - width, rect.height_ - height);
+    if (shortSide < bestShortSide) {
+      bestIndex = i;
+      bestShortSide = shortSide;
+    }
+  }
+  if (bestIndex == -1) {
+    return false;
+  }
+
+  FreeRect rect = free_rects_[bestIndex];
+  free_rects_.erase(std::next(free_rects_.begin(), bestIndex));
+  loc->x_ = rect.x_;
+  loc->y_ = rect.y_;
+
+  // Split the remainder along the shorter leftover axis so that the larger
+  // of the two leftover rectangles is as large as possible.
+  int leftoverWidth = rect.width_ - width;
+  int leftoverHeight = rect.height_ - height;
+  FreeRect right;
+  FreeRect bottom;
+  if (leftoverWidth < leftoverHeight) {
+    right = FreeRect{rect.x_ + width, rect.y_, leftoverWidth, height};
+    bottom = FreeRect{rect.x_, rect.y_ + height, rect.width_, leftoverHeight};
+  } else {
+    right = FreeRect{rect.x_ + width, rect.y_, leftoverWidth, rect.height_};
+    bottom = FreeRect{rect.x_, rect.y_ + height, width, leftoverHeight};
+  }
+  if (right.width_ > 0 && right.height_ > 0) {
+    free_rects_.push_back(right);
+  }
+  if (bottom.width_ > 0 && bottom.height_ > 0) {
+    free_rects_.push_back(bottom);
+  }
+  return true;
+}
+
+void SkylineRectanglePacker::addFreeRect(FreeRect rect) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto it = free_rects_.begin(); it != free_rects_.end(); ++it) {
+      const auto& other = *it;
+      bool sameColumn = other.x_ == rect.x_ && other.width_ == rect.width_;
+      bool sameRow = other.y_ == rect.y_ && other.height_ == rect.height_;
+      if (sameColumn && other.y_ + other.height_ == rect.y_) {
+        rect = FreeRect{rect.x_, other.y_, rect.width_,
+                        rect.height_ + other.height_};
+      } else if (sameColumn && rect.y_ + rect.height_ == other.y_) {
+        rect.height_ += other.height_;
+      } else if (sameRow && other.x_ + other.width_ == rect.x_) {
+        rect = FreeRect{other.x_, rect.y_, rect.width_ + other.width_,
+                        rect.height_};
+      } else if (sameRow && rect.x_ + rect.width_ == other.x_) {
+        rect.width_ += other.width_;
+      } else {
+        continue;
+      }
+      free_rects_.erase(it);
+      merged = true;
+      break;
+    }
+  }
+  free_rects_.push_back(rect);
+}
+
 RectanglePacker* RectanglePacker::Factory(int width, int height) {
   return new SkylineRectanglePacker(width, height);
 }
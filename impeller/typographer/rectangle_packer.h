@@ -21,6 +21,9 @@ struct IPoint16 {
 //------------------------------------------------------------------------------
 /// @brief      Packs rectangles into a specified area without rotating them.
 ///
+///             Rectangles may be removed again. The space they occupied is
+///             reused for subsequently added rectangles.
+///
 class RectanglePacker {
  public:
   //----------------------------------------------------------------------------
@@ -42,6 +45,15 @@ class RectanglePacker {
   ///
   virtual bool addRect(int width, int height, IPoint16* loc) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Release the space occupied by a previously added rectangle.
+  ///
+  /// @param[in]   loc     The position returned when the rectangle was added.
+  /// @param[in]   width   The width the rectangle was added with.
+  /// @param[in]   height  The height the rectangle was added with.
+  ///
+  virtual void removeRect(IPoint16 loc, int width, int height) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Returns how much area has been filled with rectangles.
   ///
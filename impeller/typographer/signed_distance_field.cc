@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace impeller {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// The squared distance of pixels that are not yet known to be near the
+// outline. This must be finite so that the parabola intersections of the
+// transform do not produce NaNs.
+constexpr float kFar = 1e20f;
+
+// Scratch space for the one dimensional distance transform.
+struct TransformScratch {
+  std::vector<float> f;
+  std::vector<float> z;
+  std::vector<int> v;
+
+  explicit TransformScratch(size_t length)
+      : f(length), z(length + 1u), v(length) {}
+};
+
+// The squared euclidean distance transform of a single row or column of the
+// grid, as described in "Distance Transforms of Sampled Functions" by
+// Felzenszwalb and Huttenlocher.
+void TransformLine(float* grid,
+                   size_t offset,
+                   size_t stride,
+                   size_t length,
+                   TransformScratch& scratch) {
+  auto& f = scratch.f;
+  auto& z = scratch.z;
+  auto& v = scratch.v;
+  for (size_t q = 0; q < length; q++) {
+    f[q] = grid[offset + q * stride];
+  }
+
+  // Compute the lower envelope of the parabolas rooted at every sample.
+  int k = 0;
+  v[0] = 0;
+  z[0] = -kInfinity;
+  z[1] = kInfinity;
+  for (int q = 1; q < static_cast<int>(length); q++) {
+    float s;
+    do {
+      const int r = v[k];
+      s = (f[q] - f[r] + static_cast<float>(q * q - r * r)) /
+          static_cast<float>(2 * (q - r));
+    } while (s <= z[k] && --k >= 0);
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kInfinity;
+  }
+
+  // Sample the lower envelope.
+  k = 0;
+  for (int q = 0; q < static_cast<int>(length); q++) {
+    while (z[k + 1] < static_cast<float>(q)) {
+      k++;
+    }
+    const int r = v[k];
+    grid[offset + q * stride] = f[r] + static_cast<float>((q - r) * (q - r));
+  }
+}
+
+void Transform2D(std::vector<float>& grid, ISize size) {
+  const size_t width = static_cast<size_t>(size.width);
+  const size_t height = static_cast<size_t>(size.height);
+  TransformScratch scratch(std::max(width, height));
+  for (size_t x = 0; x < width; x++) {
+    TransformLine(grid.data(), x, width, height, scratch);
+  }
+  for (size_t y = 0; y < height; y++) {
+    TransformLine(grid.data(), y * width, 1u, width, scratch);
+  }
+}
+
+}  // namespace
+
+void ComputeSignedDistanceField(const uint8_t* coverage,
+                                size_t coverage_row_bytes,
+                                ISize size,
+                                int spread,
+                                uint8_t* field,
+                                size_t field_row_bytes) {
+  if (size.IsEmpty() || spread <= 0) {
+    return;
+  }
+  const size_t width = static_cast<size_t>(size.width);
+  const size_t height = static_cast<size_t>(size.height);
+
+  // Squared distances to the nearest pixel inside and outside of the shape.
+  // Partially covered pixels are treated as lying at a sub-pixel distance
+  // from the outline in both grids.
+  std::vector<float> outer(width * height);
+  std::vector<float> inner(width * height);
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* row = coverage + y * coverage_row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const size_t index = y * width + x;
+      const float alpha = row[x] / 255.0f;
+      if (alpha >= 1.0f) {
+        outer[index] = 0.0f;
+        inner[index] = kFar;
+      } else if (alpha <= 0.0f) {
+        outer[index] = kFar;
+        inner[index] = 0.0f;
+      } else {
+        const float outside = std::max(0.0f, 0.5f - alpha);
+        const float inside = std::max(0.0f, alpha - 0.5f);
+        outer[index] = outside * outside;
+        inner[index] = inside * inside;
+      }
+    }
+  }
+
+  Transform2D(outer, size);
+  Transform2D(inner, size);
+
+  const float scale = 0.5f / static_cast<float>(spread);
+  for (size_t y = 0; y < height; y++) {
+    uint8_t* row = field + y * field_row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const size_t index = y * width + x;
+      // Positive inside of the shape.
+      const float distance = std::sqrt(inner[index]) - std::sqrt(outer[index]);
+      const float value = std::clamp(0.5f + distance * scale, 0.0f, 1.0f);
+      row[x] = static_cast<uint8_t>(std::round(value * 255.0f));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Convert an 8-bit coverage mask into a signed distance field of
+///             the same size.
+///
+///             Pixels on the outline of the shape are encoded as 128. Values
+///             increase towards the inside of the shape and decrease towards
+///             the outside, reaching 255 and 0 respectively at a distance of
+///             `spread` pixels from the outline. Partial coverage is used to
+///             place the outline with sub-pixel precision.
+///
+/// @param[in]  coverage            The coverage mask.
+/// @param[in]  coverage_row_bytes  The number of bytes per row of the mask.
+/// @param[in]  size                The size of both the mask and the field.
+/// @param[in]  spread              The distance in pixels from the outline
+///                                 that is encoded.
+/// @param[out] field               The signed distance field.
+/// @param[in]  field_row_bytes     The number of bytes per row of the field.
+///
+void ComputeSignedDistanceField(const uint8_t* coverage,
+                                size_t coverage_row_bytes,
+                                ISize size,
+                                int spread,
+                                uint8_t* field,
+                                size_t field_row_bytes);
+
+}  // namespace impeller
@@ -43,8 +43,17 @@ const std::vector<TextRun>& TextFrame::GetRuns() const {
 }
 
 GlyphAtlas::Type TextFrame::GetAtlasType() const {
-  return has_color_ ? GlyphAtlas::Type::kColorBitmap
-                    : GlyphAtlas::Type::kAlphaBitmap;
+  if (has_color_) {
+    return GlyphAtlas::Type::kColorBitmap;
+  }
+  return prefers_signed_distance_field_
+             ? GlyphAtlas::Type::kSignedDistanceField
+             : GlyphAtlas::Type::kAlphaBitmap;
+}
+
+void TextFrame::SetPrefersSignedDistanceField(
+    bool prefers_signed_distance_field) {
+  prefers_signed_distance_field_ = prefers_signed_distance_field;
 }
 
 bool TextFrame::MaybeHasOverlapping() const {
@@ -67,9 +67,21 @@ class TextFrame {
   /// @brief      The type of atlas this run should be emplaced in.
   GlyphAtlas::Type GetAtlasType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Request that the glyphs of this frame are rendered from a
+  ///             signed distance field atlas.
+  ///
+  ///             This is meant for text whose scale changes from frame to
+  ///             frame, such as text in a zoom animation, which would
+  ///             otherwise need new glyphs rasterized for every scale. Frames
+  ///             containing color glyphs always use a color bitmap atlas.
+  ///
+  void SetPrefersSignedDistanceField(bool prefers_signed_distance_field);
+
  private:
   std::vector<TextRun> runs_;
   bool has_color_ = false;
+  bool prefers_signed_distance_field_ = false;
 };
 
 }  // namespace impeller
@@ -8,6 +8,7 @@
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
@@ -162,6 +163,55 @@ TEST_P(TypographerTest, GlyphAtlasIsRecycledIfUnchanged) {
   ASSERT_EQ(atlas_context->GetGlyphAtlas(), atlas);
 }
 
+TEST_P(TypographerTest, SignedDistanceFieldAtlasIsScaleIndependent) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("zoom", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+      TextFrameFromTextBlob(blob, 1.0f));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4llu);
+
+  // Drawing the same text at other scales reuses the same glyphs.
+  for (auto scale : {1.5f, 3.0f, 0.25f}) {
+    auto next_atlas = context->CreateGlyphAtlas(
+        GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+        TextFrameFromTextBlob(blob, scale));
+    ASSERT_EQ(next_atlas, atlas);
+    ASSERT_EQ(next_atlas->GetGlyphCount(), 4llu);
+  }
+}
+
+TEST_P(TypographerTest, SignedDistanceFieldEncodesDistanceToOutline) {
+  constexpr int kSize = 32;
+  constexpr int kSpread = 8;
+  std::vector<uint8_t> coverage(kSize * kSize, 0u);
+  std::vector<uint8_t> field(kSize * kSize, 0u);
+  // A 16x16 square in the center.
+  for (int y = 8; y < 24; y++) {
+    for (int x = 8; x < 24; x++) {
+      coverage[y * kSize + x] = 255u;
+    }
+  }
+  ComputeSignedDistanceField(coverage.data(), kSize, ISize(kSize, kSize),
+                             kSpread, field.data(), kSize);
+
+  // Inside of the outline.
+  EXPECT_GT(field[16 * kSize + 8], 128u);
+  EXPECT_EQ(field[16 * kSize + 16], 255u);
+  // Outside of the outline.
+  EXPECT_LT(field[16 * kSize + 7], 128u);
+  EXPECT_EQ(field[0], 0u);
+  // The field is symmetric around the outline.
+  EXPECT_EQ(field[16 * kSize + 8] - 128, 127 - field[16 * kSize + 7]);
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -209,6 +259,38 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   EXPECT_TRUE(atlas->GetTexture()->GetSize().height > 0);
 }
 
+TEST_P(TypographerTest, GlyphAtlasRasterizesEveryGlyph) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  // Enough glyphs to be split across several rasterization tasks.
+  auto blob = SkTextBlob::MakeFromString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+      sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob, 2));
+  ASSERT_NE(atlas, nullptr);
+  auto bitmap = atlas_context->GetBitmap();
+  ASSERT_NE(bitmap, nullptr);
+
+  atlas->IterateGlyphs([&](const FontGlyphPair& pair, const Rect& rect) {
+    bool has_coverage = false;
+    for (auto y = rect.GetTop(); y < rect.GetBottom() && !has_coverage; y++) {
+      for (auto x = rect.GetLeft(); x < rect.GetRight(); x++) {
+        if (*bitmap->getAddr8(x, y) != 0u) {
+          has_coverage = true;
+          break;
+        }
+      }
+    }
+    EXPECT_TRUE(has_coverage) << "Glyph " << pair.glyph.index;
+    return true;
+  });
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -276,6 +358,47 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasAddsPageInsteadOfRebuildingWhenFull) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky 1", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  auto* first_texture = atlas->GetTexture().get();
+  auto glyph_count = atlas->GetGlyphCount();
+
+  // Glyphs this large don't fit into the free space of the first page.
+  auto large_blob = SkTextBlob::MakeFromString(
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", sk_font);
+  ASSERT_TRUE(large_blob);
+  auto next_atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(large_blob, 24));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_EQ(next_atlas->GetPageCount(), 2u);
+  ASSERT_EQ(atlas_context->GetPageCount(), 2u);
+  ASSERT_EQ(next_atlas->GetTexture(0u).get(), first_texture);
+  ASSERT_NE(next_atlas->GetTexture(1u), nullptr);
+  ASSERT_GT(next_atlas->GetGlyphCount(), glyph_count);
+
+  // Glyphs from the first frame keep their location on the first page.
+  bool found_second_page_glyph = false;
+  next_atlas->IterateGlyphs([&](const FontGlyphPair& pair, const Rect& rect) {
+    auto location = next_atlas->FindFontGlyphLocation(pair);
+    EXPECT_TRUE(location.has_value());
+    EXPECT_EQ(location->bounds, rect);
+    found_second_page_glyph |= location->page == 1u;
+    return true;
+  });
+  ASSERT_TRUE(found_second_page_glyph);
+}
+
 TEST_P(TypographerTest, FontGlyphPairTypeChangesHashAndEquals) {
   Font font = Font(nullptr, {});
   FontGlyphPair pair_1 = {
@@ -355,6 +478,71 @@ TEST_P(TypographerTest, RectanglePackerAddsNonoverlapingRectangles) {
   ASSERT_EQ(packer->percentFull(), 0);
 }
 
+TEST_P(TypographerTest, RectanglePackerReusesRemovedRectangles) {
+  auto packer = RectanglePacker::Factory(100, 100);
+  ASSERT_NE(packer, nullptr);
+
+  IPoint16 first = {-1, -1};
+  IPoint16 second = {-1, -1};
+  ASSERT_TRUE(packer->addRect(100, 50, &first));
+  ASSERT_TRUE(packer->addRect(100, 50, &second));
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(10, 10, &output));
+
+  packer->removeRect(first, 100, 50);
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.5));
+
+  // Smaller rectangles are packed into the space that was released.
+  IPoint16 third = {-1, -1};
+  IPoint16 fourth = {-1, -1};
+  ASSERT_TRUE(packer->addRect(60, 50, &third));
+  ASSERT_TRUE(packer->addRect(40, 50, &fourth));
+  const SkIRect second_rect =
+      SkIRect::MakeXYWH(second.x(), second.y(), 100, 50);
+  const SkIRect third_rect = SkIRect::MakeXYWH(third.x(), third.y(), 60, 50);
+  const SkIRect fourth_rect =
+      SkIRect::MakeXYWH(fourth.x(), fourth.y(), 40, 50);
+  ASSERT_FALSE(SkIRect::Intersects(second_rect, third_rect));
+  ASSERT_FALSE(SkIRect::Intersects(second_rect, fourth_rect));
+  ASSERT_FALSE(SkIRect::Intersects(third_rect, fourth_rect));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 1.0));
+
+  // Removing everything leaves the packer empty.
+  packer->removeRect(second, 100, 50);
+  packer->removeRect(third, 60, 50);
+  packer->removeRect(fourth, 40, 50);
+  ASSERT_EQ(packer->percentFull(), 0);
+  ASSERT_TRUE(packer->addRect(100, 100, &output));
+}
+
+TEST_P(TypographerTest, GlyphAtlasEvictsGlyphsUnusedSinceFrame) {
+  Font font = Font(nullptr, {});
+  FontGlyphPair stale_pair = {
+      .font = font,
+      .glyph = Glyph(1, Glyph::Type::kPath, Rect::MakeXYWH(0, 0, 1, 1))};
+  FontGlyphPair fresh_pair = {
+      .font = font,
+      .glyph = Glyph(2, Glyph::Type::kPath, Rect::MakeXYWH(0, 0, 1, 1))};
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  atlas.AddTypefaceGlyphPosition(stale_pair, Rect::MakeXYWH(0, 0, 10, 10), 0u,
+                                 1u);
+  atlas.AddTypefaceGlyphPosition(fresh_pair, Rect::MakeXYWH(12, 0, 10, 10), 0u,
+                                 1u);
+  ASSERT_TRUE(atlas.MarkFontGlyphUsed(fresh_pair, 4u));
+
+  std::vector<GlyphAtlas::Location> evicted;
+  ASSERT_EQ(atlas.EvictGlyphsUnusedSince(
+                3u, [&](const auto& location) { evicted.push_back(location); }),
+            1u);
+  ASSERT_EQ(evicted.size(), 1u);
+  ASSERT_EQ(evicted[0].bounds, Rect::MakeXYWH(0, 0, 10, 10));
+  ASSERT_FALSE(atlas.FindFontGlyphBounds(stale_pair).has_value());
+  ASSERT_FALSE(atlas.MarkFontGlyphUsed(stale_pair, 4u));
+  ASSERT_TRUE(atlas.FindFontGlyphBounds(fresh_pair).has_value());
+  ASSERT_EQ(atlas.GetGlyphCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -40,6 +40,10 @@ const std::string_view
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
+const std::string_view ServiceProtocol::kGetFrameCountersExtensionName =
+    "_flutter.getFrameCounters";
+const std::string_view ServiceProtocol::kGetTraceRingBufferExtensionName =
+    "_flutter.getTraceRingBuffer";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
 
@@ -62,6 +66,8 @@ ServiceProtocol::ServiceProtocol()
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
+          kGetFrameCountersExtensionName,
+          kGetTraceRingBufferExtensionName,
           kReloadAssetFonts,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
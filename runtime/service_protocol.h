@@ -30,6 +30,8 @@ class ServiceProtocol {
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
+  static const std::string_view kGetFrameCountersExtensionName;
+  static const std::string_view kGetTraceRingBufferExtensionName;
   static const std::string_view kReloadAssetFonts;
 
   class Handler {
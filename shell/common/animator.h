@@ -46,9 +46,13 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  /// Creates an animator whose layer tree pipeline holds at most
+  /// |pipeline_depth| frames that have been built but not yet rasterized.
+  /// A depth of 0 selects the default depth for the platform.
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t pipeline_depth = 0);
 
   ~Animator();
 
@@ -77,6 +77,13 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->SetPrefersSignedDistanceFieldText(
+        delegate_.GetSettings().impeller_enable_sdf_text);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -208,6 +215,12 @@ RasterStatus Rasterizer::Draw(
         if (discard_callback(*layer_tree.get())) {
           raster_status = RasterStatus::kDiscarded;
         } else {
+          // Latch the pointer position as late as possible, so that frames
+          // that waited in the pipeline can account for the input that
+          // arrived in the meantime.
+          if (auto pointer_input = delegate_.GetLatestPointerInput()) {
+            frame_timings_recorder->RecordLatchedPointerInput(*pointer_input);
+          }
           raster_status = DoDraw(std::move(frame_timings_recorder),
                                  std::move(layer_tree), device_pixel_ratio);
         }
@@ -425,6 +438,22 @@ RasterStatus Rasterizer::DoDraw(
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
 
+  int64_t latched_input_age_micros = 0;
+  if (auto pointer_input = frame_timings_recorder->GetLatchedPointerInput()) {
+    latched_input_age_micros = (frame_timings_recorder->GetRasterStartTime() -
+                                pointer_input->dispatch_time)
+                                   .ToMicroseconds();
+  }
+  FML_TRACE_COUNTER(
+      "flutter",                                                           //
+      "FrameQueueing", reinterpret_cast<int64_t>(this),                    //
+      "BuildQueueMicros",                                                  //
+      frame_timings_recorder->GetBuildQueueDuration().ToMicroseconds(),    //
+      "RasterQueueMicros",                                                 //
+      frame_timings_recorder->GetRasterQueueDuration().ToMicroseconds(),   //
+      "LatchedInputAgeMicros", latched_input_age_micros                    //
+  );
+
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
 #if !defined(OS_FUCHSIA)
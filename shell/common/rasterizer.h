@@ -102,6 +102,11 @@ class Rasterizer final : public SnapshotDelegate,
     /// for when this time gets updated.
     virtual fml::TimePoint GetLatestFrameTargetTime() const = 0;
 
+    /// The most recent pointer input dispatched to the engine, if any. It is
+    /// latched into a frame right before the frame is rasterized.
+    virtual std::optional<LatchedPointerInput> GetLatestPointerInput()
+        const = 0;
+
     /// Task runners used by the shell.
     virtual const TaskRunners& GetTaskRunners() const = 0;
 
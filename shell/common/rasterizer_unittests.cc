@@ -36,6 +36,8 @@ class MockDelegate : public Rasterizer::Delegate {
   MOCK_METHOD1(OnFrameRasterized, void(const FrameTiming& frame_timing));
   MOCK_METHOD0(GetFrameBudget, fml::Milliseconds());
   MOCK_CONST_METHOD0(GetLatestFrameTargetTime, fml::TimePoint());
+  MOCK_CONST_METHOD0(GetLatestPointerInput,
+                     std::optional<LatchedPointerInput>());
   MOCK_CONST_METHOD0(GetTaskRunners, const TaskRunners&());
   MOCK_CONST_METHOD0(GetParentRasterThreadMerger,
                      const fml::RefPtr<fml::RasterThreadMerger>());
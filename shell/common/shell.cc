@@ -18,9 +18,11 @@
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
@@ -48,8 +50,42 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+// The number of frames whose timings are kept for the frame counters service
+// protocol extension, two seconds worth of frames at 60Hz.
+constexpr size_t kMaxRecentFrameTimings = 120;
+
+// The minimum time between two captures of the trace ring buffer after janky
+// frames, so that a series of janky frames is not made worse by serializing
+// the trace after each of them.
+constexpr fml::TimeDelta kMinJankTraceCaptureInterval =
+    fml::TimeDelta::FromSeconds(1);
+
+// The name of the file the jank trace is written to, see
+// |Settings::trace_ring_buffer_jank_dir|.
+constexpr char kJankTraceFileName[] = "flutter_jank_trace.json";
+
 namespace {
 
+// Captures the trace ring buffer after a janky frame and, if |directory| is
+// not empty, replaces the jank trace file in it.
+void CaptureJankTrace(const std::string& directory) {
+  fml::tracing::TraceRingBuffer::CaptureJankTrace();
+  if (directory.empty()) {
+    return;
+  }
+  auto jank_trace_dir = fml::OpenDirectory(directory.c_str(), true,
+                                           fml::FilePermission::kReadWrite);
+  if (!jank_trace_dir.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the jank trace directory " << directory;
+    return;
+  }
+  fml::DataMapping jank_trace(
+      fml::tracing::TraceRingBuffer::GetLastJankTrace());
+  if (!fml::WriteAtomically(jank_trace_dir, kJankTraceFileName, jank_trace)) {
+    FML_LOG(ERROR) << "Could not write the jank trace to " << directory;
+  }
+}
+
 std::unique_ptr<Engine> CreateEngine(
     Engine::Delegate& delegate,
     const PointerDataDispatcherMaker& dispatcher_maker,
@@ -120,6 +156,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_ring_buffer) {
+      fml::tracing::TraceRingBuffer::SetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -311,8 +351,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pipeline_depth);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -479,6 +520,15 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolRenderFrameWithRasterStats, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetFrameCountersExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetFrameCounters, this,
+                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kReloadAssetFonts] = {
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
@@ -723,6 +773,45 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                                       });
   }
 
+  if (settings_.enable_tiled_raster_cache) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(), [rasterizer = weak_rasterizer_] {
+          if (rasterizer) {
+            rasterizer->compositor_context()
+                ->raster_cache()
+                .SetTiledDisplayListCaching(true);
+          }
+        });
+  }
+
+  if (settings_.enable_deferred_raster_cache_preparation) {
+    // Cache images are uploaded to the resource context, which is shared with
+    // the onscreen context, unless the GPU is currently unavailable.
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         io_task_runner = task_runners_.GetIOTaskRunner(),
+         io_manager = io_manager_->GetWeakPtr()] {
+          if (!rasterizer) {
+            return;
+          }
+          rasterizer->compositor_context()
+              ->raster_cache()
+              .SetDeferredPreparation(
+                  io_task_runner, [io_manager]() -> GrDirectContext* {
+                    GrDirectContext* resource_context = nullptr;
+                    if (io_manager) {
+                      io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+                          fml::SyncSwitch::Handlers().SetIfFalse([&] {
+                            resource_context =
+                                io_manager->GetResourceContext().get();
+                          }));
+                    }
+                    return resource_context;
+                  });
+        });
+  }
+
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
@@ -1015,6 +1104,15 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (size_t length = packet->GetLength(); length > 0) {
+    PointerData pointer_data = packet->GetPointerData(length - 1);
+    std::scoped_lock pointer_input_lock(pointer_input_mutex_);
+    latest_pointer_input_ = {
+        .dispatch_time = fml::TimePoint::Now(),
+        .physical_x = pointer_data.physical_x,
+        .physical_y = pointer_data.physical_y,
+    };
+  }
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -1482,6 +1580,28 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  recent_frame_timings_.push_back(timing);
+  if (recent_frame_timings_.size() > kMaxRecentFrameTimings) {
+    recent_frame_timings_.pop_front();
+  }
+
+  if (fml::tracing::TraceRingBuffer::IsEnabled()) {
+    // Keep the trace leading up to frames that took more than twice the frame
+    // budget from vsync to the end of rasterization. The trace is serialized
+    // on the IO thread to stay off the critical path.
+    fml::TimeDelta frame_duration = timing.Get(FrameTiming::kRasterFinish) -
+                                    timing.Get(FrameTiming::kVsyncStart);
+    fml::TimePoint now = fml::TimePoint::Now();
+    if (frame_duration.ToMillisecondsF() > 2 * GetFrameBudget().count() &&
+        now - last_jank_trace_capture_ >= kMinJankTraceCaptureInterval) {
+      last_jank_trace_capture_ = now;
+      task_runners_.GetIOTaskRunner()->PostTask(
+          [directory = settings_.trace_ring_buffer_jank_dir]() {
+            CaptureJankTrace(directory);
+          });
+    }
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1558,6 +1678,11 @@ fml::TimePoint Shell::GetLatestFrameTargetTime() const {
   return latest_frame_target_time_.value();
 }
 
+std::optional<LatchedPointerInput> Shell::GetLatestPointerInput() const {
+  std::scoped_lock pointer_input_lock(pointer_input_mutex_);
+  return latest_pointer_input_;
+}
+
 // |ServiceProtocol::Handler|
 fml::RefPtr<fml::TaskRunner> Shell::GetServiceProtocolHandlerTaskRunner(
     std::string_view method) const {
@@ -1827,6 +1952,63 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameCounters(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameCounters", allocator);
+  // The counters are not tracked per engine, see |fml::FrameCounters|.
+  response->AddMember("scope", "process", allocator);
+  rapidjson::Value frames(rapidjson::kArrayType);
+  for (const FrameTiming& timing : recent_frame_timings_) {
+    rapidjson::Value frame(rapidjson::kObjectType);
+    frame.AddMember<uint64_t>("frameNumber", timing.GetFrameNumber(),
+                              allocator);
+    frame.AddMember<int64_t>(
+        "buildMicros",
+        (timing.Get(FrameTiming::kBuildFinish) -
+         timing.Get(FrameTiming::kBuildStart))
+            .ToMicroseconds(),
+        allocator);
+    frame.AddMember<int64_t>(
+        "rasterMicros",
+        (timing.Get(FrameTiming::kRasterFinish) -
+         timing.Get(FrameTiming::kRasterStart))
+            .ToMicroseconds(),
+        allocator);
+    const auto& counters = timing.GetFrameCounters();
+    for (size_t i = 0; i < fml::FrameCounters::kCount; i++) {
+      auto counter = static_cast<fml::FrameCounters::Counter>(i);
+      frame.AddMember<uint64_t>(
+          rapidjson::StringRef(fml::FrameCounters::GetName(counter)),
+          counters[i], allocator);
+    }
+    frames.PushBack(frame, allocator);
+  }
+  response->AddMember("frames", frames, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRingBuffer::IsEnabled(),
+                      allocator);
+  // Both traces are strings in the Chrome JSON trace event format.
+  auto trace = fml::tracing::TraceRingBuffer::GetChromeTraceJSON();
+  response->AddMember("trace", rapidjson::Value(trace, allocator), allocator);
+  auto jank_trace = fml::tracing::TraceRingBuffer::GetLastJankTrace();
+  response->AddMember("jankTrace", rapidjson::Value(jank_trace, allocator),
+                      allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
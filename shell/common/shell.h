@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_SHELL_H_
 #define SHELL_COMMON_SHELL_H_
 
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <string_view>
@@ -421,6 +422,8 @@ class Shell final : public PlatformView::Delegate,
   DartVMRef vm_;
   mutable std::mutex time_recorder_mutex_;
   std::optional<fml::TimePoint> latest_frame_target_time_;
+  mutable std::mutex pointer_input_mutex_;
+  std::optional<LatchedPointerInput> latest_pointer_input_;
   std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on raster task runner
@@ -464,6 +467,15 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The timings of the most recently rasterized frames, oldest first, for the
+  // frame counters service protocol extension. Only accessed on the raster
+  // thread.
+  std::deque<FrameTiming> recent_frame_timings_;
+
+  // The time the trace ring buffer was last captured after a janky frame. Only
+  // accessed on the raster thread.
+  fml::TimePoint last_jank_trace_capture_;
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -651,6 +663,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   fml::TimePoint GetLatestFrameTargetTime() const override;
 
+  // |Rasterizer::Delegate|
+  std::optional<LatchedPointerInput> GetLatestPointerInput() const override;
+
   // |ServiceProtocol::Handler|
   fml::RefPtr<fml::TaskRunner> GetServiceProtocolHandlerTaskRunner(
       std::string_view method) const override;
@@ -716,6 +731,27 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the frame counters of the most recently rasterized frames,
+  // such as the number of layers prerolled or pipelines compiled, to attribute
+  // slow frames to the work that was done while rasterizing them. The counters
+  // are process-wide deltas, as reported by the "scope" member, and include
+  // work done concurrently by other threads and engines.
+  bool OnServiceProtocolGetFrameCounters(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the events currently held by the trace ring buffer, and the
+  // events it held after the most recent janky frame, if any. In release mode,
+  // where the service protocol is unavailable, the jank trace can be written
+  // to a file instead, see |Settings::trace_ring_buffer_jank_dir|.
+  bool OnServiceProtocolGetTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Forces the FontCollection to reload the font manifest. Used to support hot
@@ -276,6 +276,12 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetFrameCounters:
+        shell->OnServiceProtocolGetFrameCounters(params, response);
+        break;
+      case ServiceProtocolEnum::kGetTraceRingBuffer:
+        shell->OnServiceProtocolGetTraceRingBuffer(params, response);
+        break;
     }
     finished.set_value(true);
   });
@@ -110,6 +110,8 @@ class ShellTest : public FixtureTest {
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
+    kGetFrameCounters,
+    kGetTraceRingBuffer,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
@@ -28,10 +28,12 @@
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/dart/dart_converter.h"
+#include "flutter/fml/frame_counters.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -2546,6 +2548,129 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetFrameCountersWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    root->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10), MakeSizedDisplayList(80, 80), false, false));
+  };
+  PumpOneFrame(shell.get(), 100, 100, builder);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameCounters,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string(document["type"].GetString()), "FrameCounters");
+  ASSERT_EQ(std::string(document["scope"].GetString()), "process");
+  const auto& frames = document["frames"];
+  ASSERT_TRUE(frames.IsArray());
+  ASSERT_GE(frames.Size(), 1u);
+  const auto& frame = frames[frames.Size() - 1];
+  ASSERT_TRUE(frame.HasMember("frameNumber"));
+  ASSERT_TRUE(frame.HasMember("buildMicros"));
+  ASSERT_TRUE(frame.HasMember("rasterMicros"));
+  for (size_t i = 0; i < fml::FrameCounters::kCount; i++) {
+    ASSERT_TRUE(frame.HasMember(fml::FrameCounters::GetName(
+        static_cast<fml::FrameCounters::Counter>(i))));
+  }
+  // The root transform layer and the display list layer.
+  ASSERT_GE(frame["layersPrerolled"].GetUint64(), 2u);
+  ASSERT_GT(frame["displayListOpsDispatched"].GetUint64(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetTraceRingBufferWorks) {
+  fml::tracing::TraceRingBuffer::Clear();
+  fml::tracing::TraceRingBuffer::SetEnabled(true);
+
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    root->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10), MakeSizedDisplayList(80, 80), false, false));
+  };
+  PumpOneFrame(shell.get(), 100, 100, builder);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTraceRingBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  fml::tracing::TraceRingBuffer::SetEnabled(false);
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string(document["type"].GetString()), "TraceRingBuffer");
+  ASSERT_TRUE(document["enabled"].GetBool());
+  ASSERT_TRUE(document["jankTrace"].IsString());
+  std::string trace = document["trace"].GetString();
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  ASSERT_NE(trace.find("\"GPURasterizer::Draw\""), std::string::npos);
+  // The shell threads are named.
+  ASSERT_NE(trace.find("{\"name\":\"thread_name\",\"ph\":\"M\""),
+            std::string::npos);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, JankTraceIsWrittenToTheJankDirectory) {
+  fml::ScopedTemporaryDirectory jank_dir;
+  fml::tracing::TraceRingBuffer::Clear();
+  fml::tracing::TraceRingBuffer::SetEnabled(true);
+
+  Settings settings = CreateSettingsForFixture();
+  settings.trace_ring_buffer_jank_dir = jank_dir.path();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // A frame that took a second from vsync to the end of rasterization.
+  FrameTiming timing;
+  fml::TimePoint vsync_start = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kRasterFinish,
+             vsync_start + fml::TimeDelta::FromSeconds(1));
+  fml::AutoResetWaitableEvent latch;
+  shell->GetTaskRunners().GetRasterTaskRunner()->PostTask([&]() {
+    static_cast<Rasterizer::Delegate*>(shell.get())->OnFrameRasterized(timing);
+    latch.Signal();
+  });
+  latch.Wait();
+  // The trace is written on the IO thread.
+  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [&latch]() { latch.Signal(); });
+  latch.Wait();
+  fml::tracing::TraceRingBuffer::SetEnabled(false);
+
+  auto jank_trace = fml::FileMapping::CreateReadOnly(
+      jank_dir.fd(), "flutter_jank_trace.json");
+  ASSERT_TRUE(jank_trace);
+  std::string trace(reinterpret_cast<const char*>(jank_trace->GetMapping()),
+                    jank_trace->GetSize());
+  ASSERT_EQ(trace, fml::tracing::TraceRingBuffer::GetLastJankTrace());
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
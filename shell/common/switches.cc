@@ -354,9 +354,20 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.trace_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceRingBuffer));
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceRingBufferJankDir),
+                              &settings.trace_ring_buffer_jank_dir);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
+  settings.enable_deferred_raster_cache_preparation = command_line.HasOption(
+      FlagForSwitch(Switch::EnableDeferredRasterCachePreparation));
+
+  settings.enable_tiled_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTiledRasterCache));
+
   settings.verbose_logging =
       command_line.HasOption(FlagForSwitch(Switch::VerboseLogging));
 
@@ -462,6 +473,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
     }
   }
 
+  settings.impeller_enable_sdf_text =
+      command_line.HasOption(FlagForSwitch(Switch::ImpellerEnableSDFText));
+
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
 
@@ -514,6 +528,14 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    settings.frame_pipeline_depth =
+        std::max(std::stoi(frame_pipeline_depth), 0);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
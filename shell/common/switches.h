@@ -141,6 +141,15 @@ DEF_SWITCH(SkiaDeterministicRendering,
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
            "some Skia function pointers based on available CPU features. This "
            "is used to obtain 100% deterministic behavior in Skia rendering.")
+DEF_SWITCH(EnableDeferredRasterCachePreparation,
+           "enable-deferred-raster-cache-preparation",
+           "Prepare the images of raster cache entries on the IO thread "
+           "instead of during the frame. Content is drawn uncached until its "
+           "image is ready.")
+DEF_SWITCH(EnableTiledRasterCache,
+           "enable-tiled-raster-cache",
+           "Cache large display lists as a grid of tiles, so that scrolling "
+           "them only rasterizes the tiles that become visible.")
 DEF_SWITCH(FlutterAssetsDir,
            "flutter-assets-dir",
            "Path to the Flutter assets directory.")
@@ -197,6 +206,17 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(TraceRingBuffer,
+           "trace-ring-buffer",
+           "Record the most recent trace events of every thread into "
+           "in-process ring buffers. Unlike the timeline, this is available in "
+           "release mode and is cheap enough to leave enabled. The trace "
+           "leading up to the most recent janky frame is kept.")
+DEF_SWITCH(TraceRingBufferJankDir,
+           "trace-ring-buffer-jank-dir",
+           "The directory to write the trace leading up to the most recent "
+           "janky frame to, as flutter_jank_trace.json in the Chrome JSON "
+           "trace event format. Only used together with --trace-ring-buffer.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -257,6 +277,10 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The maximum number of frames that may be built ahead of the "
+           "rasterizer, or 0 for the platform default.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -265,6 +289,11 @@ DEF_SWITCH(ImpellerBackend,
            "impeller-backend",
            "Requests a particular Impeller backend on platforms that support "
            "multiple backends. (ex `opengles` or `vulkan`)")
+DEF_SWITCH(ImpellerEnableSDFText,
+           "impeller-enable-sdf-text",
+           "Render text from a signed distance field glyph atlas in Impeller, "
+           "so that glyphs are not rasterized again whenever the scale of the "
+           "text changes. Text with color glyphs is not affected.")
 DEF_SWITCH(EnableVulkanValidation,
            "enable-vulkan-validation",
            "Enable loading Vulkan validation layers. The layers must be "
@@ -79,6 +79,47 @@ TEST(SwitchesTest, MsaaSamples) {
   EXPECT_EQ(settings.msaa_samples, 0);
 }
 
+TEST(SwitchesTest, FramePipelineDepth) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_pipeline_depth, 0u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-pipeline-depth=3"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_pipeline_depth, 3u);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-pipeline-depth=-1"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_pipeline_depth, 0u);
+}
+
+TEST(SwitchesTest, EnableTiledRasterCache) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_tiled_raster_cache);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-tiled-raster-cache"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_tiled_raster_cache);
+}
+
+TEST(SwitchesTest, ImpellerEnableSDFText) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.impeller_enable_sdf_text);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-enable-sdf-text"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.impeller_enable_sdf_text);
+}
+
 TEST(SwitchesTest, EnableEmbedderAPI) {
   {
     // enable
@@ -115,6 +156,15 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, TraceRingBufferJankDir) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--trace-ring-buffer",
+       "--trace-ring-buffer-jank-dir=/tmp/jank"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.trace_ring_buffer);
+  EXPECT_EQ(settings.trace_ring_buffer_jank_dir, "/tmp/jank");
+}
+
 }  // namespace testing
 }  // namespace flutter
 
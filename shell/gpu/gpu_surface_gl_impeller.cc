@@ -5,6 +5,7 @@
 #include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/paths.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/renderer/backend/gles/surface_gles.h"
 #include "flutter/impeller/renderer/renderer.h"
@@ -28,7 +29,8 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(context);
+  auto aiks_context = std::make_shared<impeller::AiksContext>(
+      context, fml::paths::GetCachesDirectory());
 
   if (!aiks_context->IsValid()) {
     return;
@@ -57,22 +59,6 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
-  auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
-    if (weak) {
-      GLPresentInfo present_info = {
-          .fbo_id = 0,
-          .frame_damage = std::nullopt,
-          // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
-          // presentation time to impeller backend.
-          .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
-      };
-      delegate->GLContextPresent(present_info);
-    }
-    return true;
-  };
-
   auto context_switch = delegate_->GLContextMakeCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR)
@@ -80,18 +66,18 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
-  auto surface = impeller::SurfaceGLES::WrapFBO(
-      impeller_context_,                            // context
-      swap_callback,                                // swap_callback
-      0u,                                           // fbo
-      impeller::PixelFormat::kR8G8B8A8UNormInt,     // color_format
-      impeller::ISize{size.width(), size.height()}  // fbo_size
-  );
+  if (size != fbo_size_) {
+    UpdateFBO(size);
+  }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([weak = weak_factory_.GetWeakPtr(),  //
+                         delegate = delegate_,                //
+                         context = impeller_context_,         //
+                         renderer = impeller_renderer_,       //
+                         aiks_context = aiks_context_,        //
+                         fbo_id = fbo_id_,                    //
+                         size                                 //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -103,8 +89,65 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
           return false;
         }
 
-        impeller::DlDispatcher impeller_dispatcher;
-        display_list->Dispatch(impeller_dispatcher);
+        const auto& submit_info = surface_frame.submit_info();
+        delegate->GLContextSetDamageRegion(submit_info.buffer_damage);
+
+        auto swap_callback = [weak, delegate, fbo_id, size,
+                              frame_damage = submit_info.frame_damage,
+                              buffer_damage =
+                                  submit_info.buffer_damage]() -> bool {
+          if (weak) {
+            GLPresentInfo present_info = {
+                .fbo_id = fbo_id,
+                .frame_damage = frame_damage,
+                // TODO (https://github.com/flutter/flutter/issues/105597):
+                // wire-up presentation time to impeller backend.
+                .presentation_time = std::nullopt,
+                .buffer_damage = buffer_damage,
+            };
+            if (!delegate->GLContextPresent(present_info)) {
+              return false;
+            }
+            if (delegate->GLContextFBOResetAfterPresent()) {
+              weak->UpdateFBO(size);
+            }
+          }
+          return true;
+        };
+
+        std::optional<impeller::IRect> clip_rect;
+        if (submit_info.buffer_damage.has_value()) {
+          const auto& buffer_damage = submit_info.buffer_damage.value();
+          clip_rect = impeller::IRect::MakeXYWH(
+              buffer_damage.x(), buffer_damage.y(), buffer_damage.width(),
+              buffer_damage.height());
+        }
+
+        auto surface = impeller::SurfaceGLES::WrapFBO(
+            context,                                       // context
+            swap_callback,                                 // swap_callback
+            fbo_id,                                        // fbo
+            impeller::PixelFormat::kR8G8B8A8UNormInt,      // color_format
+            impeller::ISize{size.width(), size.height()},  // fbo_size
+            clip_rect                                      // clip_rect
+        );
+        if (!surface) {
+          return false;
+        }
+
+        // Nothing changed. The contents of the framebuffer are already up to
+        // date.
+        if (clip_rect && clip_rect->size.IsEmpty()) {
+          return surface->Present();
+        }
+
+        auto cull_rect = impeller::IRect::MakeSize(surface->GetSize());
+        impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetPrefersSignedDistanceFieldText(
+            aiks_context->GetPrefersSignedDistanceFieldText());
+        display_list->Dispatch(
+            impeller_dispatcher,
+            SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
         return renderer->Render(
@@ -116,16 +159,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
                 }));
       });
 
+  auto framebuffer_info = delegate_->GLContextFramebufferInfo();
+  if (!framebuffer_info.existing_damage.has_value()) {
+    framebuffer_info.existing_damage = existing_damage_;
+  }
+  // Partial repaints are blitted into the framebuffer.
+  if (!impeller_context_->GetCapabilities()->SupportsTextureToTextureBlits()) {
+    framebuffer_info.supports_partial_repaint = false;
+  }
+
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      std::move(context_switch),        // context result
-      true                              // display list fallback
+      nullptr,                    // surface
+      framebuffer_info,           // framebuffer info
+      submit_callback,            // submit callback
+      size,                       // frame size
+      std::move(context_switch),  // context result
+      true                        // display list fallback
   );
 }
 
+void GPUSurfaceGLImpeller::UpdateFBO(const SkISize& size) {
+  GLFrameInfo frame_info = {static_cast<uint32_t>(size.width()),
+                            static_cast<uint32_t>(size.height())};
+  const GLFBOInfo fbo_info = delegate_->GLContextFBO(frame_info);
+  fbo_id_ = fbo_info.fbo_id;
+  fbo_size_ = size;
+  existing_damage_ = fbo_info.existing_damage;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceGLImpeller::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
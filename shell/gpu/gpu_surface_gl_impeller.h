@@ -5,6 +5,8 @@
 #ifndef SHELL_GPU_GPU_SURFACE_GL_IMPELLER_H_
 #define SHELL_GPU_GPU_SURFACE_GL_IMPELLER_H_
 
+#include <optional>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
@@ -32,8 +34,16 @@ class GPUSurfaceGLImpeller final : public Surface {
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
   bool is_valid_ = false;
+  // The framebuffer of the delegate and the damage it is known to lag behind
+  // the front buffer by. The framebuffer is queried again when the frame size
+  // changes or the delegate resets it after presentation.
+  uint32_t fbo_id_ = 0u;
+  SkISize fbo_size_ = SkISize::MakeEmpty();
+  std::optional<SkIRect> existing_damage_;
   fml::WeakPtrFactory<GPUSurfaceGLImpeller> weak_factory_;
 
+  void UpdateFBO(const SkISize& size);
+
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
 
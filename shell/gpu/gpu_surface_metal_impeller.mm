@@ -10,6 +10,7 @@
 #include "flutter/common/settings.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/renderer/backend/metal/surface_mtl.h"
@@ -28,14 +29,21 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
+static std::shared_ptr<impeller::AiksContext> CreateAiksContext(
+    const std::shared_ptr<impeller::Context>& context) {
+  // Persist the pipeline variants used by the application, see
+  // |impeller::AiksContext|.
+  auto caches = fml::paths::GetCachesDirectory();
+  return std::make_shared<impeller::AiksContext>(context, std::move(caches));
+}
+
 GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
                                                  const std::shared_ptr<impeller::Context>& context,
                                                  bool render_to_surface)
     : delegate_(delegate),
       render_target_type_(delegate->GetRenderTargetType()),
       impeller_renderer_(CreateImpellerRenderer(context)),
-      aiks_context_(
-          std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr)),
+      aiks_context_(CreateAiksContext(impeller_renderer_ ? context : nullptr)),
       render_to_surface_(render_to_surface) {
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
@@ -151,6 +159,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetPrefersSignedDistanceFieldText(
+            aiks_context->GetPrefersSignedDistanceFieldText());
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
@@ -249,6 +259,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetPrefersSignedDistanceFieldText(
+            aiks_context->GetPrefersSignedDistanceFieldText());
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
@@ -4,15 +4,20 @@
 
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
+#include <algorithm>
+
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/paths.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/renderer/renderer.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/surface_vk.h"
 
 namespace flutter {
 
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
-    std::shared_ptr<impeller::Context> context) {
+    std::shared_ptr<impeller::Context> context)
+    : weak_factory_(this) {
   if (!context || !context->IsValid()) {
     return;
   }
@@ -22,7 +27,8 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(context);
+  auto aiks_context = std::make_shared<impeller::AiksContext>(
+      context, fml::paths::GetCachesDirectory());
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -57,10 +63,17 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
   auto& context_vk = impeller::ContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
 
+  // All surfaces acquired from the swapchain wrap one of its images.
+  std::shared_ptr<impeller::SwapchainImageVK> swapchain_image =
+      surface ? static_cast<impeller::SurfaceVK&>(*surface).GetSwapchainImage()
+              : nullptr;
+
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([weak = weak_factory_.GetWeakPtr(),  //
+                         renderer = impeller_renderer_,       //
+                         aiks_context = aiks_context_,        //
+                         surface = std::move(surface),        //
+                         swapchain_image                      //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -72,8 +85,41 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
-        impeller::DlDispatcher impeller_dispatcher;
-        display_list->Dispatch(impeller_dispatcher);
+        if (!surface) {
+          return false;
+        }
+
+        const auto& submit_info = surface_frame.submit_info();
+        if (weak) {
+          weak->AccumulateDamage(swapchain_image, submit_info.frame_damage);
+        }
+
+        if (submit_info.buffer_damage.has_value()) {
+          const auto& buffer_damage = submit_info.buffer_damage.value();
+          // Nothing changed. The contents of the swapchain image are already
+          // up to date.
+          if (buffer_damage.isEmpty()) {
+            return surface->Present();
+          }
+          auto clipped_surface =
+              static_cast<impeller::SurfaceVK&>(*surface)
+                  .CreateSurfaceForClipRect(impeller::IRect::MakeXYWH(
+                      buffer_damage.x(), buffer_damage.y(),
+                      buffer_damage.width(), buffer_damage.height()));
+          if (!clipped_surface) {
+            FML_LOG(ERROR) << "Could not create surface for partial repaint.";
+            return false;
+          }
+          surface = std::move(clipped_surface);
+        }
+
+        auto cull_rect = impeller::IRect::MakeSize(surface->GetSize());
+        impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetPrefersSignedDistanceFieldText(
+            aiks_context->GetPrefersSignedDistanceFieldText());
+        display_list->Dispatch(
+            impeller_dispatcher,
+            SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
         return renderer->Render(
@@ -85,16 +131,66 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
                 }));
       });
 
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  if (swapchain_image && swapchain_image->IsCopyDestination()) {
+    // Provide the accumulated damage of the swapchain image to the rasterizer.
+    framebuffer_info.existing_damage = GetExistingDamage(swapchain_image);
+    framebuffer_info.supports_partial_repaint = true;
+  }
+
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      nullptr,                          // context result
-      true                              // display list fallback
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      submit_callback,   // submit callback
+      size,              // frame size
+      nullptr,           // context result
+      true               // display list fallback
   );
 }
 
+std::optional<SkIRect> GPUSurfaceVulkanImpeller::GetExistingDamage(
+    const std::shared_ptr<impeller::SwapchainImageVK>& image) const {
+  for (const auto& entry : damage_) {
+    if (entry.image.lock() == image) {
+      return entry.damage;
+    }
+  }
+  // The contents of images that were never presented are undefined.
+  return std::nullopt;
+}
+
+void GPUSurfaceVulkanImpeller::AccumulateDamage(
+    const std::shared_ptr<impeller::SwapchainImageVK>& image,
+    const std::optional<SkIRect>& frame_damage) {
+  if (!image) {
+    return;
+  }
+  // Forget the images of swapchains that were recreated. If the damage of this
+  // frame is unknown, the other images must be repainted entirely.
+  damage_.erase(std::remove_if(damage_.begin(), damage_.end(),
+                               [&](const SwapchainImageDamage& entry) {
+                                 auto entry_image = entry.image.lock();
+                                 return !entry_image ||
+                                        (entry_image != image &&
+                                         !frame_damage.has_value());
+                               }),
+                damage_.end());
+
+  bool found = false;
+  for (auto& entry : damage_) {
+    if (entry.image.lock() == image) {
+      // The image will be up to date once this frame is presented.
+      entry.damage = SkIRect::MakeEmpty();
+      found = true;
+    } else {
+      entry.damage.join(frame_damage.value());
+    }
+  }
+  if (!found) {
+    damage_.push_back({.image = image, .damage = SkIRect::MakeEmpty()});
+  }
+}
+
 // |Surface|
 SkMatrix GPUSurfaceVulkanImpeller::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
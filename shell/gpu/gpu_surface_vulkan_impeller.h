@@ -4,11 +4,16 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/backend/vulkan/swapchain_image_vk.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 
@@ -30,6 +35,21 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   std::shared_ptr<impeller::AiksContext> aiks_context_;
   bool is_valid_ = false;
 
+  // The area of a swapchain image that lags behind the most recently presented
+  // image.
+  struct SwapchainImageDamage {
+    std::weak_ptr<impeller::SwapchainImageVK> image;
+    SkIRect damage;
+  };
+  std::vector<SwapchainImageDamage> damage_;
+
+  std::optional<SkIRect> GetExistingDamage(
+      const std::shared_ptr<impeller::SwapchainImageVK>& image) const;
+
+  void AccumulateDamage(
+      const std::shared_ptr<impeller::SwapchainImageVK>& image,
+      const std::optional<SkIRect>& frame_damage);
+
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
 
@@ -48,6 +68,8 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   // |Surface|
   std::shared_ptr<impeller::AiksContext> GetAiksContext() const override;
 
+  fml::WeakPtrFactory<GPUSurfaceVulkanImpeller> weak_factory_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceVulkanImpeller);
 };
 
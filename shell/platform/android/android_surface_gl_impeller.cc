@@ -10,6 +10,10 @@
 
 namespace flutter {
 
+// The number of presented frames whose damage is kept. Back buffers older than
+// this are repainted entirely.
+static constexpr size_t kMaxDamageHistorySize = 4u;
+
 AndroidSurfaceGLImpeller::AndroidSurfaceGLImpeller(
     const std::shared_ptr<AndroidContextGLImpeller>& android_context)
     : android_context_(android_context) {
@@ -49,6 +53,7 @@ std::unique_ptr<Surface> AndroidSurfaceGLImpeller::CreateGPUSurface(
 void AndroidSurfaceGLImpeller::TeardownOnScreenContext() {
   GLContextClearCurrent();
   onscreen_surface_.reset();
+  damage_history_.clear();
 }
 
 // |AndroidSurface|
@@ -117,14 +122,47 @@ SurfaceFrame::FramebufferInfo
 AndroidSurfaceGLImpeller::GLContextFramebufferInfo() const {
   auto info = SurfaceFrame::FramebufferInfo{};
   info.supports_readback = true;
-  info.supports_partial_repaint = false;
+  // Impeller only renders the damaged area of the back buffer and preserves the
+  // rest of it. This relies on knowing the age of the back buffer.
+  info.supports_partial_repaint =
+      onscreen_surface_ && onscreen_surface_->SupportsBufferAge();
+  info.existing_damage = GetExistingDamage();
   return info;
 }
 
 // |GPUSurfaceGLDelegate|
 void AndroidSurfaceGLImpeller::GLContextSetDamageRegion(
     const std::optional<SkIRect>& region) {
-  // Not supported.
+  // Not supported. The region is only a hint. The entire back buffer stays
+  // valid.
+}
+
+std::optional<SkIRect> AndroidSurfaceGLImpeller::GetExistingDamage() const {
+  if (!onscreen_surface_) {
+    return std::nullopt;
+  }
+  return GetExistingDamage(onscreen_surface_->GetBufferAge(), damage_history_);
+}
+
+std::optional<SkIRect> AndroidSurfaceGLImpeller::GetExistingDamage(
+    EGLint buffer_age,
+    const std::list<std::optional<SkIRect>>& damage_history) {
+  // An age of zero means the contents of the back buffer are undefined.
+  if (buffer_age <= 0 ||
+      static_cast<size_t>(buffer_age - 1) > damage_history.size()) {
+    return std::nullopt;
+  }
+  // The back buffer lags behind by the damage of the frames presented since
+  // it was last presented.
+  auto existing_damage = SkIRect::MakeEmpty();
+  auto damage = damage_history.begin();
+  for (EGLint i = 1; i < buffer_age; i++, damage++) {
+    if (!damage->has_value()) {
+      return std::nullopt;
+    }
+    existing_damage.join(damage->value());
+  }
+  return existing_damage;
 }
 
 // |GPUSurfaceGLDelegate|
@@ -135,6 +173,10 @@ bool AndroidSurfaceGLImpeller::GLContextPresent(
   if (!onscreen_surface_) {
     return false;
   }
+  damage_history_.push_front(present_info.frame_damage);
+  if (damage_history_.size() > kMaxDamageHistorySize) {
+    damage_history_.pop_back();
+  }
   return onscreen_surface_->Present();
 }
 
@@ -158,6 +200,7 @@ bool AndroidSurfaceGLImpeller::
     return false;
   }
   onscreen_surface_.reset();
+  damage_history_.clear();
   auto onscreen_surface =
       android_context_->CreateOnscreenSurface(native_window_->handle());
   if (!onscreen_surface) {
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_GL_IMPELLER_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_GL_IMPELLER_H_
 
+#include <list>
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
@@ -72,16 +75,38 @@ class AndroidSurfaceGLImpeller final : public GPUSurfaceGLDelegate,
   // |GPUSurfaceGLDelegate|
   sk_sp<const GrGLInterface> GetGLInterface() const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the area of a back buffer that lags behind the front
+  ///             buffer.
+  ///
+  /// @param[in]  buffer_age      The age of the back buffer as reported by
+  ///                             EGL_EXT_buffer_age.
+  /// @param[in]  damage_history  The damage of the most recently presented
+  ///                             frames, most recent first. An unset entry
+  ///                             means the damage of that frame is unknown.
+  ///
+  /// @return     The existing damage, or std::nullopt if it is unknown.
+  ///
+  static std::optional<SkIRect> GetExistingDamage(
+      EGLint buffer_age,
+      const std::list<std::optional<SkIRect>>& damage_history);
+
  private:
   std::shared_ptr<AndroidContextGLImpeller> android_context_;
   std::unique_ptr<impeller::egl::Surface> onscreen_surface_;
   std::unique_ptr<impeller::egl::Surface> offscreen_surface_;
   fml::RefPtr<AndroidNativeWindow> native_window_;
+  // The damage of the most recently presented frames, most recent first. An
+  // unset entry means the damage of that frame is unknown.
+  std::list<std::optional<SkIRect>> damage_history_;
 
   bool is_valid_ = false;
 
   bool OnGLContextMakeCurrent();
 
+  // The area of the back buffer that lags behind the front buffer, if known.
+  std::optional<SkIRect> GetExistingDamage() const;
+
   bool RecreateOnscreenSurfaceAndMakeOnscreenContextCurrent();
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceGLImpeller);
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_gl_impeller.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(AndroidSurfaceGLImpeller, ExistingDamageOfUndefinedBufferIsUnknown) {
+  std::list<std::optional<SkIRect>> history = {SkIRect::MakeWH(10, 10)};
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(0, history),
+            std::nullopt);
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(-1, history),
+            std::nullopt);
+}
+
+TEST(AndroidSurfaceGLImpeller, ExistingDamageOfFrontBufferIsEmpty) {
+  std::list<std::optional<SkIRect>> history = {SkIRect::MakeWH(10, 10)};
+  auto damage = AndroidSurfaceGLImpeller::GetExistingDamage(1, history);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_TRUE(damage->isEmpty());
+}
+
+TEST(AndroidSurfaceGLImpeller, ExistingDamageJoinsFramesSincePresented) {
+  std::list<std::optional<SkIRect>> history = {
+      SkIRect::MakeXYWH(0, 0, 10, 10),    // Most recent frame.
+      SkIRect::MakeXYWH(20, 20, 10, 10),  //
+      SkIRect::MakeXYWH(50, 50, 10, 10),  // Not presented since.
+  };
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(2, history),
+            SkIRect::MakeXYWH(0, 0, 10, 10));
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(3, history),
+            SkIRect::MakeXYWH(0, 0, 30, 30));
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(4, history),
+            SkIRect::MakeXYWH(0, 0, 60, 60));
+}
+
+TEST(AndroidSurfaceGLImpeller, ExistingDamageOlderThanHistoryIsUnknown) {
+  std::list<std::optional<SkIRect>> history = {
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      SkIRect::MakeXYWH(20, 20, 10, 10),
+  };
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(4, history),
+            std::nullopt);
+}
+
+TEST(AndroidSurfaceGLImpeller, ExistingDamageWithUnknownFrameIsUnknown) {
+  std::list<std::optional<SkIRect>> history = {
+      SkIRect::MakeXYWH(0, 0, 10, 10),
+      std::nullopt,
+      SkIRect::MakeXYWH(20, 20, 10, 10),
+  };
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(2, history),
+            SkIRect::MakeXYWH(0, 0, 10, 10));
+  EXPECT_EQ(AndroidSurfaceGLImpeller::GetExistingDamage(3, history),
+            std::nullopt);
+}
+
+}  // namespace testing
+}  // namespace flutter
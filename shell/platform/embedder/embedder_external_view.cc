@@ -99,6 +99,8 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
     slice_->render_into(&dl_builder);
 
     auto dispatcher = impeller::DlDispatcher();
+    dispatcher.SetPrefersSignedDistanceFieldText(
+        aiks_context->GetPrefersSignedDistanceFieldText());
     dispatcher.drawDisplayList(dl_builder.Build(), 1);
     return aiks_context->Render(dispatcher.EndRecordingAsPicture(),
                                 *impeller_target);
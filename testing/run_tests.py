@@ -524,6 +524,10 @@ def run_engine_benchmarks(build_dir, executable_filter):
       build_dir, 'fml_benchmarks', executable_filter, icu_flags
   )
 
+  run_engine_executable(
+      build_dir, 'flow_benchmarks', executable_filter, icu_flags
+  )
+
   run_engine_executable(
       build_dir, 'ui_benchmarks', executable_filter, icu_flags
   )